@@ -7,6 +7,7 @@
 C_SRCS += \
 ../Library/microtbx-modbus/tbxmb_client.c \
 ../Library/microtbx-modbus/tbxmb_event.c \
+../Library/microtbx-modbus/tbxmb_gateway.c \
 ../Library/microtbx-modbus/tbxmb_port.c \
 ../Library/microtbx-modbus/tbxmb_rtu.c \
 ../Library/microtbx-modbus/tbxmb_server.c \
@@ -16,6 +17,7 @@ C_SRCS += \
 OBJS += \
 ./Library/microtbx-modbus/tbxmb_client.o \
 ./Library/microtbx-modbus/tbxmb_event.o \
+./Library/microtbx-modbus/tbxmb_gateway.o \
 ./Library/microtbx-modbus/tbxmb_port.o \
 ./Library/microtbx-modbus/tbxmb_rtu.o \
 ./Library/microtbx-modbus/tbxmb_server.o \
@@ -25,6 +27,7 @@ OBJS += \
 C_DEPS += \
 ./Library/microtbx-modbus/tbxmb_client.d \
 ./Library/microtbx-modbus/tbxmb_event.d \
+./Library/microtbx-modbus/tbxmb_gateway.d \
 ./Library/microtbx-modbus/tbxmb_port.d \
 ./Library/microtbx-modbus/tbxmb_rtu.d \
 ./Library/microtbx-modbus/tbxmb_server.d \
@@ -39,7 +42,7 @@ Library/microtbx-modbus/%.o Library/microtbx-modbus/%.su Library/microtbx-modbus
 clean: clean-Library-2f-microtbx-2d-modbus
 
 clean-Library-2f-microtbx-2d-modbus:
-	-$(RM) ./Library/microtbx-modbus/tbxmb_client.cyclo ./Library/microtbx-modbus/tbxmb_client.d ./Library/microtbx-modbus/tbxmb_client.o ./Library/microtbx-modbus/tbxmb_client.su ./Library/microtbx-modbus/tbxmb_event.cyclo ./Library/microtbx-modbus/tbxmb_event.d ./Library/microtbx-modbus/tbxmb_event.o ./Library/microtbx-modbus/tbxmb_event.su ./Library/microtbx-modbus/tbxmb_port.cyclo ./Library/microtbx-modbus/tbxmb_port.d ./Library/microtbx-modbus/tbxmb_port.o ./Library/microtbx-modbus/tbxmb_port.su ./Library/microtbx-modbus/tbxmb_rtu.cyclo ./Library/microtbx-modbus/tbxmb_rtu.d ./Library/microtbx-modbus/tbxmb_rtu.o ./Library/microtbx-modbus/tbxmb_rtu.su ./Library/microtbx-modbus/tbxmb_server.cyclo ./Library/microtbx-modbus/tbxmb_server.d ./Library/microtbx-modbus/tbxmb_server.o ./Library/microtbx-modbus/tbxmb_server.su ./Library/microtbx-modbus/tbxmb_superloop.cyclo ./Library/microtbx-modbus/tbxmb_superloop.d ./Library/microtbx-modbus/tbxmb_superloop.o ./Library/microtbx-modbus/tbxmb_superloop.su ./Library/microtbx-modbus/tbxmb_uart.cyclo ./Library/microtbx-modbus/tbxmb_uart.d ./Library/microtbx-modbus/tbxmb_uart.o ./Library/microtbx-modbus/tbxmb_uart.su
+	-$(RM) ./Library/microtbx-modbus/tbxmb_client.cyclo ./Library/microtbx-modbus/tbxmb_client.d ./Library/microtbx-modbus/tbxmb_client.o ./Library/microtbx-modbus/tbxmb_client.su ./Library/microtbx-modbus/tbxmb_event.cyclo ./Library/microtbx-modbus/tbxmb_event.d ./Library/microtbx-modbus/tbxmb_event.o ./Library/microtbx-modbus/tbxmb_event.su ./Library/microtbx-modbus/tbxmb_gateway.cyclo ./Library/microtbx-modbus/tbxmb_gateway.d ./Library/microtbx-modbus/tbxmb_gateway.o ./Library/microtbx-modbus/tbxmb_gateway.su ./Library/microtbx-modbus/tbxmb_port.cyclo ./Library/microtbx-modbus/tbxmb_port.d ./Library/microtbx-modbus/tbxmb_port.o ./Library/microtbx-modbus/tbxmb_port.su ./Library/microtbx-modbus/tbxmb_rtu.cyclo ./Library/microtbx-modbus/tbxmb_rtu.d ./Library/microtbx-modbus/tbxmb_rtu.o ./Library/microtbx-modbus/tbxmb_rtu.su ./Library/microtbx-modbus/tbxmb_server.cyclo ./Library/microtbx-modbus/tbxmb_server.d ./Library/microtbx-modbus/tbxmb_server.o ./Library/microtbx-modbus/tbxmb_server.su ./Library/microtbx-modbus/tbxmb_superloop.cyclo ./Library/microtbx-modbus/tbxmb_superloop.d ./Library/microtbx-modbus/tbxmb_superloop.o ./Library/microtbx-modbus/tbxmb_superloop.su ./Library/microtbx-modbus/tbxmb_uart.cyclo ./Library/microtbx-modbus/tbxmb_uart.d ./Library/microtbx-modbus/tbxmb_uart.o ./Library/microtbx-modbus/tbxmb_uart.su
 
 .PHONY: clean-Library-2f-microtbx-2d-modbus
 
@@ -42,6 +42,7 @@
 #include "tbxmb_event.h"                         /* MicroTBX-Modbus event handling     */
 #include "tbxmb_server.h"                        /* MicroTBX-Modbus server             */
 #include "tbxmb_client.h"                        /* MicroTBX-Modbus client             */
+#include "tbxmb_gateway.h"                       /* MicroTBX-Modbus gateway            */
 #include "tbxmb_port.h"                          /* MicroTBX-Modbus hardware port      */
 
 
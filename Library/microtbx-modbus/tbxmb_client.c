@@ -45,11 +45,181 @@
 /** \brief Unique context type to identify a context as being a client channel. */
 #define TBX_MB_CLIENT_CONTEXT_TYPE     (23U)
 
+/** \brief Unique context type to identify a context as being a poll group. */
+#define TBX_MB_CLIENT_GROUP_CONTEXT_TYPE (41U)
+
+/** \brief Maximum number of file record sub-requests that fit in a single PDU. */
+#define TBX_MB_CLIENT_FILE_SUBREQS_MAX (TBX_MB_FILE_BYTE_COUNT_MAX / \
+                                        TBX_MB_FILE_SUBREQ_HDR_LEN)
+
+/** \brief Waiting for the transport layer to accept the asynchronous request. */
+#define TBX_MB_CLIENT_REQ_STATE_START    (1U)
+
+/** \brief Waiting for the transmission of the asynchronous request to complete. */
+#define TBX_MB_CLIENT_REQ_STATE_TRANSMIT (2U)
+
+/** \brief Waiting for the response or for the turnaround delay to pass. */
+#define TBX_MB_CLIENT_REQ_STATE_RECEIVE  (3U)
+
+/** \brief Poll group waits for its next release. */
+#define TBX_MB_CLIENT_GROUP_STATE_IDLE     (0U)
+
+/** \brief Poll group was released and waits to be dispatched. */
+#define TBX_MB_CLIENT_GROUP_STATE_RELEASED (1U)
+
+/** \brief Poll group's read request is in progress. */
+#define TBX_MB_CLIENT_GROUP_STATE_BUSY     (2U)
+
+/** \brief Maximum number of times that the response timeout of a node doubles, after
+ *         consecutive response timeouts.
+ */
+#define TBX_MB_CLIENT_RTT_BACKOFF_MAX      (6U)
+
+/** \brief Maximum round trip time (ms) that a single measurement contributes. It keeps
+ *         the scaled smoothed round trip time within 16 bits.
+ */
+#define TBX_MB_CLIENT_RTT_SAMPLE_MAX       (8000U)
+
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-static void TbxMbClientProcessEvent(tTbxMbEvent * event);
+static void    TbxMbClientPoll            (tTbxMbClient                   channel);
+
+static void    TbxMbClientProcessEvent    (tTbxMbEvent                  * event);
+
+static tTbxMbClientReq * TbxMbClientReqCreate(uint8_t                      node,
+                                              uint8_t                      code,
+                                              tTbxMbClientDone             doneFcn,
+                                              void                       * context);
+
+static void    TbxMbClientReqSubmit       (tTbxMbClientCtx              * clientCtx,
+                                           tTbxMbClientReq              * req);
+
+static void    TbxMbClientReqComplete     (tTbxMbClientCtx              * clientCtx,
+                                           tTbxMbClientReq              * req,
+                                           uint8_t                        result);
+
+static void    TbxMbClientReqUnlink       (tTbxMbClientCtx              * clientCtx,
+                                           tTbxMbClientReq              * req);
+
+static uint32_t TbxMbClientTimeMs         (tTbxMbClientCtx              * clientCtx);
+
+static void    TbxMbClientStartPolling    (tTbxMbClientCtx              * clientCtx);
+
+static void    TbxMbClientReqCancel       (tTbxMbClientCtx              * clientCtx,
+                                           void                   const * context);
+
+static void    TbxMbClientGroupsPoll      (tTbxMbClientCtx              * clientCtx,
+                                           uint32_t                       nowMs);
+
+static void    TbxMbClientGroupDone       (tTbxMbClient                   channel,
+                                           uint8_t                        result,
+                                           void                         * context);
+
+static uint8_t TbxMbClientReqResponse     (tTbxMbClientReq        const * req,
+                                           tTbxMbTpPacket         const * rxPacket);
+
+static void    TbxMbClientReqStore        (tTbxMbClientReq        const * req,
+                                           tTbxMbTpPacket         const * rxPacket,
+                                           uint16_t                       offset);
+
+static void    TbxMbClientReqRelease      (tTbxMbClientReq              * req);
+
+static tTbxMbClientReq * TbxMbClientReqCoalesce(tTbxMbClientCtx            * clientCtx,
+                                                tTbxMbClientReq            * req);
+
+static uint8_t TbxMbClientReadAsync       (tTbxMbClient                   channel,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint16_t                       num,
+                                           void                         * values,
+                                           tTbxMbClientDone               doneFcn,
+                                           void                         * context);
+
+static uint8_t TbxMbClientFileRecordsCheck(tTbxMbClientFileRecord const * records,
+                                           uint8_t                        num);
+
+static uint16_t TbxMbClientRangeChunkMax  (uint8_t                        code);
+
+static uint8_t TbxMbClientRange           (tTbxMbClient                   channel,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint32_t                       num,
+                                           void                         * values,
+                                           void                   const * writeValues,
+                                           uint32_t                     * numDone);
+
+static uint8_t TbxMbClientRangeAsync      (tTbxMbClient                   channel,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint32_t                       num,
+                                           void                         * values,
+                                           void                   const * writeValues,
+                                           tTbxMbClientRangeDone          doneFcn,
+                                           void                         * context);
+
+static void    TbxMbClientRangeChunkDone  (tTbxMbClient                   channel,
+                                           uint8_t                        result,
+                                           void                         * context);
+
+static void    TbxMbClientRangeComplete   (tTbxMbClient                   channel,
+                                           tTbxMbClientRangeCtx         * rangeCtx);
+
+static uint16_t TbxMbClientRangeCancel    (tTbxMbClientCtx              * clientCtx,
+                                           tTbxMbClientRangeCtx   const * rangeCtx);
+
+static uint16_t TbxMbClientRttTimeout     (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node);
+
+static void    TbxMbClientRttUpdate       (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint32_t                       rttMs);
+
+static void    TbxMbClientRttBackoff      (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node);
+
+static uint8_t TbxMbClientHealthAllow     (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint32_t                       nowMs);
+
+static void    TbxMbClientHealthUpdate    (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint8_t                        responded,
+                                           uint32_t                       nowMs);
+
+static void    TbxMbClientHealthRelease   (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node);
+
+static uint8_t TbxMbClientCacheRead       (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint16_t                       num,
+                                           void                         * values,
+                                           uint8_t                      * rawLen,
+                                           uint32_t                       nowMs);
+
+static void    TbxMbClientCacheFill       (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint16_t                       num,
+                                           tTbxMbTpPacket         const * rxPacket,
+                                           uint16_t                       cacheGen,
+                                           uint32_t                       startMs);
+
+static void    TbxMbClientCacheInvalidate (tTbxMbClientCtx              * clientCtx,
+                                           uint8_t                        node,
+                                           uint8_t                        code,
+                                           uint16_t                       addr,
+                                           uint16_t                       num);
+
+static uint8_t TbxMbClientCacheExpire     (tTbxMbClientCtx              * clientCtx,
+                                           uint32_t                       nowMs);
 
 
 /************************************************************************************//**
@@ -105,11 +275,42 @@ tTbxMbClient TbxMbClientCreate(tTbxMbTp transport,
       /* Initialize the channel context. Start by crosslinking the transport layer. */
       newClientCtx->type = TBX_MB_CLIENT_CONTEXT_TYPE;
       newClientCtx->instancePtr = NULL;
-      newClientCtx->pollFcn = NULL;
+      newClientCtx->pollFcn = TbxMbClientPoll;
       newClientCtx->processFcn = TbxMbClientProcessEvent;
       newClientCtx->responseTimeout = responseTimeout;
       newClientCtx->turnaroundDelay = turnaroundDelay;
       newClientCtx->transceiveSem = TbxMbOsalSemCreate();
+      newClientCtx->syncActive = TBX_FALSE;
+      newClientCtx->syncWaiting = 0U;
+      newClientCtx->reqHead = NULL;
+      newClientCtx->reqTail = NULL;
+      newClientCtx->reqTransmit = NULL;
+      newClientCtx->reqSent = NULL;
+      newClientCtx->reqSentNum = 0U;
+      newClientCtx->reqWindow = 1U;
+      newClientCtx->reqTransId = 0U;
+      newClientCtx->reqPolling = TBX_FALSE;
+      newClientCtx->tickTime = TbxMbPortTimerCount();
+      newClientCtx->timeMs = 0U;
+      newClientCtx->groupList = NULL;
+      newClientCtx->nodeRtt = NULL;
+      newClientCtx->adaptive = TBX_FALSE;
+      newClientCtx->timeoutMin = responseTimeout;
+      newClientCtx->timeoutMax = responseTimeout;
+      newClientCtx->nodeHealth = NULL;
+      newClientCtx->nodesDown = 0U;
+      newClientCtx->health = TBX_FALSE;
+      newClientCtx->failMax = 1U;
+      newClientCtx->probeMin = 0U;
+      newClientCtx->probeMax = 0U;
+      newClientCtx->stateChangeFcn = NULL;
+      newClientCtx->coalesce = TBX_FALSE;
+      newClientCtx->coalesceGap = 0U;
+      newClientCtx->cacheList = NULL;
+      newClientCtx->cacheGen = 0U;
+      newClientCtx->cacheStats.hits = 0U;
+      newClientCtx->cacheStats.misses = 0U;
+      newClientCtx->cacheStats.savedMs = 0U;
       newClientCtx->tpCtx = tpCtx;
       newClientCtx->tpCtx->channelCtx = newClientCtx;
       newClientCtx->tpCtx->isClient = TBX_TRUE;
@@ -140,6 +341,54 @@ void TbxMbClientFree(tTbxMbClient channel)
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Instruct the event task to stop calling our polling function, in case
+     * asynchronous requests are still in progress.
+     */
+    if (clientCtx->reqPolling == TBX_TRUE)
+    {
+      tTbxMbEvent newEvent;
+      newEvent.context = clientCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+    /* Drop the asynchronous requests that did not yet complete. Note that their
+     * completion callbacks are not called.
+     */
+    TbxMbClientReqRelease(clientCtx->reqTransmit);
+    clientCtx->reqTransmit = NULL;
+    TbxMbClientReqRelease(clientCtx->reqSent);
+    clientCtx->reqSent = NULL;
+    clientCtx->reqSentNum = 0U;
+    TbxMbClientReqRelease(clientCtx->reqHead);
+    clientCtx->reqHead = NULL;
+    clientCtx->reqTail = NULL;
+    /* Release the poll groups. */
+    while (clientCtx->groupList != NULL)
+    {
+      tTbxMbClientGroupCtx * nextGroup = clientCtx->groupList->next;
+      clientCtx->groupList->type = 0U;
+      TbxMemPoolRelease(clientCtx->groupList->values);
+      TbxMemPoolRelease(clientCtx->groupList);
+      clientCtx->groupList = nextGroup;
+    }
+    /* Release the cache entries. */
+    while (clientCtx->cacheList != NULL)
+    {
+      tTbxMbClientCacheEntry * nextEntry = clientCtx->cacheList->next;
+      TbxMemPoolRelease(clientCtx->cacheList->data);
+      TbxMemPoolRelease(clientCtx->cacheList);
+      clientCtx->cacheList = nextEntry;
+    }
+    /* Release the round trip time statistics of the nodes, if allocated. */
+    if (clientCtx->nodeRtt != NULL)
+    {
+      TbxMemPoolRelease(clientCtx->nodeRtt);
+    }
+    /* Release the health of the nodes, if allocated. */
+    if (clientCtx->nodeHealth != NULL)
+    {
+      TbxMemPoolRelease(clientCtx->nodeHealth);
+    }
     /* Release the semaphore used for syncing to PDU transmit and reception events. */
     TbxMbOsalSemFree(clientCtx->transceiveSem);
     /* Remove crosslink between the channel and the transport layer. */
@@ -159,1359 +408,6758 @@ void TbxMbClientFree(tTbxMbClient channel)
 
 
 /************************************************************************************//**
-** \brief     Event processing function that is automatically called when an event for
-**            this client channel object was received in TbxMbEventTask().
-** \param     event Pointer to the event to process. Note that the event->context points
-**            to the handle of the Modbus client channel object.
+** \brief     Configures the maximum number of asynchronous requests that can await a
+**            response at the same time. Multiple outstanding requests are matched to
+**            their responses by transaction identifier. This raises the throughput
+**            towards servers with a long round trip time. The window is limited to what
+**            the transport layer supports. This is just one request on a serial line
+**            (RTU).
+** \param     channel Handle to the Modbus client channel object.
+** \param     window Maximum number of requests awaiting a response (1..255). The
+**            default is 1.
 **
 ****************************************************************************************/
-static void TbxMbClientProcessEvent(tTbxMbEvent * event)
+void TbxMbClientSetWindow(tTbxMbClient channel,
+                          uint8_t      window)
 {
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((channel != NULL) && (window >= 1U));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((channel != NULL) && (window >= 1U))
   {
-    /* Sanity check the context. */
-    TBX_ASSERT(event->context != NULL);
-    /* Convert the event context  to the client channel context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)event->context;
-    /* Make sure the context is valid. */
-    TBX_ASSERT(clientCtx != NULL);
-    /* Only continue with a valid context. */
-    if (clientCtx != NULL)
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Limit the window to what the transport layer supports. */
+    if (window > clientCtx->tpCtx->outstandingMax)
     {
-      /* Sanity check on the context type. */
-      TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-      /* Filter on the event identifier. */
-      switch (event->id)
-      {
-        case TBX_MB_EVENT_ID_PDU_RECEIVED:
-        {
-          /* Give the PDU received semaphore to synchronize whatever task is waiting
-           * for this event.
-           */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
-        }
-        break;
-
-        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
-        {
-          /* Give the PDU transmitted semaphore to synchronize whatever task is waiting
-           * for this event.
-           */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
-        }
-        break;
-
-        default:
-        {
-          /* An unsupported event was dispatched to us. Should not happen. */
-          TBX_ASSERT(TBX_FALSE);
-        }
-        break;
-      }
+      window = clientCtx->tpCtx->outstandingMax;
     }
+    /* Store the window. */
+    clientCtx->reqWindow = window;
   }
-} /*** end of TbxMbClientProcessEvent ***/
+} /*** end of TbxMbClientSetWindow ***/
 
 
 /************************************************************************************//**
-** \brief     Helper function to both transmit a request packet and receive the reponse
-**            packet, if applicable (unicast).
-** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
-** \param     isBroadcast TBX_TRUE for sending a broadcast request, TBX_FALSE for
-**            unicast.
-** \return    TBX_OK if the request packet could be transmitted and (a) a response for
-**            the unicast request was received or (b) the turnaround timeout passed after
-**            sending the broadcast request. TBX_ERROR otherwise.
+** \brief     Configures the automatic coalescing of queued read requests. When enabled,
+**            the client merges queued asynchronous read requests for the same node and
+**            function code into a single read request that covers all of them, within
+**            the 125 register and 2000 bit limits of a PDU. Once the response is
+**            received, the client splits the values back to the individual requests and
+**            calls their completion callbacks. This lowers the number of transactions
+**            on the bus. Note that blocking requests are not coalesced and that reads
+**            are never merged across a write to the same node.
+** \param     channel Handle to the Modbus client channel object.
+** \param     enable TBX_TRUE to enable coalescing, TBX_FALSE to disable it. It is
+**            disabled by default.
+** \param     gapMax Maximum number of unrequested elements between merged read requests.
+**            Keep in mind that the coalesced read request also reads these elements, so
+**            the server must allow reading them.
 **
 ****************************************************************************************/
-static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
-                                     uint8_t           isBroadcast)
+void TbxMbClientSetCoalescing(tTbxMbClient channel,
+                              uint8_t      enable,
+                              uint16_t     gapMax)
 {
-  uint8_t  result      = TBX_ERROR;
-  uint16_t waitTimeout = clientCtx->responseTimeout;
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
 
-  /* Update the wait time in case it is a broadcast request. */
-  if (isBroadcast == TBX_TRUE)
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
   {
-    waitTimeout = clientCtx->turnaroundDelay;
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Store the configuration. Update it in a critical section, because the client
+     * accesses it upon dispatching a queued request.
+     */
+    TbxCriticalSectionEnter();
+    clientCtx->coalesce = (enable == TBX_FALSE) ? TBX_FALSE : TBX_TRUE;
+    clientCtx->coalesceGap = gapMax;
+    TbxCriticalSectionExit();
   }
+} /*** end of TbxMbClientSetCoalescing ***/
 
-  /* Request the transport layer to transmit the request packet and update the
-   * result accordingly.
-   */
-  result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
-  /* Only continue if the request was successfully submitted for transmission. */
-  if (result == TBX_OK)
+
+/************************************************************************************//**
+** \brief     Configures adaptive response timeouts. When enabled, the client measures
+**            the round trip time of each node and derives a response timeout per node
+**            from it, within the specified bounds. This way a missing node with a short
+**            round trip time costs just a few milliseconds, instead of the worst-case
+**            response timeout of the slowest node. As long as the round trip time of a
+**            node was not yet measured, its response timeout is the upper bound.
+** \param     channel Handle to the Modbus client channel object.
+** \param     enable TBX_TRUE to enable adaptive response timeouts, TBX_FALSE to disable
+**            them. When disabled, all nodes use the response timeout configured with
+**            TbxMbClientCreate(). They are disabled by default.
+** \param     timeoutMin Lower bound of the response timeout of a node in milliseconds.
+** \param     timeoutMax Upper bound of the response timeout of a node in milliseconds.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientSetAdaptiveTimeout(tTbxMbClient channel,
+                                      uint8_t      enable,
+                                      uint16_t     timeoutMin,
+                                      uint16_t     timeoutMax)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (timeoutMin >= 1U) && (timeoutMin <= timeoutMax));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (timeoutMin >= 1U) && (timeoutMin <= timeoutMax))
   {
-    /* Wait for the request packet transmit completion. The packet response reception
-     * timeout can be re-used for this because a packet transmission won't take longer
-     * than a packet reception, since it uses the same communication interface.
-     */
-    if (TbxMbOsalSemTake(clientCtx->transceiveSem, clientCtx->responseTimeout)
-        == TBX_FALSE)
-    {
-      /* For some reason the packet transmission did not complete within the expected
-       * time.
-       * Flag the error.
-       */
-      result = TBX_ERROR;
-    }
-    /* Only continue if the request successfully completed transmission. */
-    if (result == TBX_OK)
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Allocate the round trip time statistics of the nodes, if not yet done. */
+    if ((enable != TBX_FALSE) && (clientCtx->nodeRtt == NULL))
     {
-      /* Wait for the reception of the response from the server, with a timeout. */
-      if (TbxMbOsalSemTake(clientCtx->transceiveSem, waitTimeout) == TBX_FALSE)
+      size_t                tableSize = sizeof(tTbxMbClientNodeRtt) *
+                                        (TBX_MB_TP_NODE_ADDR_MAX + 1U);
+      tTbxMbClientNodeRtt * nodeRtt = TbxMemPoolAllocate(tableSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (nodeRtt == NULL)
       {
-        /* Semaphore timeout occured. Either because no response was received, which
-         * is an error. Or because the turnaround time after the broadcast request
-         * passed, which is okay.
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
          */
-        if (isBroadcast == TBX_FALSE)
+        (void)TbxMemPoolCreate(1U, tableSize);
+        nodeRtt = TbxMemPoolAllocate(tableSize);
+      }
+      /* Initialize the statistics, if the memory allocation succeeded. */
+      if (nodeRtt != NULL)
+      {
+        for (uint16_t node = 0U; node <= TBX_MB_TP_NODE_ADDR_MAX; node++)
         {
-          /* Flag the error. */
-          result = TBX_ERROR;
+          nodeRtt[node].srtt = 0U;
+          nodeRtt[node].rttVar = 0U;
+          nodeRtt[node].valid = TBX_FALSE;
+          nodeRtt[node].backoff = 0U;
         }
+        clientCtx->nodeRtt = nodeRtt;
       }
     }
+    /* Store the configuration, unless the statistics are needed but not available.
+     * Update it in a critical section, because the event task accesses it too.
+     */
+    if ((enable == TBX_FALSE) || (clientCtx->nodeRtt != NULL))
+    {
+      TbxCriticalSectionEnter();
+      clientCtx->adaptive = (enable == TBX_FALSE) ? TBX_FALSE : TBX_TRUE;
+      clientCtx->timeoutMin = timeoutMin;
+      clientCtx->timeoutMax = timeoutMax;
+      TbxCriticalSectionExit();
+      /* Update the result. */
+      result = TBX_OK;
+    }
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientTransceive ***/
+} /*** end of TbxMbClientSetAdaptiveTimeout ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the coil(s) from the server with the specified node address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            coil read operation.
-** \param     num Number of elements to read from the coils data table. Range can be
-**            1..2000.
-** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
-**            will be written to.
+** \brief     Obtains the current response timeout of a node. With adaptive response
+**            timeouts, it shows the result of the round trip time measurements.
+** \param     channel Handle to the Modbus client channel object.
+** \param     node The address of the server (1..247).
+** \return    Response timeout of the node in milliseconds.
+**
+****************************************************************************************/
+uint16_t TbxMbClientNodeTimeout(tTbxMbClient channel,
+                                uint8_t      node)
+{
+  uint16_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Determine the response timeout of the node. */
+    result = TbxMbClientRttTimeout(clientCtx, node);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientNodeTimeout ***/
+
+
+/************************************************************************************//**
+** \brief     Configures node health tracking. When enabled, the client marks a node as
+**            down, after the specified number of consecutive requests that did not get
+**            a response. Requests for a node that is down fail right away, without
+**            using the bus. This way an offline node no longer costs a response timeout
+**            for each request. Only once its probe is due, a single request for the node
+**            goes on the bus to probe it. The interval between probes starts at probeMin
+**            and doubles with each failed probe, up to probeMax. The node is up again,
+**            once it responds. Note that probes piggyback on the requests of the
+**            application, so a node that is down can only come up again, while the
+**            application keeps sending requests to it. While a node is down, the event
+**            task keeps polling the client channel, such that its millisecond time,
+**            which the probes are scheduled with, stays up-to-date.
+** \param     channel Handle to the Modbus client channel object.
+** \param     enable TBX_TRUE to enable node health tracking, TBX_FALSE to disable it.
+**            It is disabled by default.
+** \param     failMax Number of consecutive requests without a response, after which the
+**            node is down (1..255).
+** \param     probeMin Interval in milliseconds until the first probe of a node that
+**            went down.
+** \param     probeMax Maximum interval in milliseconds between probes.
+** \param     stateChangeFcn Function to call when a node goes down or comes up again
+**            (optional).
 ** \return    TBX_OK if successful, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadCoils(tTbxMbClient   channel,
-                             uint8_t        node,
-                             uint16_t       addr,
-                             uint16_t       num,
-                             uint8_t      * coils)
+uint8_t TbxMbClientSetNodeHealth(tTbxMbClient                channel,
+                                 uint8_t                     enable,
+                                 uint8_t                     failMax,
+                                 uint16_t                    probeMin,
+                                 uint16_t                    probeMax,
+                                 tTbxMbClientNodeStateChange stateChangeFcn)
 {
   uint8_t result = TBX_ERROR;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 2000U) && (coils != NULL));
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (failMax >= 1U) && (probeMin >= 1U) &&
+             (probeMin <= probeMax));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 2000U) && (coils != NULL))
+  if ((channel != NULL) && (failMax >= 1U) && (probeMin >= 1U) && (probeMin <= probeMax))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
+    /* Allocate the health of the nodes, if not yet done. */
+    if ((enable != TBX_FALSE) && (clientCtx->nodeHealth == NULL))
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC01_READ_COILS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of coils. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      size_t                   tableSize = sizeof(tTbxMbClientNodeHealth) *
+                                           (TBX_MB_TP_NODE_ADDR_MAX + 1U);
+      tTbxMbClientNodeHealth * nodeHealth = TbxMemPoolAllocate(tableSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (nodeHealth == NULL)
       {
-        isBroadcast = TBX_TRUE;
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, tableSize);
+        nodeHealth = TbxMemPoolAllocate(tableSize);
       }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
+      /* Initialize the health, if the memory allocation succeeded. All nodes start
+       * out being up.
        */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      if (nodeHealth != NULL)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        for (uint16_t node = 0U; node <= TBX_MB_TP_NODE_ADDR_MAX; node++)
         {
-          /* Determine the number of bytes needed to hold all the coil bits. The cast to
-           * U8 is okay, because we know that num is <= 2000.
-           */
-          uint8_t numBytes = (uint8_t)(num / 8U);
-          if ((num % 8U) != 0U)
-          {
-            numBytes++;
-          }
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC01_READ_COILS) ||
-              (byteCount != numBytes) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Process its data. */
-          else
-          {
-            /* Prepare loop indices that aid with reading the coils. */
-            uint8_t   bitIdx  = 0U;
-            uint8_t   byteIdx = 0U;
-            /* Initialize byte array pointer for reading the coils. */
-            uint8_t * coilData = &rxPacket->pdu.data[1];
-            /* Loop through all the coils. */
-            for (uint16_t idx = 0U; idx < num; idx++)
-            {
-              /* Extract and store the state of the coil. */
-              if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
-              {
-                coils[idx] = TBX_ON;
-              }
-              else
-              {
-                coils[idx] = TBX_OFF;
-              }
-              /* Update the bit index. */
-              bitIdx++;
-              /* Time to move to the next byte? */
-              if (bitIdx == 8U)
-              {
-                /* Reset the bit index and increment the byte index. */
-                bitIdx = 0U;
-                byteIdx++;
-              }
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
+          nodeHealth[node].state = TBX_MB_CLIENT_NODE_STATE_UP;
+          nodeHealth[node].failures = 0U;
+          nodeHealth[node].probing = TBX_FALSE;
+          nodeHealth[node].probeDelay = 0U;
+          nodeHealth[node].probeMs = 0U;
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        clientCtx->nodeHealth = nodeHealth;
       }
     }
-  }      
+    /* Store the configuration, unless the health is needed but not available. Update
+     * it in a critical section, because the event task accesses it too.
+     */
+    if ((enable == TBX_FALSE) || (clientCtx->nodeHealth != NULL))
+    {
+      TbxCriticalSectionEnter();
+      clientCtx->health = (enable == TBX_FALSE) ? TBX_FALSE : TBX_TRUE;
+      clientCtx->failMax = failMax;
+      clientCtx->probeMin = probeMin;
+      clientCtx->probeMax = probeMax;
+      clientCtx->stateChangeFcn = stateChangeFcn;
+      TbxCriticalSectionExit();
+      /* Polling keeps the millisecond time of the channel up-to-date, which the probes
+       * of nodes that are still down rely on.
+       */
+      if ((clientCtx->health == TBX_TRUE) && (clientCtx->nodesDown > 0U))
+      {
+        TbxMbClientStartPolling(clientCtx);
+      }
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadCoils ***/
+} /*** end of TbxMbClientSetNodeHealth ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the discrete input(s) from the server with the specified node
-**            address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            discrete input read operation.
-** \param     num Number of elements to read from the discrete inputs data table. Range
-**            can be 1..2000
-** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
-**            input state will be written to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Obtains the state of a node, as determined by node health tracking.
+** \param     channel Handle to the Modbus client channel object.
+** \param     node The address of the server (1..247).
+** \return    TBX_MB_CLIENT_NODE_STATE_DOWN if the node is down,
+**            TBX_MB_CLIENT_NODE_STATE_UP otherwise. Nodes are always up, while node
+**            health tracking is disabled.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadInputs(tTbxMbClient   channel,
-                              uint8_t        node,
-                              uint16_t       addr,
-                              uint16_t       num,
-                              uint8_t      * inputs)
+uint8_t TbxMbClientNodeState(tTbxMbClient channel,
+                             uint8_t      node)
 {
-  uint8_t result = TBX_ERROR;
+  uint8_t result = TBX_MB_CLIENT_NODE_STATE_UP;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 2000U) && (inputs != NULL));
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 2000U) && (inputs != NULL))
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
+    /* Read out the state of the node, if node health tracking is enabled. */
+    if (clientCtx->health == TBX_TRUE)
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC02_READ_DISCRETE_INPUTS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of discrete inputs. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+      result = clientCtx->nodeHealth[node].state;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientNodeState ***/
 
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+
+/************************************************************************************//**
+** \brief     Adds a range of elements to the read cache of the client channel. A read
+**            that covers the entire range fills the cache entry. Afterwards, reads of
+**            elements within the range are served from the cache entry, without using
+**            the bus, until its time to live passes. This applies to blocking,
+**            asynchronous and custom function code read requests. Writes to elements of
+**            the range, submitted through the same client channel, invalidate the cache
+**            entry right away. Useful when multiple clients, for example behind a
+**            gateway, poll the same elements and can live with slightly outdated values.
+**            Note that hits of asynchronous requests are still served in the order of
+**            the request queue.
+** \param     channel Handle to the Modbus client channel object.
+** \param     node The address of the server (1..247).
+** \param     code Function code for reading the elements. Either
+**            TBX_MB_FC01_READ_COILS, TBX_MB_FC02_READ_DISCRETE_INPUTS,
+**            TBX_MB_FC03_READ_HOLDING_REGISTERS or TBX_MB_FC04_READ_INPUT_REGISTERS.
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of elements of the range. Range can be 1..2000 for coils and
+**            discrete inputs and 1..125 for registers.
+** \param     ttl Time to live in milliseconds of the read values in the cache entry.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. Also TBX_ERROR if the range
+**            overlaps with the range of an existing cache entry.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCacheAdd(tTbxMbClient channel,
+                            uint8_t      node,
+                            uint8_t      code,
+                            uint16_t     addr,
+                            uint16_t     num,
+                            uint16_t     ttl)
+{
+  uint8_t  result = TBX_ERROR;
+  uint16_t numMax = 0U;
+  size_t   dataSize = 0U;
+
+  /* Determine the maximum number of elements and the size of the read data for the
+   * function code.
+   */
+  if ((code == TBX_MB_FC01_READ_COILS) || (code == TBX_MB_FC02_READ_DISCRETE_INPUTS))
+  {
+    numMax = 2000U;
+    dataSize = ((size_t)num + 7U) / 8U;
+  }
+  else if ((code == TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
+           (code == TBX_MB_FC04_READ_INPUT_REGISTERS))
+  {
+    numMax = 125U;
+    dataSize = (size_t)num * 2U;
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= numMax) &&
+             (((uint32_t)addr + num) <= 65536UL) && (ttl > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= numMax) &&
+      (((uint32_t)addr + num) <= 65536UL) && (ttl > 0U))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Make sure the range does not overlap with the range of an existing entry. */
+    uint8_t                  overlaps = TBX_FALSE;
+    tTbxMbClientCacheEntry * entry = clientCtx->cacheList;
+    while ((entry != NULL) && (overlaps == TBX_FALSE))
+    {
+      if ((entry->node == node) && (entry->code == code) &&
+          (((uint32_t)addr + num) > entry->addr) &&
+          (((uint32_t)entry->addr + entry->num) > addr))
       {
-        isBroadcast = TBX_TRUE;
+        overlaps = TBX_TRUE;
       }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      entry = entry->next;
+    }
+    /* Only continue if the range is still available. */
+    if (overlaps == TBX_FALSE)
+    {
+      /* Allocate memory for the new cache entry and its read data. */
+      tTbxMbClientCacheEntry * newEntry;
+      newEntry = TbxMemPoolAllocate(sizeof(tTbxMbClientCacheEntry));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newEntry == NULL)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
          */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientCacheEntry));
+        newEntry = TbxMemPoolAllocate(sizeof(tTbxMbClientCacheEntry));
+      }
+      uint8_t * newData = TbxMemPoolAllocate(dataSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newData == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, dataSize);
+        newData = TbxMemPoolAllocate(dataSize);
+      }
+      /* Verify memory allocation of the cache entry and its read data. */
+      TBX_ASSERT((newEntry != NULL) && (newData != NULL));
+      /* Only continue if the memory allocation succeeded. */
+      if ((newEntry != NULL) && (newData != NULL))
+      {
+        /* Initialize the cache entry. It holds no read data yet. */
+        newEntry->node = node;
+        newEntry->code = code;
+        newEntry->addr = addr;
+        newEntry->num = num;
+        newEntry->ttl = ttl;
+        newEntry->valid = TBX_FALSE;
+        newEntry->fillMs = 0U;
+        newEntry->busMs = 0U;
+        newEntry->data = newData;
+        /* Add it to the client's cache entry list. */
+        TbxCriticalSectionEnter();
+        newEntry->next = clientCtx->cacheList;
+        clientCtx->cacheList = newEntry;
+        TbxCriticalSectionExit();
+        /* Update the result. */
+        result = TBX_OK;
+      }
+      /* Memory allocation only partially succeeded. */
+      else
+      {
+        /* Give the allocated memory back to the memory pool. */
+        if (newEntry != NULL)
         {
-          /* Determine the number of bytes needed to hold all the input bits. The cast to
-           * U8 is okay, because we know that num is <= 2000.
-           */
-          uint8_t numBytes = (uint8_t)(num / 8U);
-          if ((num % 8U) != 0U)
-          {
-            numBytes++;
-          }
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC02_READ_DISCRETE_INPUTS) ||
-              (byteCount != numBytes) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Process its data. */
-          else
-          {
-            /* Prepare loop indices that aid with reading the input bits. */
-            uint8_t   bitIdx  = 0U;
-            uint8_t   byteIdx = 0U;
-            /* Initialize byte array pointer for reading the input bits. */
-            uint8_t * inputData = &rxPacket->pdu.data[1];
-            /* Loop through all the inputs. */
-            for (uint16_t idx = 0U; idx < num; idx++)
-            {
-              /* Extract and store the state of the discrete input. */
-              if ((inputData[byteIdx] & (1U << bitIdx)) != 0U)
-              {
-                inputs[idx] = TBX_ON;
-              }
-              else
-              {
-                inputs[idx] = TBX_OFF;
-              }
-              /* Update the bit index. */
-              bitIdx++;
-              /* Time to move to the next byte? */
-              if (bitIdx == 8U)
-              {
-                /* Reset the bit index and increment the byte index. */
-                bitIdx = 0U;
-                byteIdx++;
-              }
-            }
-          }
+          TbxMemPoolRelease(newEntry);
         }
-        /* Could not access the response packet. */
-        else
+        if (newData != NULL)
         {
-          result = TBX_ERROR;
+          TbxMemPoolRelease(newData);
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
       }
     }
-  }      
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadInputs ***/
+} /*** end of TbxMbClientCacheAdd ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the input register(s) from the server with the specified node
-**            address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            input register read operation.
-** \param     num Number of elements to read from the input registers data table. Range
-**            can be 1..125
-** \param     inputRegs Pointer to array where the input register values will be written
-**            to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Obtains the statistics of the read cache of the client channel. The bus
+**            time saved by a hit is estimated by the time that the read, which filled
+**            the cache entry, took on the bus.
+** \param     channel Handle to the Modbus client channel object.
+** \param     stats Pointer to where the statistics will be written to.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadInputRegs(tTbxMbClient   channel,
-                                 uint8_t        node,
-                                 uint16_t       addr,
-                                 uint8_t        num,
-                                 uint16_t     * inputRegs)
+void TbxMbClientCacheGetStats(tTbxMbClient             channel,
+                              tTbxMbClientCacheStats * stats)
 {
-  uint8_t result = TBX_ERROR;
-
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 125U) && (inputRegs != NULL));
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (stats != NULL));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 125U) && (inputRegs != NULL))
+  if ((channel != NULL) && (stats != NULL))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+    /* Copy the statistics in a critical section, because the event task updates
+     * them.
      */
-    if (txPacket != NULL)
-    {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC04_READ_INPUT_REGISTERS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of registers. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+    TbxCriticalSectionEnter();
+    *stats = clientCtx->cacheStats;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbClientCacheGetStats ***/
 
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this client channel object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus client channel object.
+**
+****************************************************************************************/
+static void TbxMbClientProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context  to the client channel context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(clientCtx != NULL);
+    /* Only continue with a valid context. */
+    if (clientCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
         {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC04_READ_INPUT_REGISTERS) ||
-              (byteCount != (num * 2U)) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
+          /* Are asynchronous requests awaiting a response? */
+          if (clientCtx->reqSent != NULL)
           {
-            result = TBX_ERROR;
+            uint8_t           result = TBX_ERROR;
+            tTbxMbClientReq * req = NULL;
+            /* Obtain read access to the response packet. */
+            tTbxMbTpPacket * rxPacket;
+            rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+            /* Only continue with packet access. */
+            if (rxPacket != NULL)
+            {
+              /* Find the unicast request with the same transaction identifier. */
+              req = clientCtx->reqSent;
+              while ((req != NULL) && ((req->transId != rxPacket->transId) ||
+                                       (req->node == TBX_MB_TP_NODE_ADDR_BROADCAST)))
+              {
+                req = req->next;
+              }
+              /* Validate the response and store its values, if the request was found.
+               * Otherwise the response is dropped.
+               */
+              if (req != NULL)
+              {
+                TbxMbClientReqUnlink(clientCtx, req);
+                result = TbxMbClientReqResponse(req, rxPacket);
+                /* Fill the cache with the values of a successful read. */
+                if ((result == TBX_OK) &&
+                    (req->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS) &&
+                    (req->dataLen == 4U))
+                {
+                  TbxMbClientCacheFill(clientCtx, req->node, req->pdu.code,
+                                       TbxMbCommonExtractUInt16BE(&req->pdu.data[0]),
+                                       TbxMbCommonExtractUInt16BE(&req->pdu.data[2]),
+                                       rxPacket, req->cacheGen, req->startMs);
+                }
+                /* Update the round trip time statistics and the health of the node. */
+                uint32_t nowMs = TbxMbClientTimeMs(clientCtx);
+                TbxMbClientRttUpdate(clientCtx, req->node, nowMs - req->startMs);
+                TbxMbClientHealthUpdate(clientCtx, req->node, TBX_TRUE, nowMs);
+              }
+            }
+            /* Inform the transport layer that were done with the rx packet. */
+            clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+            /* Report the completion of the request. */
+            if (req != NULL)
+            {
+              TbxMbClientReqComplete(clientCtx, req, result);
+            }
           }
-          /* Response content valid. Process its data. */
+          /* Is a task waiting for the response to a blocking request? */
+          else if (clientCtx->syncActive == TBX_TRUE)
+          {
+            /* Give the PDU received semaphore to synchronize whatever task is waiting
+             * for this event.
+             */
+            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          }
+          /* Nobody waits for this response anymore, for example because it came in
+           * after the request timed out.
+           */
           else
           {
-            /* Set pointer to where the input registers start in the response. */
-            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
-            /* Read out and store the input register values. */
-            for (uint8_t idx = 0U; idx < num; idx++)
+            /* Drop the response, such that the transport layer can receive again. */
+            clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+          }
+        }
+        break;
+
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          tTbxMbClientReq * req = clientCtx->reqTransmit;
+          /* Did an asynchronous request complete its transmission? */
+          if ((req != NULL) && (req->state == TBX_MB_CLIENT_REQ_STATE_TRANSMIT))
+          {
+            /* Start waiting for the response or for the turnaround delay to pass. */
+            req->state = TBX_MB_CLIENT_REQ_STATE_RECEIVE;
+            req->startMs = TbxMbClientTimeMs(clientCtx);
+            /* Move the request to the end of the list with sent requests. This frees
+             * up the transport layer for transmitting the next request.
+             */
+            req->next = NULL;
+            if (clientCtx->reqSent == NULL)
             {
-              inputRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
+              clientCtx->reqSent = req;
+            }
+            else
+            {
+              tTbxMbClientReq * lastReq = clientCtx->reqSent;
+              while (lastReq->next != NULL)
+              {
+                lastReq = lastReq->next;
+              }
+              lastReq->next = req;
             }
+            clientCtx->reqSentNum++;
+            clientCtx->reqTransmit = NULL;
+          }
+          /* Is a task waiting for a blocking request's transmission to complete? */
+          else if (clientCtx->syncActive == TBX_TRUE)
+          {
+            /* Give the PDU transmitted semaphore to synchronize whatever task is
+             * waiting for this event.
+             */
+            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          }
+          else
+          {
+            /* Nothing left to do, but MISRA requires this terminating else statement. */
           }
         }
-        /* Could not access the response packet. */
-        else
+        break;
+
+        default:
         {
-          result = TBX_ERROR;
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        break;
       }
     }
   }
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMbClientReadInputRegs ***/
+} /*** end of TbxMbClientProcessEvent ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the holding register(s) from the server with the specified node
-**            address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            holding register read operation.
-** \param     num Number of elements to read from the holding registers data table. Range
-**            can be 1..125
-** \param     holdingRegs Pointer to array where the holding register values will be
-**            written to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Helper function for blocking requests to obtain write access to the request
+**            packet. Blocking requests cannot be mixed with asynchronous requests on the
+**            bus. This function therefore holds back the queued asynchronous requests
+**            and poll groups and waits for the ones in progress to complete, before
+**            claiming the transport layer. This way the blocking request goes ahead of
+**            the queued ones.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \return    Pointer to the request packet if successful, NULL otherwise. Upon success,
+**            always follow up with TbxMbClientTransceive(), which releases the transport
+**            layer again.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadHoldingRegs(tTbxMbClient   channel,
-                                   uint8_t        node,
-                                   uint16_t       addr,
-                                   uint8_t        num,
-                                   uint16_t     * holdingRegs)
+static tTbxMbTpPacket * TbxMbClientTxPacketClaim(tTbxMbClientCtx * clientCtx)
 {
-  uint8_t result = TBX_ERROR;
-
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 125U) && (holdingRegs != NULL));
+  tTbxMbTpPacket * result  = NULL;
+  uint8_t          claimed = TBX_FALSE;
+  uint32_t         startMs = TbxMbClientTimeMs(clientCtx);
 
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 125U) && (holdingRegs != NULL))
+  /* Hold back the queued asynchronous requests and poll groups. */
+  TbxCriticalSectionEnter();
+  clientCtx->syncWaiting++;
+  TbxCriticalSectionExit();
+  /* Claim the transport layer, once the asynchronous requests in progress completed.
+   * They complete within the response timeout after their transmission, either with
+   * a response or with a timeout. Give up if this somehow takes longer.
+   */
+  while ((claimed == TBX_FALSE) &&
+         ((TbxMbClientTimeMs(clientCtx) - startMs) < (2UL * clientCtx->responseTimeout)))
   {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+    TbxCriticalSectionEnter();
+    if ((clientCtx->reqTransmit == NULL) && (clientCtx->reqSent == NULL) &&
+        (clientCtx->syncActive == TBX_FALSE))
+    {
+      clientCtx->syncActive = TBX_TRUE;
+      claimed = TBX_TRUE;
+    }
+    TbxCriticalSectionExit();
+    /* Wait a millisecond before checking again. Nobody gives the semaphore in the
+     * meantime, because no blocking request is active yet. With a superloop, this
+     * also runs the event task, such that the requests in progress can complete.
      */
-    if (txPacket != NULL)
+    if (claimed == TBX_FALSE)
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC03_READ_HOLDING_REGISTERS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of registers. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
-              (byteCount != (num * 2U)) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Process its data. */
-          else
-          {
-            /* Set pointer to where the holding registers start in the response. */
-            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
-            /* Read out and store the holding register values. */
-            for (uint8_t idx = 0U; idx < num; idx++)
-            {
-              holdingRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
+      (void)TbxMbOsalSemTake(clientCtx->transceiveSem, 1U);
+    }
+  }
+  /* No need to hold back the queued asynchronous requests any longer. They cannot
+   * start anyway, while the blocking request is active.
+   */
+  TbxCriticalSectionEnter();
+  clientCtx->syncWaiting--;
+  TbxCriticalSectionExit();
+  /* Obtain write access to the request packet, if the transport layer was claimed. */
+  if (claimed == TBX_TRUE)
+  {
+    result = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Release the transport layer again, if this failed. */
+    if (result == NULL)
+    {
+      clientCtx->syncActive = TBX_FALSE;
     }
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadHoldingRegs ***/
+} /*** end of TbxMbClientTxPacketClaim ***/
 
 
 /************************************************************************************//**
-** \brief     Writes the coil(s) to the server with the specified node address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            coil write operation.
-** \param     num Number of elements to write to the coils data table. Range can be
-**            1..1968
-** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Helper function to both transmit a request packet and receive the reponse
+**            packet, if applicable (unicast).
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     node The address of the server that the request is for.
+** \param     isBroadcast TBX_TRUE for sending a broadcast request, TBX_FALSE for
+**            unicast.
+** \return    TBX_OK if the request packet could be transmitted and (a) a response for
+**            the unicast request was received or (b) the turnaround timeout passed after
+**            sending the broadcast request. TBX_ERROR otherwise.
+** \attention Only call this function after successfully claiming the request packet
+**            with TbxMbClientTxPacketClaim(). It releases the transport layer again.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientWriteCoils(tTbxMbClient         channel,
-                              uint8_t              node,
-                              uint16_t             addr,
-                              uint16_t             num,
-                              uint8_t      const * coils)
+static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
+                                     uint8_t           node,
+                                     uint8_t           isBroadcast)
 {
-  uint8_t result = TBX_ERROR;
+  uint8_t  result      = TBX_ERROR;
+  uint16_t waitTimeout = TbxMbClientRttTimeout(clientCtx, node);
+  uint8_t  allowed     = TBX_TRUE;
+  uint8_t  transmitted = TBX_FALSE;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 1968U) && (coils != NULL));
+  /* Update the wait time in case it is a broadcast request. */
+  if (isBroadcast == TBX_TRUE)
+  {
+    waitTimeout = clientCtx->turnaroundDelay;
+  }
+
+  /* A request for a node that is down fails right away, unless it can probe the
+   * node.
+   */
+  if (isBroadcast == TBX_FALSE)
+  {
+    allowed = TbxMbClientHealthAllow(clientCtx, node, TbxMbClientTimeMs(clientCtx));
+  }
+  /* Request the transport layer to transmit the request packet and update the
+   * result accordingly.
+   */
+  if (allowed == TBX_TRUE)
+  {
+    result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+  }
+  /* Only continue if the request was successfully submitted for transmission. */
+  if (result == TBX_OK)
+  {
+    /* Wait for the request packet transmit completion. The packet response reception
+     * timeout can be re-used for this because a packet transmission won't take longer
+     * than a packet reception, since it uses the same communication interface.
+     */
+    if (TbxMbOsalSemTake(clientCtx->transceiveSem, clientCtx->responseTimeout)
+        == TBX_FALSE)
+    {
+      /* For some reason the packet transmission did not complete within the expected
+       * time.
+       * Flag the error.
+       */
+      result = TBX_ERROR;
+    }
+    /* Only continue if the request successfully completed transmission. */
+    if (result == TBX_OK)
+    {
+      /* The request went on the bus. */
+      transmitted = TBX_TRUE;
+      /* Store the start time of the round trip. */
+      uint32_t startMs = TbxMbClientTimeMs(clientCtx);
+      /* Wait for the reception of the response from the server, with a timeout. */
+      if (TbxMbOsalSemTake(clientCtx->transceiveSem, waitTimeout) == TBX_FALSE)
+      {
+        /* Semaphore timeout occured. Either because no response was received, which
+         * is an error. Or because the turnaround time after the broadcast request
+         * passed, which is okay.
+         */
+        if (isBroadcast == TBX_FALSE)
+        {
+          /* Flag the error. */
+          result = TBX_ERROR;
+          /* Back off the response timeout of the node. */
+          TbxMbClientRttBackoff(clientCtx, node);
+        }
+      }
+      /* Response received. Measure the round trip time. */
+      else if (isBroadcast == TBX_FALSE)
+      {
+        TbxMbClientRttUpdate(clientCtx, node, TbxMbClientTimeMs(clientCtx) - startMs);
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+    }
+  }
+  /* Update the health of the node, if the request went on the bus. Only a request that
+   * was transmitted, but did not get a response, counts as a failure of the node.
+   */
+  if ((transmitted == TBX_TRUE) && (isBroadcast == TBX_FALSE))
+  {
+    TbxMbClientHealthUpdate(clientCtx, node, (result == TBX_OK) ? TBX_TRUE : TBX_FALSE,
+                            TbxMbClientTimeMs(clientCtx));
+  }
+  /* Release the probe of the node, if the request never made it onto the bus. */
+  else if ((allowed == TBX_TRUE) && (isBroadcast == TBX_FALSE))
+  {
+    TbxMbClientHealthRelease(clientCtx, node);
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+  /* Release the transport layer again. */
+  clientCtx->syncActive = TBX_FALSE;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientTransceive ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. It is only
+**            active while asynchronous requests are queued or in progress. It starts the
+**            queued requests, as long as the number of requests awaiting a response
+**            stays below the window size, and detects their timeouts.
+** \param     channel Handle to the Modbus client channel object.
+**
+****************************************************************************************/
+static void TbxMbClientPoll(tTbxMbClient channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 1968U) && (coils != NULL))
+  if (channel != NULL)
   {
+    uint8_t stopPolling = TBX_FALSE;
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+    /* Update the millisecond time of the channel. */
+    uint32_t nowMs = TbxMbClientTimeMs(clientCtx);
+    /* Run the scheduler of the poll groups. */
+    TbxMbClientGroupsPoll(clientCtx, nowMs);
+    /* Take the next request from the queue, if the transport layer is available and
+     * the window allows another request awaiting a response. This is not possible while
+     * a blocking request is in progress or waiting to go ahead.
      */
-    if (txPacket != NULL)
+    if (clientCtx->reqTransmit == NULL)
     {
-      /* Writing just a single coil? */
-      if (num == 1U)
+      TbxCriticalSectionEnter();
+      if ((clientCtx->syncActive == TBX_FALSE) && (clientCtx->syncWaiting == 0U) &&
+          (clientCtx->reqHead != NULL) && (clientCtx->reqSentNum < clientCtx->reqWindow))
       {
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC05_WRITE_SINGLE_COIL;
-        txPacket->dataLen = 4U;
-        /* Coil address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Coil value. */
-        uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
-        TbxMbCommonStoreUInt16BE(coilValue, &txPacket->pdu.data[2]);
+        clientCtx->reqTransmit = clientCtx->reqHead;
+        clientCtx->reqHead = clientCtx->reqHead->next;
+        clientCtx->reqTransmit->next = NULL;
+        if (clientCtx->reqHead == NULL)
+        {
+          clientCtx->reqTail = NULL;
+        }
       }
-      /* Writing multiple coils. */
-      else
+      TbxCriticalSectionExit();
+      /* Start the request, if one was taken from the queue. */
+      if (clientCtx->reqTransmit != NULL)
       {
-        /* Determine the number of bytes needed to hold all the coil bits. The cast to
-         * U8 is okay, because we know that num is <= 1968.
+        tTbxMbClientReq * newReq = clientCtx->reqTransmit;
+        /* A read that the cache can serve completes right away, without using the
+         * bus.
          */
-        uint8_t numBytes = (uint8_t)(num / 8U);
-        if ((num % 8U) != 0U)
+        if ((newReq->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS) &&
+            (newReq->dataLen == 4U) &&
+            (TbxMbClientCacheRead(clientCtx, newReq->node, newReq->pdu.code,
+                                  TbxMbCommonExtractUInt16BE(&newReq->pdu.data[0]),
+                                  TbxMbCommonExtractUInt16BE(&newReq->pdu.data[2]),
+                                  newReq->values, newReq->rawLen, nowMs) == TBX_OK))
         {
-          numBytes++;
+          clientCtx->reqTransmit = NULL;
+          TbxMbClientReqComplete(clientCtx, newReq, TBX_OK);
         }
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC15_WRITE_MULTIPLE_COILS;
-        txPacket->dataLen = numBytes + 5U;
-        /* Start address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Number of holding registers. */
-        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-        /* Byte count. */
-        txPacket->pdu.data[4] = numBytes;
-        /* Prepare loop indices that aid with reading the input bits. */
-        uint8_t   bitIdx  = 0U;
-        uint8_t   byteIdx = 0U;
-        /* Set pointer to where the coils start in the request and already initialize the
-         * first byte to all zero (coil OFF) bits.
-        */
-        uint8_t * coilData = &txPacket->pdu.data[5];
-        coilData[0] = 0U;
-        /* Store the coil values. */
-        for (uint16_t idx = 0U; idx < num; idx++)
+        /* A request for a node that is down fails right away, unless it can probe the
+         * node.
+         */
+        else if ((newReq->node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+                 (TbxMbClientHealthAllow(clientCtx, newReq->node, nowMs) == TBX_FALSE))
         {
-          /* Should the coil be ON? */
-          if (coils[idx] != TBX_OFF)
-          {
-            coilData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
+          clientCtx->reqTransmit = NULL;
+          TbxMbClientReqComplete(clientCtx, newReq, TBX_ERROR);
+        }
+        else
+        {
+          /* Merge it with queued reads of neighboring elements, if enabled. */
+          if (clientCtx->coalesce == TBX_TRUE)
           {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (coil OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            coilData[byteIdx] = 0U;
+            clientCtx->reqTransmit = TbxMbClientReqCoalesce(clientCtx,
+                                                            clientCtx->reqTransmit);
           }
+          clientCtx->reqTransmit->transId = clientCtx->reqTransId++;
+          clientCtx->reqTransmit->state = TBX_MB_CLIENT_REQ_STATE_START;
+          clientCtx->reqTransmit->startMs = nowMs;
         }
       }
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
+    }
+    /* Waiting for the transport layer to accept the request? */
+    tTbxMbClientReq * req = clientCtx->reqTransmit;
+    if ((req != NULL) && (req->state == TBX_MB_CLIENT_REQ_STATE_START))
+    {
+      /* Attempt to obtain write access to the request packet. This fails while the
+       * transport layer is still busy transmitting. In this case it is retried the next
+       * time this function is called.
        */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      if (txPacket != NULL)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
+        /* Prepare the request packet. */
+        txPacket->node = req->node;
+        txPacket->transId = req->transId;
+        txPacket->dataLen = req->dataLen;
+        txPacket->pdu.code = req->pdu.code;
+        for (uint8_t idx = 0U; idx < req->dataLen; idx++)
+        {
+          txPacket->pdu.data[idx] = req->pdu.data[idx];
+        }
+        /* Update the state before submitting the request for transmission, because
+         * the transmission might already complete before the transport layer returns.
          */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        req->state = TBX_MB_CLIENT_REQ_STATE_TRANSMIT;
+        /* The transport layer refuses the transmission while it is still receiving or
+         * waiting for the bus to become idle. Retry the next time in this case.
+         */
+        if (clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx) != TBX_OK)
         {
-          /* Wrote just a single coil? */
-          if (num == 1U)
-          {
-            /* Coil value. */
-            uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the coil
-             * address and value are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC05_WRITE_SINGLE_COIL) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != coilValue) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
-          /* Wrote multiple holding registers. */
-          else
-          {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the coil
-             * start address and quantity are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC15_WRITE_MULTIPLE_COILS) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
+          req->state = TBX_MB_CLIENT_REQ_STATE_START;
+        }
+        /* Transmission started. Restart the timeout. */
+        else if (clientCtx->reqTransmit == req)
+        {
+          req->startMs = nowMs;
         }
-        /* Could not access the response packet. */
         else
         {
-          result = TBX_ERROR;
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
       }
     }
-  }  
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMbClientWriteCoils ***/
+    /* Did the request not get accepted or transmitted in time? The packet response
+     * reception timeout can be re-used for this, because a packet transmission won't
+     * take longer than a packet reception.
+     */
+    req = clientCtx->reqTransmit;
+    if ((req != NULL) &&
+        ((nowMs - req->startMs) >= clientCtx->responseTimeout))
+    {
+      clientCtx->reqTransmit = NULL;
+      /* The request never went on the bus, so it does not count against the node. */
+      TbxMbClientHealthRelease(clientCtx, req->node);
+      TbxMbClientReqComplete(clientCtx, req, TBX_ERROR);
+    }
+    /* Check the requests that await a response or for the turnaround delay to pass. */
+    req = clientCtx->reqSent;
+    while (req != NULL)
+    {
+      tTbxMbClientReq * nextReq = req->next;
+      uint32_t          elapsedMs = nowMs - req->startMs;
+      /* A broadcast request completes once the turnaround delay passed. */
+      if (req->node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        if (elapsedMs >= clientCtx->turnaroundDelay)
+        {
+          TbxMbClientReqUnlink(clientCtx, req);
+          TbxMbClientReqComplete(clientCtx, req, TBX_OK);
+        }
+      }
+      /* A unicast request fails if no response came in time. */
+      else
+      {
+        if (elapsedMs >= TbxMbClientRttTimeout(clientCtx, req->node))
+        {
+          TbxMbClientRttBackoff(clientCtx, req->node);
+          TbxMbClientHealthUpdate(clientCtx, req->node, TBX_FALSE, nowMs);
+          TbxMbClientReqUnlink(clientCtx, req);
+          TbxMbClientReqComplete(clientCtx, req, TBX_ERROR);
+        }
+      }
+      /* Continue with the next request. */
+      req = nextReq;
+    }
+    /* Let the cache entries expire, whose time to live passed. */
+    uint8_t cacheFilled = TbxMbClientCacheExpire(clientCtx, nowMs);
+    /* Stop polling once all requests completed, there are no poll groups, all cache
+     * entries expired and no tracked node is down. The latter two keep the millisecond
+     * time of the channel up-to-date for as long as cache entries can serve reads and
+     * for as long as nodes await their probe.
+     */
+    TbxCriticalSectionEnter();
+    if ((clientCtx->reqHead == NULL) && (clientCtx->reqTransmit == NULL) &&
+        (clientCtx->reqSent == NULL) && (clientCtx->groupList == NULL) &&
+        (cacheFilled == TBX_FALSE) &&
+        ((clientCtx->health == TBX_FALSE) || (clientCtx->nodesDown == 0U)))
+    {
+      clientCtx->reqPolling = TBX_FALSE;
+      stopPolling = TBX_TRUE;
+    }
+    TbxCriticalSectionExit();
+    /* Done with all requests? */
+    if (stopPolling == TBX_TRUE)
+    {
+      /* Instruct the event task to stop calling our polling function. */
+      tTbxMbEvent newEvent;
+      newEvent.context = clientCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+  }
+} /*** end of TbxMbClientPoll ***/
 
 
 /************************************************************************************//**
-** \brief     Writes the holding register(s) to the server with the specified node
-**            address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            holding register write operation.
-** \param     num Number of elements to write to the holding registers data table. Range
-**            can be 1..123
-** \param     holdingRegs Pointer to array with the desired holding register values.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Obtains the millisecond time of the client channel. It is only updated
+**            while calling this function, which the event task does at least once per
+**            millisecond while the channel is being polled.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \return    Free running millisecond time.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
-                                    uint8_t              node,
-                                    uint16_t             addr,
-                                    uint8_t              num,
-                                    uint16_t     const * holdingRegs)
+static uint32_t TbxMbClientTimeMs(tTbxMbClientCtx * clientCtx)
 {
-  uint8_t result = TBX_ERROR;
+  uint32_t result;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 123U) && (holdingRegs != NULL));
+  /* Update the millisecond time in a critical section, because blocking requests also
+   * call this function, possibly from a different task than the event task.
+   */
+  TbxCriticalSectionEnter();
+  /* Get the number of ticks that elapsed since the last millisecond detection. Note
+   * that this calculation works, even if the 20 kHz timer counter overflowed.
+   */
+  uint16_t deltaMs = (uint16_t)(TbxMbPortTimerCount() - clientCtx->tickTime) / 20U;
+  /* Update the millisecond time. */
+  clientCtx->tickTime += (deltaMs * 20U);
+  clientCtx->timeMs += deltaMs;
+  result = clientCtx->timeMs;
+  TbxCriticalSectionExit();
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientTimeMs ***/
 
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 123U) && (holdingRegs != NULL))
+
+/************************************************************************************//**
+** \brief     Obtains the response timeout of a node. With adaptive response timeouts,
+**            it is derived from the round trip time statistics of the node, the same way
+**            TCP derives its retransmission timeout: The smoothed round trip time plus
+**            four times its mean deviation. Each response timeout since the last
+**            measurement doubles it. The result is limited to the configured bounds.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \return    Response timeout in milliseconds.
+**
+****************************************************************************************/
+static uint16_t TbxMbClientRttTimeout(tTbxMbClientCtx * clientCtx,
+                                      uint8_t           node)
+{
+  uint16_t result = clientCtx->responseTimeout;
+
+  /* Only derive the timeout for a node, if adaptive response timeouts are enabled. */
+  if ((clientCtx->adaptive == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
   {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    tTbxMbClientNodeRtt const * nodeRtt = &clientCtx->nodeRtt[node];
+    /* Use the upper bound, as long as the node's round trip time was not yet
+     * measured.
+     */
+    uint32_t timeoutMs = clientCtx->timeoutMax;
+    if (nodeRtt->valid == TBX_TRUE)
+    {
+      /* Add at least one millisecond for the deviation, to account for the resolution
+       * of the measurements.
+       */
+      uint32_t deviationMs = nodeRtt->rttVar;
+      if (deviationMs < 1U)
+      {
+        deviationMs = 1U;
+      }
+      timeoutMs = ((nodeRtt->srtt / 8U) + deviationMs) << nodeRtt->backoff;
+    }
+    /* Limit it to the configured bounds. */
+    if (timeoutMs < clientCtx->timeoutMin)
+    {
+      timeoutMs = clientCtx->timeoutMin;
+    }
+    if (timeoutMs > clientCtx->timeoutMax)
+    {
+      timeoutMs = clientCtx->timeoutMax;
+    }
+    /* Update the result. The cast is okay, because it is limited to a U16 value. */
+    result = (uint16_t)timeoutMs;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRttTimeout ***/
 
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+
+/************************************************************************************//**
+** \brief     Updates the round trip time statistics of a node with a new measurement.
+**            The exponentially weighted moving averages use the gains of TCP: 1/8 for
+**            the smoothed round trip time and 1/4 for its mean deviation.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     rttMs Measured round trip time in milliseconds.
+**
+****************************************************************************************/
+static void TbxMbClientRttUpdate(tTbxMbClientCtx * clientCtx,
+                                 uint8_t           node,
+                                 uint32_t          rttMs)
+{
+  /* Only update the statistics, if adaptive response timeouts are enabled. */
+  if ((clientCtx->adaptive == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    tTbxMbClientNodeRtt * nodeRtt = &clientCtx->nodeRtt[node];
+    /* Limit the contribution of a single measurement. */
+    if (rttMs > TBX_MB_CLIENT_RTT_SAMPLE_MAX)
+    {
+      rttMs = TBX_MB_CLIENT_RTT_SAMPLE_MAX;
+    }
+    /* Initialize the statistics with the first measurement. The mean deviation starts
+     * at half the round trip time.
      */
-    if (txPacket != NULL)
+    if (nodeRtt->valid == TBX_FALSE)
     {
-      /* Writing just a single holding register? */
-      if (num == 1U)
+      nodeRtt->srtt = (uint16_t)(rttMs * 8U);
+      nodeRtt->rttVar = (uint16_t)(rttMs * 2U);
+      nodeRtt->valid = TBX_TRUE;
+    }
+    /* Update the statistics with the measurement. */
+    else
+    {
+      /* Determine how much the measurement deviates from the smoothed round trip
+       * time.
+       */
+      uint32_t srttMs = nodeRtt->srtt / 8U;
+      uint32_t deviationMs = (rttMs > srttMs) ? (rttMs - srttMs) : (srttMs - rttMs);
+      /* Update the mean deviation, which is scaled by 4. With deviationMs <= 8000, the
+       * result stays within 16 bits.
+       */
+      nodeRtt->rttVar = (uint16_t)((nodeRtt->rttVar + deviationMs) -
+                                   (nodeRtt->rttVar / 4U));
+      /* Update the smoothed round trip time, which is scaled by 8. With rttMs <= 8000,
+       * the result stays within 16 bits.
+       */
+      nodeRtt->srtt = (uint16_t)((nodeRtt->srtt + rttMs) - srttMs);
+    }
+    /* The node responded, so its response timeout no longer needs to be backed off. */
+    nodeRtt->backoff = 0U;
+  }
+} /*** end of TbxMbClientRttUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Backs off the response timeout of a node, after a response timeout. It
+**            makes sure that the timeout adapts upwards, when a node became slower.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+**
+****************************************************************************************/
+static void TbxMbClientRttBackoff(tTbxMbClientCtx * clientCtx,
+                                  uint8_t           node)
+{
+  /* Only back off, if adaptive response timeouts are enabled. */
+  if ((clientCtx->adaptive == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    tTbxMbClientNodeRtt * nodeRtt = &clientCtx->nodeRtt[node];
+    /* Double the response timeout, until it reached the maximum number of doublings. */
+    if (nodeRtt->backoff < TBX_MB_CLIENT_RTT_BACKOFF_MAX)
+    {
+      nodeRtt->backoff++;
+    }
+  }
+} /*** end of TbxMbClientRttBackoff ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if a request for a node is allowed to go on the bus. This is
+**            always the case for a node that is up. For a node that is down, only a
+**            single request is allowed, once its probe is due. This request probes the
+**            node.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     nowMs Current millisecond time of the channel.
+** \return    TBX_TRUE if the request is allowed to go on the bus, TBX_FALSE if it should
+**            fail right away.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientHealthAllow(tTbxMbClientCtx * clientCtx,
+                                      uint8_t           node,
+                                      uint32_t          nowMs)
+{
+  uint8_t result = TBX_TRUE;
+
+  /* Only check the node, if node health tracking is enabled. */
+  if ((clientCtx->health == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    tTbxMbClientNodeHealth * nodeHealth = &clientCtx->nodeHealth[node];
+    /* Is the node down? */
+    if (nodeHealth->state == TBX_MB_CLIENT_NODE_STATE_DOWN)
+    {
+      /* Only allow the request, if no probe is in progress and the probe is due. Note
+       * that the calculation works, even if the millisecond time overflowed.
+       */
+      if ((nodeHealth->probing == TBX_FALSE) &&
+          ((int32_t)(nowMs - nodeHealth->probeMs) >= 0))
       {
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
-        txPacket->dataLen = 4U;
-        /* Holding register address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Holding register value. */
-        TbxMbCommonStoreUInt16BE(holdingRegs[0], &txPacket->pdu.data[2]);
+        nodeHealth->probing = TBX_TRUE;
       }
-      /* Writing multiple holding registers. */
       else
       {
-        /* Determine byte count needed for storing the holding register values. */
-        uint8_t byteCount = num * 2U;
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
-        txPacket->dataLen = byteCount + 5U;
-        /* Start address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Number of holding registers. */
-        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-        /* Byte count. */
-        txPacket->pdu.data[4] = byteCount;
-        /* Set pointer to where the holding registers start in the request. */
-        uint8_t * regValPtr = &txPacket->pdu.data[5];
-        /* Store the holding register values. */
-        for (uint8_t idx = 0U; idx < num; idx++)
-        {
-          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &regValPtr[idx * 2U]);
-        }
+        result = TBX_FALSE;
       }
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientHealthAllow ***/
+
+
+/************************************************************************************//**
+** \brief     Updates the health of a node, after a request for the node went on the bus.
+**            A node goes down after the configured number of consecutive requests that
+**            did not get a response. It comes up again, once it responds. A failed probe
+**            doubles the interval until the next probe, up to the configured maximum.
+**            State changes are reported with the callback function.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     responded TBX_TRUE if the node responded, TBX_FALSE otherwise.
+** \param     nowMs Current millisecond time of the channel.
+**
+****************************************************************************************/
+static void TbxMbClientHealthUpdate(tTbxMbClientCtx * clientCtx,
+                                    uint8_t           node,
+                                    uint8_t           responded,
+                                    uint32_t          nowMs)
+{
+  /* Only update the health, if node health tracking is enabled. */
+  if ((clientCtx->health == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    tTbxMbClientNodeHealth * nodeHealth = &clientCtx->nodeHealth[node];
+    uint8_t                  oldState = nodeHealth->state;
+    /* The probe, if any, completed. */
+    nodeHealth->probing = TBX_FALSE;
+    /* Did the node respond? */
+    if (responded == TBX_TRUE)
+    {
+      /* No longer count the node as down, if it was. */
+      if (oldState == TBX_MB_CLIENT_NODE_STATE_DOWN)
       {
-        isBroadcast = TBX_TRUE;
+        TbxCriticalSectionEnter();
+        clientCtx->nodesDown--;
+        TbxCriticalSectionExit();
       }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+      /* The node is up. */
+      nodeHealth->failures = 0U;
+      nodeHealth->state = TBX_MB_CLIENT_NODE_STATE_UP;
+    }
+    /* Did the node stop responding while it was up? */
+    else if (oldState == TBX_MB_CLIENT_NODE_STATE_UP)
+    {
+      /* Count the consecutive failures. */
+      if (nodeHealth->failures < 255U)
+      {
+        nodeHealth->failures++;
+      }
+      /* The node is down, once the threshold is reached. Schedule its first probe. */
+      if (nodeHealth->failures >= clientCtx->failMax)
+      {
+        nodeHealth->state = TBX_MB_CLIENT_NODE_STATE_DOWN;
+        nodeHealth->probeDelay = clientCtx->probeMin;
+        nodeHealth->probeMs = nowMs + nodeHealth->probeDelay;
+        /* Count the node as down. Update it in a critical section, because the event
+         * task accesses it too.
+         */
+        TbxCriticalSectionEnter();
+        clientCtx->nodesDown++;
+        TbxCriticalSectionExit();
+        /* Polling is needed to keep the millisecond time of the channel up-to-date,
+         * until the node is probed. Otherwise the time only advances while requests
+         * are in progress and the probe might never become due.
+         */
+        TbxMbClientStartPolling(clientCtx);
+      }
+    }
+    /* The probe of the node failed. */
+    else
+    {
+      /* Double the interval until the next probe, up to the maximum. */
+      if (nodeHealth->probeDelay > (clientCtx->probeMax / 2U))
+      {
+        nodeHealth->probeDelay = clientCtx->probeMax;
+      }
+      else
+      {
+        nodeHealth->probeDelay *= 2U;
+      }
+      /* Schedule the next probe. */
+      nodeHealth->probeMs = nowMs + nodeHealth->probeDelay;
+    }
+    /* Report a state change to the application, if it is interested. */
+    if ((nodeHealth->state != oldState) && (clientCtx->stateChangeFcn != NULL))
+    {
+      clientCtx->stateChangeFcn(clientCtx, node, nodeHealth->state);
+    }
+  }
+} /*** end of TbxMbClientHealthUpdate ***/
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+
+/************************************************************************************//**
+** \brief     Releases the probe of a node, after a request for the node never made it
+**            onto the bus. It does not count as a failure of the node, since the node
+**            did not get a chance to respond. Instead, the next request may probe it.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+**
+****************************************************************************************/
+static void TbxMbClientHealthRelease(tTbxMbClientCtx * clientCtx,
+                                     uint8_t           node)
+{
+  /* Only release the probe, if node health tracking is enabled. */
+  if ((clientCtx->health == TBX_TRUE) && (node != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    clientCtx->nodeHealth[node].probing = TBX_FALSE;
+  }
+} /*** end of TbxMbClientHealthRelease ***/
+
+
+/************************************************************************************//**
+** \brief     Attempts to serve a read from the read cache. This works if the elements
+**            lie within the range of a cache entry that holds read data, whose time to
+**            live did not yet pass. The values are written in the same format as those
+**            of a read request. For a custom function code request, that is the response
+**            PDU.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     code Function code of the read.
+** \param     addr Starting element address in the Modbus data table.
+** \param     num Number of elements to read.
+** \param     values Pointer to the array where the read values will be written to. NULL
+**            to not store the values, for example because the request was cancelled.
+** \param     rawLen Pointer to where the length of the response PDU will be written to,
+**            in case of a custom function code request. NULL otherwise.
+** \param     nowMs Current millisecond time of the channel.
+** \return    TBX_OK if the read was served from the cache, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientCacheRead(tTbxMbClientCtx * clientCtx,
+                                    uint8_t           node,
+                                    uint8_t           code,
+                                    uint16_t          addr,
+                                    uint16_t          num,
+                                    void            * values,
+                                    uint8_t         * rawLen,
+                                    uint32_t          nowMs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Find the cache entry with a range that holds the elements. */
+  TbxCriticalSectionEnter();
+  tTbxMbClientCacheEntry * entry = clientCtx->cacheList;
+  while ((entry != NULL) &&
+         ((entry->node != node) || (entry->code != code) || (addr < entry->addr) ||
+          (((uint32_t)addr + num) > ((uint32_t)entry->addr + entry->num))))
+  {
+    entry = entry->next;
+  }
+  /* Only continue if the read is cacheable. */
+  if (entry != NULL)
+  {
+    /* Miss if the entry holds no read data or if its time to live passed. */
+    if ((entry->valid == TBX_FALSE) || ((nowMs - entry->fillMs) >= entry->ttl))
+    {
+      clientCtx->cacheStats.misses++;
+    }
+    /* Hit. Store the values, if requested. */
+    else
+    {
+      uint16_t offset = addr - entry->addr;
+      /* Reading bits? */
+      if (code <= TBX_MB_FC02_READ_DISCRETE_INPUTS)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
+        uint8_t * bits = (uint8_t *)values;
+        /* Custom function code request? Then build the response PDU with the bits
+         * packed into bytes.
          */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        if ((values != NULL) && (rawLen != NULL))
         {
-          /* Wrote just a single holding register? */
-          if (num == 1U)
+          uint8_t byteCount = (uint8_t)((num + 7U) / 8U);
+          bits[0] = code;
+          bits[1] = byteCount;
+          for (uint8_t idx = 0U; idx < byteCount; idx++)
           {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the register
-             * address and values are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC06_WRITE_SINGLE_REGISTER) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != holdingRegs[0]) ||
-                (rxPacket->dataLen != 4U))
+            bits[idx + 2U] = 0U;
+          }
+          bits = &bits[2];
+          *rawLen = byteCount + 2U;
+        }
+        /* Extract and store the state of all the bits. */
+        for (uint16_t idx = 0U; (idx < num) && (values != NULL); idx++)
+        {
+          uint16_t bitIdx = offset + idx;
+          uint8_t  bitOn = ((entry->data[bitIdx / 8U] & (1U << (bitIdx % 8U))) != 0U) ?
+                           TBX_TRUE : TBX_FALSE;
+          if (rawLen != NULL)
+          {
+            if (bitOn == TBX_TRUE)
             {
-              result = TBX_ERROR;
+              bits[idx / 8U] |= (uint8_t)(1U << (idx % 8U));
             }
           }
-          /* Wrote multiple holding registers. */
           else
           {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the register
-             * start address and quantity are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
+            bits[idx] = (bitOn == TBX_TRUE) ? TBX_ON : TBX_OFF;
+          }
+        }
+      }
+      /* Reading registers. */
+      else
+      {
+        uint8_t const * regData = &entry->data[offset * 2U];
+        /* Custom function code request? Then build the response PDU with the
+         * registers as is.
+         */
+        if ((values != NULL) && (rawLen != NULL))
+        {
+          uint8_t * rxPdu = (uint8_t *)values;
+          rxPdu[0] = code;
+          rxPdu[1] = (uint8_t)(num * 2U);
+          for (uint16_t idx = 0U; idx < (num * 2U); idx++)
+          {
+            rxPdu[idx + 2U] = regData[idx];
+          }
+          *rawLen = rxPdu[1] + 2U;
+        }
+        /* Extract and store the register values. */
+        else if (values != NULL)
+        {
+          uint16_t * regs = (uint16_t *)values;
+          for (uint16_t idx = 0U; idx < num; idx++)
+          {
+            regs[idx] = TbxMbCommonExtractUInt16BE(&regData[idx * 2U]);
           }
         }
-        /* Could not access the response packet. */
         else
         {
-          result = TBX_ERROR;
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
       }
+      /* Update the statistics. */
+      clientCtx->cacheStats.hits++;
+      clientCtx->cacheStats.savedMs += entry->busMs;
+      /* Update the result. */
+      result = TBX_OK;
     }
-
-  }      
+  }
+  TbxCriticalSectionExit();
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientWriteHoldingRegs ***/
+} /*** end of TbxMbClientCacheRead ***/
 
 
 /************************************************************************************//**
-** \brief     Perform diagnostic operation on the server for checking the communication
-**            system.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     subcode Sub-function code for specifying the diagnostic operation to
-**            perform. Currently supported values:
-**              - TBX_MB_DIAG_SC_QUERY_DATA
-**              - TBX_MB_DIAG_SC_CLEAR_COUNTERS
-**              - TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT
-**              - TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT
-**              - TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT
-**              - TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT
-**              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
-** \param     count Location where the retrieved count value will be written to. Only
-**            applicable for the subcodes that end with _COUNT.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Fills the read cache entries, whose range lies within the elements of a
+**            successful read response. This is skipped if a write invalidated cache
+**            entries after the read was submitted, because the response might then hold
+**            values from before the write.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     code Function code of the read.
+** \param     addr Starting element address of the read.
+** \param     num Number of elements of the read.
+** \param     rxPacket Pointer to the response packet.
+** \param     cacheGen Cache generation when the read was submitted.
+** \param     startMs Millisecond time of the channel when the read went on the bus.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
-                               uint8_t        node,
-                               uint16_t       subcode,
-                               uint16_t     * count)
+static void TbxMbClientCacheFill(tTbxMbClientCtx       * clientCtx,
+                                 uint8_t                 node,
+                                 uint8_t                 code,
+                                 uint16_t                addr,
+                                 uint16_t                num,
+                                 tTbxMbTpPacket  const * rxPacket,
+                                 uint16_t                cacheGen,
+                                 uint32_t                startMs)
 {
-  uint8_t        result      = TBX_ERROR;
-  uint16_t const queryData[] = { 0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U };
+  uint8_t filled = TBX_FALSE;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
-              (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
-
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
-       (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)))
+  /* Only continue if the channel caches reads. */
+  if (clientCtx->cacheList != NULL)
   {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+    uint32_t nowMs = TbxMbClientTimeMs(clientCtx);
+    /* Determine the number of bytes that the read data should have. */
+    uint16_t byteCount = (code <= TBX_MB_FC02_READ_DISCRETE_INPUTS) ?
+                         ((num + 7U) / 8U) : (num * 2U);
+    /* Only continue with a response of the read and if no write invalidated cache
+     * entries in the meantime.
      */
-    if (txPacket != NULL)
+    TbxCriticalSectionEnter();
+    if ((rxPacket->pdu.code == code) && (rxPacket->pdu.data[0] == byteCount) &&
+        (rxPacket->dataLen == (byteCount + 1U)) && (cacheGen == clientCtx->cacheGen))
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC08_DIAGNOSTICS;
-      TbxMbCommonStoreUInt16BE(subcode, &txPacket->pdu.data[0]);
-      /* Requested to perform a query data diagnostic operation? */
-      if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
-      {
-        /* Write the query data for loopback testing. */
-        for (uint8_t idx = 0U; idx < (sizeof(queryData)/sizeof(queryData[0])); idx++)
-        {
-          TbxMbCommonStoreUInt16BE(queryData[idx], &txPacket->pdu.data[2U + (idx * 2U)]);
-        }
-        txPacket->dataLen = ((sizeof(queryData) / sizeof(queryData[0])) * 2U) + 2U;
-      }
-      /* All other supported subcodes require a 16-bit zero value data field. */
-      else
-      {
-        /* Store the data field as per the protocol. */
-        TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
-        txPacket->dataLen = 4U;
-      }
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      uint8_t const * readData = &rxPacket->pdu.data[1];
+      tTbxMbClientCacheEntry * entry = clientCtx->cacheList;
+      while (entry != NULL)
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        /* Does the read cover the entire range of the cache entry? */
+        if ((entry->node == node) && (entry->code == code) && (entry->addr >= addr) &&
+            (((uint32_t)entry->addr + entry->num) <= ((uint32_t)addr + num)))
         {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that it's a
-           * response with the same function sub-code.
-           */
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
-              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
+          uint16_t offset = entry->addr - addr;
+          /* Copy the bits of the range. */
+          if (code <= TBX_MB_FC02_READ_DISCRETE_INPUTS)
           {
-            result = TBX_ERROR;
-          }
-          /* Response looks valid so far. Continue with processing its data.*/
-          else
-          {
-            if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
-            {
-              const uint8_t queryDataLen = sizeof(queryData) / sizeof(queryData[0]);
-              /* Check the data length. */
-              if (rxPacket->dataLen != ((queryDataLen * 2U) + 2U))
-              {
-                result = TBX_ERROR;
-              }
-              /* Data length okay, continue with checking its content. */
-              else
-              {
-                /* Loop through the received query data. */
-                for (uint8_t idx = 0U; idx < queryDataLen; idx++)
-                {
-                  uint8_t const * entryPtr = &rxPacket->pdu.data[2];
-                  uint16_t entry = TbxMbCommonExtractUInt16BE(&entryPtr[idx * 2U]);
-                  /* Check that its value is the same as what was sent in the request. */
-                  if (entry != queryData[idx])
-                  {
-                    /* Flag the error and stop the loop. */
-                    result = TBX_ERROR;
-                    break;
-                  }
-                }
-              }
-            }
-            else if (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS)
+            for (uint16_t idx = 0U; idx < entry->num; idx++)
             {
-              /* Check the data length. */
-              if (rxPacket->dataLen != 4U)
+              uint16_t bitIdx = offset + idx;
+              if ((readData[bitIdx / 8U] & (1U << (bitIdx % 8U))) != 0U)
               {
-                result = TBX_ERROR;
+                entry->data[idx / 8U] |= (uint8_t)(1U << (idx % 8U));
               }
-              /* Data length okay, continue with checking its content. */
               else
               {
-                uint8_t const * dataValPtr = &rxPacket->pdu.data[2];
-                uint16_t dataVal = TbxMbCommonExtractUInt16BE(dataValPtr);
-                /* Check that the value is as expected. */
-                if (dataVal != 0x0000U)
-                {
-                  result = TBX_ERROR;
-                }
+                entry->data[idx / 8U] &= (uint8_t)~(1U << (idx % 8U));
               }
             }
-            /* subcode for reading a count. */
-            else
+          }
+          /* Copy the registers of the range. */
+          else
+          {
+            for (uint16_t idx = 0U; idx < (entry->num * 2U); idx++)
             {
-              /* Check the data length. */
-              if (rxPacket->dataLen != 4U)
-              {
-                result = TBX_ERROR;
-              }
-              /* Data length okay, continue with extracting the count value. */
-              else
-              {
-                uint8_t const * countValPtr = &rxPacket->pdu.data[2];
-                uint16_t countVal = TbxMbCommonExtractUInt16BE(countValPtr);
-                /* Verify that count parameter. */
-                TBX_ASSERT(count != NULL);
-                /* Only continue with a valid count parameter. */
-                if (count != NULL)
-                {
-                  /* Store the count value. */
-                  *count = countVal;
-                }
-                else
-                {
-                  /* The an error due to an invalid count parameter. */
-                  result = TBX_ERROR;
-                }
-              }
+              entry->data[idx] = readData[(offset * 2U) + idx];
             }
           }
+          /* The cache entry now holds read data. */
+          entry->valid = TBX_TRUE;
+          entry->fillMs = nowMs;
+          entry->busMs = (uint16_t)(nowMs - startMs);
+          filled = TBX_TRUE;
         }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        /* Continue with the next cache entry. */
+        entry = entry->next;
       }
     }
+    TbxCriticalSectionExit();
   }
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMbClientDiagnostics ***/
+  /* Polling is needed to let the cache entries expire. */
+  if (filled == TBX_TRUE)
+  {
+    TbxMbClientStartPolling(clientCtx);
+  }
+} /*** end of TbxMbClientCacheFill ***/
 
 
 /************************************************************************************//**
-** \brief     Send a custom function code PDU to the server and receive its response PDU.
-**            Thanks to this functionality, the user can support Modbus function codes
-**            that are either currently not supported or user defined extensions.
-** \details   The "txPdu" and "rxPdu" parameters are pointers to the byte array of the
-**            PDU. The first byte (i.e. txPdu[0]) contains the function code, followed by
-**            its data bytes. When calling this function, set the "len" parameter to the
-**            length of the "txPdu". This function updates the "len" parameter with the
-**            length of the received PDU, which it stores in "rxPdu".
-** \example   Example of manually sending the "Write Single Register 0x06" function code
-**            to a node with address 10 (0x0A) for setting the holding register at
-**            address 40000 to a value of 127:
-**
-**              uint8_t  requestPdu[TBX_MB_TP_PDU_MAX_LEN];
-**              uint8_t  responsePdu[TBX_MB_TP_PDU_MAX_LEN];
-**              uint8_t  pduLen;
-**              uint16_t holdingRegAddr = 40000U;
-**              uint16_t holdingRegValue = 127U;
-**
-**              requestPdu[0] = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
-**              requestPdu[1] = (uint8_t)(holdingRegAddr >> 8U);
-**              requestPdu[2] = (uint8_t) holdingRegAddr;
-**              requestPdu[3] = (uint8_t)(holdingRegValue >> 8U);
-**              requestPdu[4] = (uint8_t) holdingRegValue;
-**              pduLen = 5U;
-**
-**              TbxMbClientCustomFunction(modbusClient, 0x0A, requestPdu, responsePdu, 
-**                                        &pduLen);
-**
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     txPdu Pointer to a byte array with the PDU to transmit.
-** \param     rxPdu Pointer to a byte array with the received response PDU.
-** \param     len Pointer to the PDU length, including the function code.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Invalidates the read cache entries that a write could affect. Cache
+**            entries of the node, whose range overlaps with the written elements, no
+**            longer serve reads until the next fill.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server. TBX_MB_TP_NODE_ADDR_BROADCAST for all
+**            nodes.
+** \param     code Function code for reading the written elements. Zero to invalidate
+**            all cache entries of the node, for writes with unknown effects.
+** \param     addr Starting element address of the write.
+** \param     num Number of elements of the write.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
-                                   uint8_t              node,
-                                   uint8_t      const * txPdu,
-                                   uint8_t            * rxPdu,
-                                   uint8_t            * len)
+static void TbxMbClientCacheInvalidate(tTbxMbClientCtx * clientCtx,
+                                       uint8_t           node,
+                                       uint8_t           code,
+                                       uint16_t          addr,
+                                       uint16_t          num)
 {
-  uint8_t result = TBX_ERROR;
+  /* Loop through all cache entries. */
+  TbxCriticalSectionEnter();
+  tTbxMbClientCacheEntry * entry = clientCtx->cacheList;
+  while (entry != NULL)
+  {
+    /* Could the write affect the elements of the cache entry? */
+    if (((node == TBX_MB_TP_NODE_ADDR_BROADCAST) || (entry->node == node)) &&
+        ((code == 0U) ||
+         ((entry->code == code) && (((uint32_t)addr + num) > entry->addr) &&
+          (((uint32_t)entry->addr + entry->num) > addr))))
+    {
+      entry->valid = TBX_FALSE;
+      /* Reads that are already in progress should no longer fill the cache. */
+      clientCtx->cacheGen++;
+    }
+    /* Continue with the next cache entry. */
+    entry = entry->next;
+  }
+  TbxCriticalSectionExit();
+} /*** end of TbxMbClientCacheInvalidate ***/
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
-             (rxPdu != NULL) && (len != NULL));
 
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
-      (rxPdu != NULL) && (len != NULL))
-  {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+/************************************************************************************//**
+** \brief     Invalidates the read cache entries whose time to live passed.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     nowMs Current millisecond time of the channel.
+** \return    TBX_TRUE if cache entries still hold read data, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientCacheExpire(tTbxMbClientCtx * clientCtx,
+                                      uint32_t          nowMs)
+{
+  uint8_t result = TBX_FALSE;
 
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet and with a valid packet
-     * length. It should at least have a PDU function code.
-     */
-    if ((txPacket != NULL) && (*len > 0U))
+  /* Loop through all cache entries. */
+  TbxCriticalSectionEnter();
+  tTbxMbClientCacheEntry * entry = clientCtx->cacheList;
+  while (entry != NULL)
+  {
+    if (entry->valid == TBX_TRUE)
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = txPdu[0];
-      txPacket->dataLen = *len - 1U;
-      for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
+      /* Time to live passed? */
+      if ((nowMs - entry->fillMs) >= entry->ttl)
       {
-        txPacket->pdu.data[idx] = txPdu[idx + 1U];
+        entry->valid = TBX_FALSE;
       }
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      else
       {
-        isBroadcast = TBX_TRUE;
+        result = TBX_TRUE;
       }
-      
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+    }
+    /* Continue with the next cache entry. */
+    entry = entry->next;
+  }
+  TbxCriticalSectionExit();
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCacheExpire ***/
 
-      /* Initialize the length of the response PDU to zero. This default indicates that
-       * no response was received. This is the case in the request was a broadcast one or
-       * it the response was not valid. If will be updated later on, if a valid response
-       * was received.
+
+/************************************************************************************//**
+** \brief     Scheduler of the poll groups. It releases the polls of the poll groups that
+**            are due and dispatches the released poll with the earliest deadline, once
+**            the bus is available. A poll group that is still waiting for or busy with
+**            its previous poll upon its next release, overran. The bus could not keep
+**            up.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     nowMs Current millisecond time of the client channel.
+**
+****************************************************************************************/
+static void TbxMbClientGroupsPoll(tTbxMbClientCtx * clientCtx,
+                                  uint32_t          nowMs)
+{
+  tTbxMbClientGroupCtx * nextGroup = NULL;
+
+  /* Loop through all poll groups. */
+  tTbxMbClientGroupCtx * group = clientCtx->groupList;
+  while (group != NULL)
+  {
+    /* Time to release the next poll? The cast detects this correctly, even if the
+     * millisecond time overflowed.
+     */
+    if ((int32_t)(nowMs - group->releaseMs) >= 0)
+    {
+      /* Still waiting for or busy with the previous poll? */
+      if (group->state != TBX_MB_CLIENT_GROUP_STATE_IDLE)
+      {
+        group->overruns++;
+      }
+      /* Release the poll. */
+      else
+      {
+        group->state = TBX_MB_CLIENT_GROUP_STATE_RELEASED;
+      }
+      /* Determine the next release time, which is also the deadline of the released
+       * poll. Releases that were missed entirely, also count as overruns.
        */
-      *len = 0U;
+      uint32_t missed = (nowMs - group->releaseMs) / group->period;
+      group->overruns += missed;
+      group->releaseMs += (missed + 1U) * group->period;
+    }
+    /* Keep track of the released poll with the earliest deadline. For equal deadlines,
+     * the one with the highest priority goes first.
+     */
+    if (group->state == TBX_MB_CLIENT_GROUP_STATE_RELEASED)
+    {
+      if ((nextGroup == NULL) ||
+          ((int32_t)(group->releaseMs - nextGroup->releaseMs) < 0) ||
+          ((group->releaseMs == nextGroup->releaseMs) &&
+           (group->priority > nextGroup->priority)))
+      {
+        nextGroup = group;
+      }
+    }
+    /* Continue with the next poll group. */
+    group = group->next;
+  }
+  /* Only dispatch a poll once the bus is available. Requests are not queued ahead of
+   * time, such that a poll that is released later with an earlier deadline, can still
+   * go first.
+   */
+  if ((nextGroup != NULL) && (clientCtx->syncActive == TBX_FALSE) &&
+      (clientCtx->syncWaiting == 0U) && (clientCtx->reqHead == NULL) &&
+      (clientCtx->reqTransmit == NULL) && (clientCtx->reqSentNum < clientCtx->reqWindow))
+  {
+    /* Read the elements into the receive buffer of the poll group. */
+    if (TbxMbClientReadAsync(clientCtx, nextGroup->node, nextGroup->code,
+                             nextGroup->addr, nextGroup->num, nextGroup->rxValues,
+                             TbxMbClientGroupDone, nextGroup) == TBX_OK)
+    {
+      nextGroup->state = TBX_MB_CLIENT_GROUP_STATE_BUSY;
+    }
+  }
+} /*** end of TbxMbClientGroupsPoll ***/
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
+
+/************************************************************************************//**
+** \brief     Completion callback of the read request of a poll group. It updates the
+**            value image of the poll group upon success.
+** \param     channel Handle to the Modbus client channel.
+** \param     result TBX_OK if the read request was successful, TBX_ERROR otherwise.
+** \param     context Pointer to the poll group context.
+**
+****************************************************************************************/
+static void TbxMbClientGroupDone(tTbxMbClient   channel,
+                                 uint8_t        result,
+                                 void         * context)
+{
+  tTbxMbClientCtx      * clientCtx = (tTbxMbClientCtx *)channel;
+  tTbxMbClientGroupCtx * group = (tTbxMbClientGroupCtx *)context;
+
+  /* Update the value image if the read was successful. */
+  if (result == TBX_OK)
+  {
+    /* Determine the size of the value image in bytes. */
+    uint16_t size = group->num;
+    if ((group->code == TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
+        (group->code == TBX_MB_FC04_READ_INPUT_REGISTERS))
+    {
+      size *= 2U;
+    }
+    uint8_t const * src = (uint8_t const *)group->rxValues;
+    uint8_t       * dst = (uint8_t *)group->values;
+    /* Copy the read values to the value image and timestamp it. */
+    TbxCriticalSectionEnter();
+    for (uint16_t idx = 0U; idx < size; idx++)
+    {
+      dst[idx] = src[idx];
+    }
+    group->updateMs = clientCtx->timeMs;
+    group->valid = TBX_TRUE;
+    TbxCriticalSectionExit();
+  }
+  /* Ready for the next release. */
+  group->state = TBX_MB_CLIENT_GROUP_STATE_IDLE;
+} /*** end of TbxMbClientGroupDone ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates a new asynchronous request and initializes its common members.
+** \param     node The address of the server.
+** \param     code Function code of the request.
+** \param     doneFcn Completion callback function (optional).
+** \param     context Parameter to pass on to the completion callback function.
+** \return    Pointer to the new request if successful, NULL otherwise.
+**
+****************************************************************************************/
+static tTbxMbClientReq * TbxMbClientReqCreate(uint8_t                      node,
+                                              uint8_t                      code,
+                                              tTbxMbClientDone             doneFcn,
+                                              void                       * context)
+{
+  /* Allocate memory for the new request. */
+  tTbxMbClientReq * result = TbxMemPoolAllocate(sizeof(tTbxMbClientReq));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (result == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientReq));
+    result = TbxMemPoolAllocate(sizeof(tTbxMbClientReq));
+  }
+  /* Initialize the request, if the memory allocation succeeded. */
+  if (result != NULL)
+  {
+    result->node = node;
+    result->dataLen = 0U;
+    result->pdu.code = code;
+    result->num = 0U;
+    result->values = NULL;
+    result->rawLen = NULL;
+    result->doneFcn = doneFcn;
+    result->doneContext = context;
+    result->transId = 0U;
+    result->state = TBX_MB_CLIENT_REQ_STATE_START;
+    result->startMs = 0U;
+    result->cacheGen = 0U;
+    result->members = NULL;
+    result->next = NULL;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Adds the request at the end of the request queue of the client channel.
+**            The event task takes care of its further processing.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     req Pointer to the request.
+**
+****************************************************************************************/
+static void TbxMbClientReqSubmit(tTbxMbClientCtx * clientCtx,
+                                 tTbxMbClientReq * req)
+{
+  /* Add the request to the queue. Also note the cache generation, such that a write
+   * that invalidates cache entries in the meantime, prevents the response to a read
+   * from filling the cache.
+   */
+  TbxCriticalSectionEnter();
+  req->cacheGen = clientCtx->cacheGen;
+  if (clientCtx->reqTail == NULL)
+  {
+    clientCtx->reqHead = req;
+  }
+  else
+  {
+    clientCtx->reqTail->next = req;
+  }
+  clientCtx->reqTail = req;
+  TbxCriticalSectionExit();
+  /* Polling is needed to process the request. */
+  TbxMbClientStartPolling(clientCtx);
+} /*** end of TbxMbClientReqSubmit ***/
+
+
+/************************************************************************************//**
+** \brief     Instructs the event task to call the polling function of the client
+**            channel, if not already done so.
+** \param     clientCtx Pointer to the Modbus client channel context.
+**
+****************************************************************************************/
+static void TbxMbClientStartPolling(tTbxMbClientCtx * clientCtx)
+{
+  uint8_t startPolling = TBX_FALSE;
+
+  /* Check if polling is already active. */
+  TbxCriticalSectionEnter();
+  if (clientCtx->reqPolling == TBX_FALSE)
+  {
+    clientCtx->reqPolling = TBX_TRUE;
+    startPolling = TBX_TRUE;
+  }
+  TbxCriticalSectionExit();
+  /* Instruct the event task to call our polling function. */
+  if (startPolling == TBX_TRUE)
+  {
+    tTbxMbEvent newEvent;
+    newEvent.context = clientCtx;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+} /*** end of TbxMbClientStartPolling ***/
+
+
+/************************************************************************************//**
+** \brief     Cancels the asynchronous request that was submitted with the specified
+**            callback parameter. The request still runs its course, but without storing
+**            read values and without calling its completion callback.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     context Parameter of the completion callback of the request.
+**
+****************************************************************************************/
+static void TbxMbClientReqCancel(tTbxMbClientCtx       * clientCtx,
+                                 void            const * context)
+{
+  tTbxMbClientReq * reqLists[3];
+
+  /* Collect the queued, transmitting and sent requests. */
+  TbxCriticalSectionEnter();
+  reqLists[0] = clientCtx->reqHead;
+  reqLists[1] = clientCtx->reqTransmit;
+  reqLists[2] = clientCtx->reqSent;
+  /* Search all requests for the one with the callback parameter. */
+  for (uint8_t listIdx = 0U; listIdx < 3U; listIdx++)
+  {
+    tTbxMbClientReq * req = reqLists[listIdx];
+    while (req != NULL)
+    {
+      if (req->doneContext == context)
+      {
+        req->doneFcn = NULL;
+        req->values = NULL;
+      }
+      /* Also search the requests covered by a coalesced read request. */
+      tTbxMbClientReq * member = req->members;
+      while (member != NULL)
+      {
+        if (member->doneContext == context)
+        {
+          member->doneFcn = NULL;
+          member->values = NULL;
+        }
+        member = member->next;
+      }
+      /* Continue with the next request in the list. */
+      req = req->next;
+    }
+  }
+  TbxCriticalSectionExit();
+} /*** end of TbxMbClientReqCancel ***/
+
+
+/************************************************************************************//**
+** \brief     Merges a read request with queued read requests from the same node, with
+**            the same function code, for elements within the gap tolerance of the ones
+**            it already covers. A single coalesced read request then covers all of
+**            them, within the limits of a PDU. The scan stops at the first queued write
+**            request to the same node. This makes sure a read never passes a write.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     req Pointer to the read request that was just taken from the queue.
+** \return    Pointer to the coalesced read request, if merging took place. The read
+**            request itself otherwise.
+**
+****************************************************************************************/
+static tTbxMbClientReq * TbxMbClientReqCoalesce(tTbxMbClientCtx * clientCtx,
+                                                tTbxMbClientReq * req)
+{
+  tTbxMbClientReq * result = req;
+
+  /* Only unicast read requests can be merged. Not custom function code requests. */
+  if ((req->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS) && (req->rawLen == NULL) &&
+      (req->node != TBX_MB_TP_NODE_ADDR_BROADCAST))
+  {
+    /* Determine the maximum number of elements that a single request can read. */
+    uint32_t numMax = (req->pdu.code <= TBX_MB_FC02_READ_DISCRETE_INPUTS) ? 2000U : 125U;
+    /* Range with the elements covered so far. The last one is exclusive. */
+    uint32_t first = TbxMbCommonExtractUInt16BE(&req->pdu.data[0]);
+    uint32_t last = first + req->num;
+    uint32_t gap = clientCtx->coalesceGap;
+    tTbxMbClientReq * lastMember = req;
+    uint8_t           merged = TBX_TRUE;
+    /* Keep scanning the queue as long as requests get merged. Each merge extends the
+     * range, which might bring other requests within the gap tolerance.
+     */
+    while (merged == TBX_TRUE)
+    {
+      tTbxMbClientReq * prevReq = NULL;
+      tTbxMbClientReq * queuedReq = clientCtx->reqHead;
+      uint8_t           scanDone = TBX_FALSE;
+      merged = TBX_FALSE;
+      /* Loop through the queued requests. Only the application adds requests to the
+       * queue, always at the end, so the queue can be scanned without a critical
+       * section.
        */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      while ((queuedReq != NULL) && (scanDone == TBX_FALSE))
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        uint8_t mergeIt = TBX_FALSE;
+        /* Only requests for the same node are of interest. */
+        if (queuedReq->node == req->node)
         {
-          /* Check that the response came from the expected node. */
-          if (rxPacket->node != node)
+          /* Reads must not pass a write or a custom function code request. */
+          if ((queuedReq->pdu.code > TBX_MB_FC04_READ_INPUT_REGISTERS) ||
+              (queuedReq->rawLen != NULL))
           {
-            result = TBX_ERROR;
+            scanDone = TBX_TRUE;
           }
-          /* Response content valid. Copy its data. */
-          else
+          /* Read request with the same function code? */
+          else if (queuedReq->pdu.code == req->pdu.code)
           {
-            /* Set the length, including the function code. */
-            *len = rxPacket->dataLen + 1U;
-            /* Set the function code. */
-            rxPdu[0] = rxPacket->pdu.code;
-            /* Copy the packet data. */
-            for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+            uint32_t queuedFirst = TbxMbCommonExtractUInt16BE(&queuedReq->pdu.data[0]);
+            uint32_t queuedLast = queuedFirst + queuedReq->num;
+            uint32_t newFirst = (queuedFirst < first) ? queuedFirst : first;
+            uint32_t newLast = (queuedLast > last) ? queuedLast : last;
+            /* Merge it, if it lies within the gap tolerance and if the PDU limits are
+             * not exceeded.
+             */
+            if ((queuedFirst <= (last + gap)) && ((queuedLast + gap) >= first) &&
+                ((newLast - newFirst) <= numMax))
             {
-              rxPdu[idx + 1U] = rxPacket->pdu.data[idx];
+              first = newFirst;
+              last = newLast;
+              mergeIt = TBX_TRUE;
             }
           }
+          else
+          {
+            /* Nothing left to do, but MISRA requires this terminating else statement. */
+          }
+        }
+        /* Allocate the coalesced read request upon the first merge. */
+        if ((mergeIt == TBX_TRUE) && (result == req))
+        {
+          result = TbxMbClientReqCreate(req->node, req->pdu.code, NULL, NULL);
+          /* Just transmit the read request as is, if the allocation failed. */
+          if (result == NULL)
+          {
+            result = req;
+            mergeIt = TBX_FALSE;
+            merged = TBX_FALSE;
+            scanDone = TBX_TRUE;
+          }
+          /* The read request is the first one that it covers. */
+          else
+          {
+            result->members = req;
+            req->next = NULL;
+          }
+        }
+        /* Should the queued request be merged? */
+        if (mergeIt == TBX_TRUE)
+        {
+          tTbxMbClientReq * nextReq;
+          /* Remove it from the queue. */
+          TbxCriticalSectionEnter();
+          nextReq = queuedReq->next;
+          if (prevReq == NULL)
+          {
+            clientCtx->reqHead = nextReq;
+          }
+          else
+          {
+            prevReq->next = nextReq;
+          }
+          if (clientCtx->reqTail == queuedReq)
+          {
+            clientCtx->reqTail = prevReq;
+          }
+          TbxCriticalSectionExit();
+          /* Add it to the requests covered by the coalesced read request. */
+          queuedReq->next = NULL;
+          lastMember->next = queuedReq;
+          lastMember = queuedReq;
+          merged = TBX_TRUE;
+          /* Continue with the next queued request. */
+          queuedReq = nextReq;
         }
-        /* Could not access the response packet. */
         else
         {
-          result = TBX_ERROR;
+          /* Continue with the next queued request. */
+          prevReq = queuedReq;
+          queuedReq = queuedReq->next;
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
+      }
+    }
+    /* Prepare the PDU of the coalesced read request, if merging took place. */
+    if (result != req)
+    {
+      result->num = (uint16_t)(last - first);
+      result->dataLen = 4U;
+      result->cacheGen = req->cacheGen;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE((uint16_t)first, &result->pdu.data[0]);
+      /* Number of elements. */
+      TbxMbCommonStoreUInt16BE(result->num, &result->pdu.data[2]);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqCoalesce ***/
+
+
+/************************************************************************************//**
+** \brief     Completes an asynchronous request. It releases the request and reports the
+**            result to the application. The request must no longer be linked to the
+**            client channel.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     req Pointer to the request.
+** \param     result TBX_OK if the request was successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static void TbxMbClientReqComplete(tTbxMbClientCtx * clientCtx,
+                                   tTbxMbClientReq * req,
+                                   uint8_t           result)
+{
+  /* Store the callback info, because the request is released before the callback is
+   * called. This way the callback can already reuse it for a new request.
+   */
+  tTbxMbClientDone   doneFcn = req->doneFcn;
+  void             * context = req->doneContext;
+  tTbxMbClientReq  * member = req->members;
+
+  /* Give the request back to the memory pool. */
+  TbxMemPoolRelease(req);
+  /* Complete the requests covered by a coalesced read request, in the order that they
+   * were merged.
+   */
+  while (member != NULL)
+  {
+    tTbxMbClientReq * nextMember = member->next;
+    TbxMbClientReqComplete(clientCtx, member, result);
+    member = nextMember;
+  }
+  /* Report the result to the application. */
+  if (doneFcn != NULL)
+  {
+    doneFcn(clientCtx, result, context);
+  }
+} /*** end of TbxMbClientReqComplete ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a linked list of requests, without completing them.
+** \param     req Pointer to the first request in the list (can be NULL).
+**
+****************************************************************************************/
+static void TbxMbClientReqRelease(tTbxMbClientReq * req)
+{
+  /* Loop through all requests in the list. */
+  while (req != NULL)
+  {
+    tTbxMbClientReq * nextReq = req->next;
+    /* Release the requests covered by a coalesced read request. */
+    TbxMbClientReqRelease(req->members);
+    /* Give the request back to the memory pool. */
+    TbxMemPoolRelease(req);
+    /* Continue with the next request. */
+    req = nextReq;
+  }
+} /*** end of TbxMbClientReqRelease ***/
+
+
+/************************************************************************************//**
+** \brief     Removes a request from the list with requests that await a response.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     req Pointer to the request.
+**
+****************************************************************************************/
+static void TbxMbClientReqUnlink(tTbxMbClientCtx * clientCtx,
+                                 tTbxMbClientReq * req)
+{
+  /* Is it the first request in the list? */
+  if (clientCtx->reqSent == req)
+  {
+    clientCtx->reqSent = req->next;
+    clientCtx->reqSentNum--;
+  }
+  /* Search the request that comes before it. */
+  else
+  {
+    tTbxMbClientReq * prevReq = clientCtx->reqSent;
+    while ((prevReq != NULL) && (prevReq->next != req))
+    {
+      prevReq = prevReq->next;
+    }
+    /* Unlink the request, if found. */
+    if (prevReq != NULL)
+    {
+      prevReq->next = req->next;
+      clientCtx->reqSentNum--;
+    }
+  }
+  req->next = NULL;
+} /*** end of TbxMbClientReqUnlink ***/
+
+
+/************************************************************************************//**
+** \brief     Validates the response to an asynchronous request and stores the values of
+**            a read request. For a coalesced read request, the values are split back to
+**            the requests that it covers. A custom function code request stores the
+**            response PDU itself.
+** \param     req Pointer to the request.
+** \param     rxPacket Pointer to the response packet.
+** \return    TBX_OK if the response is valid, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqResponse(tTbxMbClientReq const * req,
+                                      tTbxMbTpPacket  const * rxPacket)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Custom function code request? Its response is passed on as is, so it can also be an
+   * exception response.
+   */
+  if (req->rawLen != NULL)
+  {
+    /* Check that the response came from the expected node and that it's a response to
+     * the same function code.
+     */
+    if ((rxPacket->node == req->node) &&
+        ((rxPacket->pdu.code == req->pdu.code) ||
+         (rxPacket->pdu.code == (req->pdu.code | TBX_MB_FC_EXCEPTION_MASK))))
+    {
+      /* Store the response PDU, if the request was not cancelled. */
+      if (req->values != NULL)
+      {
+        uint8_t * rxPdu = (uint8_t *)req->values;
+        rxPdu[0] = rxPacket->pdu.code;
+        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+        {
+          rxPdu[idx + 1U] = rxPacket->pdu.data[idx];
+        }
+        *req->rawLen = rxPacket->dataLen + 1U;
+      }
+      result = TBX_OK;
+    }
+  }
+  /* Check that the response came from the expected node and that it's a response with
+   * the same function code (not an exception response).
+   */
+  else if ((rxPacket->node == req->node) && (rxPacket->pdu.code == req->pdu.code))
+  {
+    uint8_t byteCount = rxPacket->pdu.data[0];
+    /* Filter on the function code. */
+    switch (req->pdu.code)
+    {
+      case TBX_MB_FC01_READ_COILS:
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+      {
+        /* Determine the number of bytes needed to hold all the bits. The cast to U8
+         * is okay, because we know that num is <= 2000.
          */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        uint8_t numBytes = (uint8_t)((req->num + 7U) / 8U);
+        /* Check that the data length and the byte count are as expected. */
+        if ((byteCount == numBytes) && (rxPacket->dataLen == (byteCount + 1U)))
+        {
+          result = TBX_OK;
+        }
+      }
+      break;
+
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
+      {
+        /* Check that the data length and the byte count are as expected. */
+        if ((byteCount == (req->num * 2U)) && (rxPacket->dataLen == (byteCount + 1U)))
+        {
+          result = TBX_OK;
+        }
+      }
+      break;
+
+      default:
+      {
+        /* The response to a write request echoes the address and the value or quantity
+         * of the request.
+         */
+        if ((rxPacket->dataLen == 4U) &&
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) ==
+             TbxMbCommonExtractUInt16BE(&req->pdu.data[0])) &&
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) ==
+             TbxMbCommonExtractUInt16BE(&req->pdu.data[2])))
+        {
+          result = TBX_OK;
+        }
+      }
+      break;
+    }
+    /* Store the read values, if the response is valid. */
+    if ((result == TBX_OK) && (req->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS))
+    {
+      /* Regular read request? */
+      if (req->members == NULL)
+      {
+        TbxMbClientReqStore(req, rxPacket, 0U);
+      }
+      /* Coalesced read request. Each request it covers, gets its part of the values. */
+      else
+      {
+        uint16_t                addr = TbxMbCommonExtractUInt16BE(&req->pdu.data[0]);
+        tTbxMbClientReq const * member = req->members;
+        while (member != NULL)
+        {
+          uint16_t memberAddr = TbxMbCommonExtractUInt16BE(&member->pdu.data[0]);
+          TbxMbClientReqStore(member, rxPacket, memberAddr - addr);
+          member = member->next;
+        }
       }
     }
   }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientCustomFunction ***/
+} /*** end of TbxMbClientReqResponse ***/
+
+
+/************************************************************************************//**
+** \brief     Stores the values of a read request from its already validated response.
+** \param     req Pointer to the read request.
+** \param     rxPacket Pointer to the response packet.
+** \param     offset Offset of the request's first element in the response.
+**
+****************************************************************************************/
+static void TbxMbClientReqStore(tTbxMbClientReq const * req,
+                                tTbxMbTpPacket  const * rxPacket,
+                                uint16_t                offset)
+{
+  /* Only store the values, if the request was not cancelled. */
+  if (req->values != NULL)
+  {
+    /* Reading bits? */
+    if (req->pdu.code <= TBX_MB_FC02_READ_DISCRETE_INPUTS)
+    {
+      uint8_t const * bitData = &rxPacket->pdu.data[1];
+      uint8_t       * bits = (uint8_t *)req->values;
+      /* Extract and store the state of all the bits. */
+      for (uint16_t idx = 0U; idx < req->num; idx++)
+      {
+        uint16_t bitIdx = offset + idx;
+        if ((bitData[bitIdx / 8U] & (1U << (bitIdx % 8U))) != 0U)
+        {
+          bits[idx] = TBX_ON;
+        }
+        else
+        {
+          bits[idx] = TBX_OFF;
+        }
+      }
+    }
+    /* Reading registers. */
+    else
+    {
+      uint8_t const * regData = &rxPacket->pdu.data[1U + (offset * 2U)];
+      uint16_t      * regs = (uint16_t *)req->values;
+      /* Extract and store the register values. */
+      for (uint16_t idx = 0U; idx < req->num; idx++)
+      {
+        regs[idx] = TbxMbCommonExtractUInt16BE(&regData[idx * 2U]);
+      }
+    }
+  }
+} /*** end of TbxMbClientReqStore ***/
+
+
+/************************************************************************************//**
+** \brief     Queues an asynchronous read request for coils, discrete inputs, input
+**            registers or holding registers.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \param     code Function code of the read request.
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of elements to read. The caller already validated it.
+** \param     values Pointer to the array where the read values will be written to.
+** \param     doneFcn Completion callback function (optional).
+** \param     context Parameter to pass on to the completion callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReadAsync(tTbxMbClient       channel,
+                                    uint8_t            node,
+                                    uint8_t            code,
+                                    uint16_t           addr,
+                                    uint16_t           num,
+                                    void             * values,
+                                    tTbxMbClientDone   doneFcn,
+                                    void             * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Convert the client channel pointer to the context structure. */
+  tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+  /* Sanity check on the context type. */
+  TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+  /* Create the new request. */
+  tTbxMbClientReq * req = TbxMbClientReqCreate(node, code, doneFcn, context);
+  /* Only continue if the request could be created. */
+  if (req != NULL)
+  {
+    /* Prepare the request PDU. */
+    req->dataLen = 4U;
+    /* Starting address. */
+    TbxMbCommonStoreUInt16BE(addr, &req->pdu.data[0]);
+    /* Number of elements. */
+    TbxMbCommonStoreUInt16BE(num, &req->pdu.data[2]);
+    /* Store where to write the read values to. */
+    req->num = num;
+    req->values = values;
+    /* Queue the request. */
+    TbxMbClientReqSubmit(clientCtx, req);
+    /* Update the result. */
+    result = TBX_OK;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Validates the file record blocks of a read or write file records request.
+** \param     records Pointer to array with the file record blocks.
+** \param     num Number of file record blocks in the array.
+** \return    TBX_OK if all file record blocks are valid, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientFileRecordsCheck(tTbxMbClientFileRecord const * records,
+                                           uint8_t                        num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(records != NULL);
+
+  /* Only continue with valid parameters. */
+  if (records != NULL)
+  {
+    /* Assume all blocks are valid until proven otherwise. */
+    result = TBX_OK;
+    /* Loop through all the blocks. */
+    for (uint8_t idx = 0U; idx < num; idx++)
+    {
+      tTbxMbClientFileRecord const * record = &records[idx];
+      /* Check the file number and that all registers of the block are within the valid
+       * record number range. A block with registers also needs data storage.
+       */
+      if ((record->fileNum < TBX_MB_FILE_NUM_MIN) ||
+          (record->recordNum > TBX_MB_FILE_RECORD_NUM_MAX) ||
+          (((uint32_t)record->recordNum + record->recordLen) > 
+           (TBX_MB_FILE_RECORD_NUM_MAX + 1UL)) ||
+          ((record->recordLen > 0U) && (record->data == NULL)))
+      {
+        /* Flag the error and stop looping. */
+        result = TBX_ERROR;
+        break;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientFileRecordsCheck ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the maximum number of elements that a single request with the
+**            specified function code can transfer.
+** \param     code Function code of the request.
+** \return    Maximum number of elements.
+**
+****************************************************************************************/
+static uint16_t TbxMbClientRangeChunkMax(uint8_t code)
+{
+  uint16_t result;
+
+  /* Filter on the function code. */
+  switch (code)
+  {
+    case TBX_MB_FC01_READ_COILS:
+    case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+    {
+      result = 2000U;
+    }
+    break;
+
+    case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+    case TBX_MB_FC04_READ_INPUT_REGISTERS:
+    {
+      result = 125U;
+    }
+    break;
+
+    case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+    {
+      result = 1968U;
+    }
+    break;
+
+    default:
+    {
+      result = 123U;
+    }
+    break;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRangeChunkMax ***/
+
+
+/************************************************************************************//**
+** \brief     Transfers a range of elements with blocking requests. The range is split
+**            into chunks with the maximum number of elements that a single request can
+**            transfer. The chunks are transferred one after the other, until all are
+**            done or until one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \param     code Function code of the requests.
+** \param     addr Starting element address in the Modbus data table. The caller already
+**            validated that the range fits in the data table.
+** \param     num Number of elements of the range.
+** \param     values Pointer to the array where the read values will be written to. Only
+**            used for a read operation.
+** \param     writeValues Pointer to the array with the values to write. Only used for a
+**            write operation.
+** \param     numDone Pointer to where the number of transferred elements, counting from
+**            the start of the range, is written to (optional).
+** \return    TBX_OK if all elements were transferred, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientRange(tTbxMbClient         channel,
+                                uint8_t              node,
+                                uint8_t              code,
+                                uint16_t             addr,
+                                uint32_t             num,
+                                void               * values,
+                                void         const * writeValues,
+                                uint32_t           * numDone)
+{
+  uint8_t  result   = TBX_OK;
+  uint32_t offset   = 0U;
+  uint16_t chunkMax = TbxMbClientRangeChunkMax(code);
+
+  /* Transfer the chunks one after the other, until done or until a chunk failed. */
+  while ((offset < num) && (result == TBX_OK))
+  {
+    /* Determine the number of elements of this chunk. */
+    uint16_t chunkNum = chunkMax;
+    if ((num - offset) < chunkMax)
+    {
+      chunkNum = (uint16_t)(num - offset);
+    }
+    /* Determine the address of the chunk's first element. The cast is okay, because the
+     * caller verified that the range fits in the data table.
+     */
+    uint16_t chunkAddr = (uint16_t)(addr + offset);
+    /* Transfer the chunk. The U8 casts are okay, because the number of registers of a
+     * chunk is <= 125.
+     */
+    switch (code)
+    {
+      case TBX_MB_FC01_READ_COILS:
+      {
+        result = TbxMbClientReadCoils(channel, node, chunkAddr, chunkNum,
+                                      &((uint8_t *)values)[offset]);
+      }
+      break;
+
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+      {
+        result = TbxMbClientReadInputs(channel, node, chunkAddr, chunkNum,
+                                       &((uint8_t *)values)[offset]);
+      }
+      break;
+
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+      {
+        result = TbxMbClientReadHoldingRegs(channel, node, chunkAddr, (uint8_t)chunkNum,
+                                            &((uint16_t *)values)[offset]);
+      }
+      break;
+
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
+      {
+        result = TbxMbClientReadInputRegs(channel, node, chunkAddr, (uint8_t)chunkNum,
+                                          &((uint16_t *)values)[offset]);
+      }
+      break;
+
+      case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+      {
+        result = TbxMbClientWriteCoils(channel, node, chunkAddr, chunkNum,
+                                       &((uint8_t const *)writeValues)[offset]);
+      }
+      break;
+
+      default:
+      {
+        result = TbxMbClientWriteHoldingRegs(channel, node, chunkAddr, (uint8_t)chunkNum,
+                                             &((uint16_t const *)writeValues)[offset]);
+      }
+      break;
+    }
+    /* Count the elements of the chunk as transferred, if it succeeded. */
+    if (result == TBX_OK)
+    {
+      offset += chunkNum;
+    }
+  }
+  /* Report the number of transferred elements, if requested. */
+  if (numDone != NULL)
+  {
+    *numDone = offset;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRange ***/
+
+
+/************************************************************************************//**
+** \brief     Transfers a range of elements with asynchronous requests. The range is
+**            split into chunks with the maximum number of elements that a single request
+**            can transfer. All chunks are queued at once. This way the chunks are
+**            pipelined, if the window of the channel allows multiple requests to await a
+**            response. Once a chunk fails, the chunks that are still queued are
+**            cancelled. Only the chunks that were already in progress still go ahead.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \param     code Function code of the requests.
+** \param     addr Starting element address in the Modbus data table. The caller already
+**            validated that the range fits in the data table.
+** \param     num Number of elements of the range.
+** \param     values Pointer to the array where the read values will be written to. Only
+**            used for a read operation.
+** \param     writeValues Pointer to the array with the values to write. Only used for a
+**            write operation.
+** \param     doneFcn Completion callback function (optional).
+** \param     context Parameter to pass on to the completion callback function.
+** \return    TBX_OK if the chunks were queued, TBX_ERROR otherwise. Note that TBX_OK is
+**            also returned if just the first part of the chunks could be queued. The
+**            completion callback then reports the failure.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientRangeAsync(tTbxMbClient            channel,
+                                     uint8_t                 node,
+                                     uint8_t                 code,
+                                     uint16_t                addr,
+                                     uint32_t                num,
+                                     void                  * values,
+                                     void            const * writeValues,
+                                     tTbxMbClientRangeDone   doneFcn,
+                                     void                  * context)
+{
+  uint8_t  result   = TBX_ERROR;
+  uint16_t chunkMax = TbxMbClientRangeChunkMax(code);
+
+  /* Allocate memory for the range request. */
+  tTbxMbClientRangeCtx * rangeCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientRangeCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (rangeCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientRangeCtx));
+    rangeCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientRangeCtx));
+  }
+  /* Only continue if the memory allocation succeeded. */
+  if (rangeCtx != NULL)
+  {
+    uint32_t offset = 0U;
+    uint16_t chunksQueued = 0U;
+    /* Determine the total number of chunks. */
+    uint16_t chunksTotal = (uint16_t)((num + chunkMax - 1U) / chunkMax);
+    /* Initialize the range request. All chunks count as not yet completed, such that
+     * a chunk that completes while others are still being queued, cannot complete the
+     * range request too early.
+     */
+    rangeCtx->doneFcn = doneFcn;
+    rangeCtx->doneContext = context;
+    rangeCtx->num = num;
+    rangeCtx->numDone = num;
+    rangeCtx->chunksLeft = chunksTotal;
+    /* Queue the chunks, until done or until a chunk could not be queued. Also stop
+     * once a chunk that was already queued failed, in which case the number of
+     * transferred elements was lowered.
+     */
+    result = TBX_OK;
+    while ((offset < num) && (result == TBX_OK) && (rangeCtx->numDone == num))
+    {
+      /* Determine the number of elements of this chunk. */
+      uint16_t chunkNum = chunkMax;
+      if ((num - offset) < chunkMax)
+      {
+        chunkNum = (uint16_t)(num - offset);
+      }
+      /* Determine the address of the chunk's first element. The cast is okay, because
+       * the caller verified that the range fits in the data table.
+       */
+      uint16_t chunkAddr = (uint16_t)(addr + offset);
+      /* Allocate memory for the chunk. */
+      tTbxMbClientRangeChunk * chunk;
+      chunk = TbxMemPoolAllocate(sizeof(tTbxMbClientRangeChunk));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (chunk == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientRangeChunk));
+        chunk = TbxMemPoolAllocate(sizeof(tTbxMbClientRangeChunk));
+      }
+      /* Flag the error if the memory allocation failed. */
+      if (chunk == NULL)
+      {
+        result = TBX_ERROR;
+      }
+      /* Queue the chunk. The U8 casts are okay, because the number of registers of a
+       * chunk is <= 125.
+       */
+      else
+      {
+        chunk->rangeCtx = rangeCtx;
+        chunk->offset = offset;
+        switch (code)
+        {
+          case TBX_MB_FC01_READ_COILS:
+          {
+            result = TbxMbClientReadCoilsAsync(channel, node, chunkAddr, chunkNum,
+                                               &((uint8_t *)values)[offset],
+                                               TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+
+          case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+          {
+            result = TbxMbClientReadInputsAsync(channel, node, chunkAddr, chunkNum,
+                                                &((uint8_t *)values)[offset],
+                                                TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+
+          case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+          {
+            result = TbxMbClientReadHoldingRegsAsync(channel, node, chunkAddr,
+                                                     (uint8_t)chunkNum,
+                                                     &((uint16_t *)values)[offset],
+                                                     TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+
+          case TBX_MB_FC04_READ_INPUT_REGISTERS:
+          {
+            result = TbxMbClientReadInputRegsAsync(channel, node, chunkAddr,
+                                                   (uint8_t)chunkNum,
+                                                   &((uint16_t *)values)[offset],
+                                                   TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+
+          case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+          {
+            result = TbxMbClientWriteCoilsAsync(channel, node, chunkAddr, chunkNum,
+                                                &((uint8_t const *)writeValues)[offset],
+                                                TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+
+          default:
+          {
+            uint16_t const * chunkValues = &((uint16_t const *)writeValues)[offset];
+            result = TbxMbClientWriteHoldingRegsAsync(channel, node, chunkAddr,
+                                                      (uint8_t)chunkNum, chunkValues,
+                                                      TbxMbClientRangeChunkDone, chunk);
+          }
+          break;
+        }
+        /* Continue with the next chunk, if this one was queued. */
+        if (result == TBX_OK)
+        {
+          chunksQueued++;
+          offset += chunkNum;
+        }
+        /* Release the chunk again, if it could not be queued. */
+        else
+        {
+          TbxMemPoolRelease(chunk);
+        }
+      }
+    }
+    /* Could none of the chunks be queued? */
+    if (chunksQueued == 0U)
+    {
+      /* Release the range request again. */
+      TbxMemPoolRelease(rangeCtx);
+    }
+    /* Could just the first part of the chunks be queued? */
+    else if (chunksQueued < chunksTotal)
+    {
+      uint8_t rangeDone;
+      /* The chunks that were not queued, no longer need to complete. Their elements
+       * were not transferred.
+       */
+      TbxCriticalSectionEnter();
+      rangeCtx->chunksLeft -= (uint16_t)(chunksTotal - chunksQueued);
+      if (offset < rangeCtx->numDone)
+      {
+        rangeCtx->numDone = offset;
+      }
+      rangeDone = (rangeCtx->chunksLeft == 0U) ? TBX_TRUE : TBX_FALSE;
+      TbxCriticalSectionExit();
+      /* Complete the range request, if all its queued chunks already completed. */
+      if (rangeDone == TBX_TRUE)
+      {
+        TbxMbClientRangeComplete(channel, rangeCtx);
+      }
+      /* The completion callback reports the failure. */
+      result = TBX_OK;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Completion callback of a chunk of an asynchronous range request. It
+**            completes the range request, once all its chunks completed.
+** \param     channel Handle to the Modbus client channel object.
+** \param     result TBX_OK if the chunk was transferred, TBX_ERROR otherwise.
+** \param     context Pointer to the chunk.
+**
+****************************************************************************************/
+static void TbxMbClientRangeChunkDone(tTbxMbClient   channel,
+                                      uint8_t        result,
+                                      void         * context)
+{
+  tTbxMbClientRangeChunk * chunk = (tTbxMbClientRangeChunk *)context;
+  tTbxMbClientRangeCtx   * rangeCtx = chunk->rangeCtx;
+  uint16_t                 chunksCancelled = 0U;
+  uint8_t                  rangeDone;
+
+  /* Account for the failure of the chunk. Chunks can complete in a different order
+   * than they were queued. The elements from the first failed chunk onwards count as
+   * not transferred.
+   */
+  if (result != TBX_OK)
+  {
+    TbxCriticalSectionEnter();
+    if (chunk->offset < rangeCtx->numDone)
+    {
+      rangeCtx->numDone = chunk->offset;
+    }
+    TbxCriticalSectionExit();
+    /* Cancel the chunks that are still queued. This prevents them from transferring
+     * elements that no longer count as transferred.
+     */
+    chunksCancelled = TbxMbClientRangeCancel((tTbxMbClientCtx *)channel, rangeCtx);
+  }
+  /* Account for the completion of the chunk and the cancelled ones. */
+  TbxCriticalSectionEnter();
+  rangeCtx->chunksLeft -= (uint16_t)(chunksCancelled + 1U);
+  rangeDone = (rangeCtx->chunksLeft == 0U) ? TBX_TRUE : TBX_FALSE;
+  TbxCriticalSectionExit();
+  /* Release the chunk. */
+  TbxMemPoolRelease(chunk);
+  /* Complete the range request, if this was its last chunk. */
+  if (rangeDone == TBX_TRUE)
+  {
+    TbxMbClientRangeComplete(channel, rangeCtx);
+  }
+} /*** end of TbxMbClientRangeChunkDone ***/
+
+
+/************************************************************************************//**
+** \brief     Completes an asynchronous range request. It reports the outcome to the
+**            application and releases the range request.
+** \param     channel Handle to the Modbus client channel object.
+** \param     rangeCtx Pointer to the range request.
+**
+****************************************************************************************/
+static void TbxMbClientRangeComplete(tTbxMbClient           channel,
+                                     tTbxMbClientRangeCtx * rangeCtx)
+{
+  /* Store the completion info, because the range request is released first. This
+   * makes its memory available to a new range request from the callback.
+   */
+  tTbxMbClientRangeDone   doneFcn = rangeCtx->doneFcn;
+  void                  * doneContext = rangeCtx->doneContext;
+  uint32_t                numDone = rangeCtx->numDone;
+  uint8_t                 result = (numDone == rangeCtx->num) ? TBX_OK : TBX_ERROR;
+
+  /* Release the range request. */
+  TbxMemPoolRelease(rangeCtx);
+  /* Report the outcome to the application, if it is interested. */
+  if (doneFcn != NULL)
+  {
+    doneFcn(channel, result, numDone, doneContext);
+  }
+} /*** end of TbxMbClientRangeComplete ***/
+
+
+/************************************************************************************//**
+** \brief     Cancels the chunks of an asynchronous range request that are still queued.
+**            They are removed from the queue and released, without completing them.
+**            Chunks that are already in progress are not affected.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     rangeCtx Pointer to the range request.
+** \return    Number of cancelled chunks.
+**
+****************************************************************************************/
+static uint16_t TbxMbClientRangeCancel(tTbxMbClientCtx            * clientCtx,
+                                       tTbxMbClientRangeCtx const * rangeCtx)
+{
+  uint16_t          result = 0U;
+  tTbxMbClientReq * cancelList = NULL;
+  tTbxMbClientReq * prevReq = NULL;
+
+  /* Remove the range request's chunks from the queue. */
+  TbxCriticalSectionEnter();
+  tTbxMbClientReq * req = clientCtx->reqHead;
+  while (req != NULL)
+  {
+    tTbxMbClientReq * nextReq = req->next;
+    /* Is this queued request a chunk of the range request? */
+    if ((req->doneFcn == TbxMbClientRangeChunkDone) &&
+        (((tTbxMbClientRangeChunk *)req->doneContext)->rangeCtx == rangeCtx))
+    {
+      /* Remove it from the queue. */
+      if (prevReq == NULL)
+      {
+        clientCtx->reqHead = nextReq;
+      }
+      else
+      {
+        prevReq->next = nextReq;
+      }
+      if (clientCtx->reqTail == req)
+      {
+        clientCtx->reqTail = prevReq;
+      }
+      /* Add it to the list with cancelled requests. */
+      req->next = cancelList;
+      cancelList = req;
+    }
+    else
+    {
+      prevReq = req;
+    }
+    /* Continue with the next queued request. */
+    req = nextReq;
+  }
+  TbxCriticalSectionExit();
+  /* Release the cancelled requests and their chunks. Queued requests are never
+   * coalesced, so they do not cover other requests.
+   */
+  while (cancelList != NULL)
+  {
+    req = cancelList;
+    cancelList = req->next;
+    TbxMemPoolRelease(req->doneContext);
+    TbxMemPoolRelease(req);
+    result++;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRangeCancel ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the coil(s) from the server with the specified node address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000.
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoils(tTbxMbClient   channel,
+                             uint8_t        node,
+                             uint16_t       addr,
+                             uint16_t       num,
+                             uint8_t      * coils)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Note the cache generation and the start time, for filling the cache. */
+    uint16_t         cacheGen = clientCtx->cacheGen;
+    uint32_t         startMs = TbxMbClientTimeMs(clientCtx);
+    tTbxMbTpPacket * txPacket = NULL;
+    /* Serve the read from the cache, if possible. */
+    if (TbxMbClientCacheRead(clientCtx, node, TBX_MB_FC01_READ_COILS,
+                             addr, num, coils, NULL, startMs) == TBX_OK)
+    {
+      result = TBX_OK;
+    }
+    /* Obtain write access to the request packet otherwise. */
+    else
+    {
+      txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    }
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC01_READ_COILS;
+      txPacket->dataLen = 4U;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of coils. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Determine the number of bytes needed to hold all the coil bits. The cast to
+           * U8 is okay, because we know that num is <= 2000.
+           */
+          uint8_t numBytes = (uint8_t)(num / 8U);
+          if ((num % 8U) != 0U)
+          {
+            numBytes++;
+          }
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC01_READ_COILS) ||
+              (byteCount != numBytes) ||
+              (rxPacket->dataLen != (byteCount + 1U)) )
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Prepare loop indices that aid with reading the coils. */
+            uint8_t   bitIdx  = 0U;
+            uint8_t   byteIdx = 0U;
+            /* Initialize byte array pointer for reading the coils. */
+            uint8_t * coilData = &rxPacket->pdu.data[1];
+            /* Loop through all the coils. */
+            for (uint16_t idx = 0U; idx < num; idx++)
+            {
+              /* Extract and store the state of the coil. */
+              if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
+              {
+                coils[idx] = TBX_ON;
+              }
+              else
+              {
+                coils[idx] = TBX_OFF;
+              }
+              /* Update the bit index. */
+              bitIdx++;
+              /* Time to move to the next byte? */
+              if (bitIdx == 8U)
+              {
+                /* Reset the bit index and increment the byte index. */
+                bitIdx = 0U;
+                byteIdx++;
+              }
+            }
+            /* Fill the cache with the read values. */
+            TbxMbClientCacheFill(clientCtx, node, TBX_MB_FC01_READ_COILS,
+                                 addr, num, rxPacket, cacheGen, startMs);
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }      
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the discrete input(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputs(tTbxMbClient   channel,
+                              uint8_t        node,
+                              uint16_t       addr,
+                              uint16_t       num,
+                              uint8_t      * inputs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (inputs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Note the cache generation and the start time, for filling the cache. */
+    uint16_t         cacheGen = clientCtx->cacheGen;
+    uint32_t         startMs = TbxMbClientTimeMs(clientCtx);
+    tTbxMbTpPacket * txPacket = NULL;
+    /* Serve the read from the cache, if possible. */
+    if (TbxMbClientCacheRead(clientCtx, node, TBX_MB_FC02_READ_DISCRETE_INPUTS,
+                             addr, num, inputs, NULL, startMs) == TBX_OK)
+    {
+      result = TBX_OK;
+    }
+    /* Obtain write access to the request packet otherwise. */
+    else
+    {
+      txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    }
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC02_READ_DISCRETE_INPUTS;
+      txPacket->dataLen = 4U;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of discrete inputs. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Determine the number of bytes needed to hold all the input bits. The cast to
+           * U8 is okay, because we know that num is <= 2000.
+           */
+          uint8_t numBytes = (uint8_t)(num / 8U);
+          if ((num % 8U) != 0U)
+          {
+            numBytes++;
+          }
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC02_READ_DISCRETE_INPUTS) ||
+              (byteCount != numBytes) ||
+              (rxPacket->dataLen != (byteCount + 1U)) )
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Prepare loop indices that aid with reading the input bits. */
+            uint8_t   bitIdx  = 0U;
+            uint8_t   byteIdx = 0U;
+            /* Initialize byte array pointer for reading the input bits. */
+            uint8_t * inputData = &rxPacket->pdu.data[1];
+            /* Loop through all the inputs. */
+            for (uint16_t idx = 0U; idx < num; idx++)
+            {
+              /* Extract and store the state of the discrete input. */
+              if ((inputData[byteIdx] & (1U << bitIdx)) != 0U)
+              {
+                inputs[idx] = TBX_ON;
+              }
+              else
+              {
+                inputs[idx] = TBX_OFF;
+              }
+              /* Update the bit index. */
+              bitIdx++;
+              /* Time to move to the next byte? */
+              if (bitIdx == 8U)
+              {
+                /* Reset the bit index and increment the byte index. */
+                bitIdx = 0U;
+                byteIdx++;
+              }
+            }
+            /* Fill the cache with the read values. */
+            TbxMbClientCacheFill(clientCtx, node, TBX_MB_FC02_READ_DISCRETE_INPUTS,
+                                 addr, num, rxPacket, cacheGen, startMs);
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }      
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the input register(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegs(tTbxMbClient   channel,
+                                 uint8_t        node,
+                                 uint16_t       addr,
+                                 uint8_t        num,
+                                 uint16_t     * inputRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (inputRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Note the cache generation and the start time, for filling the cache. */
+    uint16_t         cacheGen = clientCtx->cacheGen;
+    uint32_t         startMs = TbxMbClientTimeMs(clientCtx);
+    tTbxMbTpPacket * txPacket = NULL;
+    /* Serve the read from the cache, if possible. */
+    if (TbxMbClientCacheRead(clientCtx, node, TBX_MB_FC04_READ_INPUT_REGISTERS,
+                             addr, num, inputRegs, NULL, startMs) == TBX_OK)
+    {
+      result = TBX_OK;
+    }
+    /* Obtain write access to the request packet otherwise. */
+    else
+    {
+      txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    }
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC04_READ_INPUT_REGISTERS;
+      txPacket->dataLen = 4U;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of registers. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC04_READ_INPUT_REGISTERS) ||
+              (byteCount != (num * 2U)) ||
+              (rxPacket->dataLen != (byteCount + 1U)) )
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Set pointer to where the input registers start in the response. */
+            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
+            /* Read out and store the input register values. */
+            for (uint8_t idx = 0U; idx < num; idx++)
+            {
+              inputRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
+            }
+            /* Fill the cache with the read values. */
+            TbxMbClientCacheFill(clientCtx, node, TBX_MB_FC04_READ_INPUT_REGISTERS,
+                                 addr, num, rxPacket, cacheGen, startMs);
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the holding register(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table. Range
+**            can be 1..125
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegs(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t       addr,
+                                   uint8_t        num,
+                                   uint16_t     * holdingRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Note the cache generation and the start time, for filling the cache. */
+    uint16_t         cacheGen = clientCtx->cacheGen;
+    uint32_t         startMs = TbxMbClientTimeMs(clientCtx);
+    tTbxMbTpPacket * txPacket = NULL;
+    /* Serve the read from the cache, if possible. */
+    if (TbxMbClientCacheRead(clientCtx, node, TBX_MB_FC03_READ_HOLDING_REGISTERS,
+                             addr, num, holdingRegs, NULL, startMs) == TBX_OK)
+    {
+      result = TBX_OK;
+    }
+    /* Obtain write access to the request packet otherwise. */
+    else
+    {
+      txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    }
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC03_READ_HOLDING_REGISTERS;
+      txPacket->dataLen = 4U;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of registers. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
+              (byteCount != (num * 2U)) ||
+              (rxPacket->dataLen != (byteCount + 1U)) )
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Set pointer to where the holding registers start in the response. */
+            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
+            /* Read out and store the holding register values. */
+            for (uint8_t idx = 0U; idx < num; idx++)
+            {
+              holdingRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
+            }
+            /* Fill the cache with the read values. */
+            TbxMbClientCacheFill(clientCtx, node, TBX_MB_FC03_READ_HOLDING_REGISTERS,
+                                 addr, num, rxPacket, cacheGen, startMs);
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the coil(s) to the server with the specified node address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoils(tTbxMbClient         channel,
+                              uint8_t              node,
+                              uint16_t             addr,
+                              uint16_t             num,
+                              uint8_t      const * coils)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 1968U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 1968U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* The write makes the cached values of the coils outdated. */
+    TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC01_READ_COILS, addr, num);
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Writing just a single coil? */
+      if (num == 1U)
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC05_WRITE_SINGLE_COIL;
+        txPacket->dataLen = 4U;
+        /* Coil address. */
+        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+        /* Coil value. */
+        uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
+        TbxMbCommonStoreUInt16BE(coilValue, &txPacket->pdu.data[2]);
+      }
+      /* Writing multiple coils. */
+      else
+      {
+        /* Determine the number of bytes needed to hold all the coil bits. The cast to
+         * U8 is okay, because we know that num is <= 1968.
+         */
+        uint8_t numBytes = (uint8_t)(num / 8U);
+        if ((num % 8U) != 0U)
+        {
+          numBytes++;
+        }
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+        txPacket->dataLen = numBytes + 5U;
+        /* Start address. */
+        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+        /* Number of holding registers. */
+        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+        /* Byte count. */
+        txPacket->pdu.data[4] = numBytes;
+        /* Prepare loop indices that aid with reading the input bits. */
+        uint8_t   bitIdx  = 0U;
+        uint8_t   byteIdx = 0U;
+        /* Set pointer to where the coils start in the request and already initialize the
+         * first byte to all zero (coil OFF) bits.
+        */
+        uint8_t * coilData = &txPacket->pdu.data[5];
+        coilData[0] = 0U;
+        /* Store the coil values. */
+        for (uint16_t idx = 0U; idx < num; idx++)
+        {
+          /* Should the coil be ON? */
+          if (coils[idx] != TBX_OFF)
+          {
+            coilData[byteIdx] |= (1U << bitIdx);
+          }
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
+          {
+            /* Reset the bit index, increment the byte index and initialize the byte to
+             * all zero (coil OFF) bits.
+             */
+            bitIdx = 0U;
+            byteIdx++;
+            coilData[byteIdx] = 0U;
+          }
+        }
+      }
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Wrote just a single coil? */
+          if (num == 1U)
+          {
+            /* Coil value. */
+            uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response), that the coil
+             * address and value are as expected and that the data length is as
+             * expected.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC05_WRITE_SINGLE_COIL) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != coilValue) ||
+                (rxPacket->dataLen != 4U))
+            {
+              result = TBX_ERROR;
+            }
+          }
+          /* Wrote multiple holding registers. */
+          else
+          {
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response), that the coil
+             * start address and quantity are as expected and that the data length is as
+             * expected.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC15_WRITE_MULTIPLE_COILS) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
+                (rxPacket->dataLen != 4U))
+            {
+              result = TBX_ERROR;
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }  
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the holding register(s) to the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. Range
+**            can be 1..123
+** \param     holdingRegs Pointer to array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
+                                    uint8_t              node,
+                                    uint16_t             addr,
+                                    uint8_t              num,
+                                    uint16_t     const * holdingRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 123U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 123U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* The write makes the cached values of the holding registers outdated. */
+    TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC03_READ_HOLDING_REGISTERS, addr,
+                               num);
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Writing just a single holding register? */
+      if (num == 1U)
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
+        txPacket->dataLen = 4U;
+        /* Holding register address. */
+        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+        /* Holding register value. */
+        TbxMbCommonStoreUInt16BE(holdingRegs[0], &txPacket->pdu.data[2]);
+      }
+      /* Writing multiple holding registers. */
+      else
+      {
+        /* Determine byte count needed for storing the holding register values. */
+        uint8_t byteCount = num * 2U;
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
+        txPacket->dataLen = byteCount + 5U;
+        /* Start address. */
+        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+        /* Number of holding registers. */
+        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+        /* Byte count. */
+        txPacket->pdu.data[4] = byteCount;
+        /* Set pointer to where the holding registers start in the request. */
+        uint8_t * regValPtr = &txPacket->pdu.data[5];
+        /* Store the holding register values. */
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &regValPtr[idx * 2U]);
+        }
+      }
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Wrote just a single holding register? */
+          if (num == 1U)
+          {
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response), that the register
+             * address and values are as expected and that the data length is as
+             * expected.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC06_WRITE_SINGLE_REGISTER) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != holdingRegs[0]) ||
+                (rxPacket->dataLen != 4U))
+            {
+              result = TBX_ERROR;
+            }
+          }
+          /* Wrote multiple holding registers. */
+          else
+          {
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response), that the register
+             * start address and quantity are as expected and that the data length is as
+             * expected.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
+                (rxPacket->dataLen != 4U))
+            {
+              result = TBX_ERROR;
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+
+  }      
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Perform diagnostic operation on the server for checking the communication
+**            system.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     subcode Sub-function code for specifying the diagnostic operation to
+**            perform. Currently supported values:
+**              - TBX_MB_DIAG_SC_QUERY_DATA
+**              - TBX_MB_DIAG_SC_CLEAR_COUNTERS
+**              - TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
+** \param     count Location where the retrieved count value will be written to. Only
+**            applicable for the subcodes that end with _COUNT.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
+                               uint8_t        node,
+                               uint16_t       subcode,
+                               uint16_t     * count)
+{
+  uint8_t        result      = TBX_ERROR;
+  uint16_t const queryData[] = { 0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U };
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
+             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+              (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
+      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+       (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC08_DIAGNOSTICS;
+      TbxMbCommonStoreUInt16BE(subcode, &txPacket->pdu.data[0]);
+      /* Requested to perform a query data diagnostic operation? */
+      if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+      {
+        /* Write the query data for loopback testing. */
+        for (uint8_t idx = 0U; idx < (sizeof(queryData)/sizeof(queryData[0])); idx++)
+        {
+          TbxMbCommonStoreUInt16BE(queryData[idx], &txPacket->pdu.data[2U + (idx * 2U)]);
+        }
+        txPacket->dataLen = ((sizeof(queryData) / sizeof(queryData[0])) * 2U) + 2U;
+      }
+      /* All other supported subcodes require a 16-bit zero value data field. */
+      else
+      {
+        /* Store the data field as per the protocol. */
+        TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
+        txPacket->dataLen = 4U;
+      }
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it's a
+           * response with the same function sub-code.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response looks valid so far. Continue with processing its data.*/
+          else
+          {
+            if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+            {
+              const uint8_t queryDataLen = sizeof(queryData) / sizeof(queryData[0]);
+              /* Check the data length. */
+              if (rxPacket->dataLen != ((queryDataLen * 2U) + 2U))
+              {
+                result = TBX_ERROR;
+              }
+              /* Data length okay, continue with checking its content. */
+              else
+              {
+                /* Loop through the received query data. */
+                for (uint8_t idx = 0U; idx < queryDataLen; idx++)
+                {
+                  uint8_t const * entryPtr = &rxPacket->pdu.data[2];
+                  uint16_t entry = TbxMbCommonExtractUInt16BE(&entryPtr[idx * 2U]);
+                  /* Check that its value is the same as what was sent in the request. */
+                  if (entry != queryData[idx])
+                  {
+                    /* Flag the error and stop the loop. */
+                    result = TBX_ERROR;
+                    break;
+                  }
+                }
+              }
+            }
+            else if (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS)
+            {
+              /* Check the data length. */
+              if (rxPacket->dataLen != 4U)
+              {
+                result = TBX_ERROR;
+              }
+              /* Data length okay, continue with checking its content. */
+              else
+              {
+                uint8_t const * dataValPtr = &rxPacket->pdu.data[2];
+                uint16_t dataVal = TbxMbCommonExtractUInt16BE(dataValPtr);
+                /* Check that the value is as expected. */
+                if (dataVal != 0x0000U)
+                {
+                  result = TBX_ERROR;
+                }
+              }
+            }
+            /* subcode for reading a count. */
+            else
+            {
+              /* Check the data length. */
+              if (rxPacket->dataLen != 4U)
+              {
+                result = TBX_ERROR;
+              }
+              /* Data length okay, continue with extracting the count value. */
+              else
+              {
+                uint8_t const * countValPtr = &rxPacket->pdu.data[2];
+                uint16_t countVal = TbxMbCommonExtractUInt16BE(countValPtr);
+                /* Verify that count parameter. */
+                TBX_ASSERT(count != NULL);
+                /* Only continue with a valid count parameter. */
+                if (count != NULL)
+                {
+                  /* Store the count value. */
+                  *count = countVal;
+                }
+                else
+                {
+                  /* The an error due to an invalid count parameter. */
+                  result = TBX_ERROR;
+                }
+              }
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientDiagnostics ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the communication event counter from a remote slave. The server
+**            increments this counter for each successfully completed request. Requests
+**            answered with an exception response and requests for reading this counter
+**            are not counted.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     status Location where the retrieved status word will be written to. It's
+**            0xFFFF while the server is still busy processing a previous command and
+**            0x0000 otherwise.
+** \param     count Location where the retrieved event count will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientGetCommEventCounter(tTbxMbClient   channel,
+                                       uint8_t        node,
+                                       uint16_t     * status,
+                                       uint16_t     * count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (status != NULL) && (count != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (status != NULL) && (count != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. This function code has no data bytes. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC11_GET_COMM_EVENT_COUNTER;
+      txPacket->dataLen = 0U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC11_GET_COMM_EVENT_COUNTER) ||
+              (rxPacket->dataLen != 4U))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response is valid. */
+          else
+          {
+            /* Extract the status word and the event count. */
+            *status = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+            *count  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientGetCommEventCounter ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the communication event log from a remote slave. Besides the events
+**            themselves, this includes the status word, the communication event
+**            counter and the bus message count.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     status Location where the retrieved status word will be written to. It's
+**            0xFFFF while the server is still busy processing a previous command and
+**            0x0000 otherwise.
+** \param     eventCount Location where the retrieved communication event counter will
+**            be written to.
+** \param     msgCount Location where the retrieved bus message count will be written
+**            to.
+** \param     events Pointer to byte array where the received events will be written to,
+**            starting with the most recent one. Decode them with the
+**            TBX_MB_COMM_EVENT_xxx macros. Holds at most TBX_MB_COMM_EVENT_LOG_LEN
+**            events.
+** \param     num Pointer to the size of the events byte array. This function updates it
+**            with the number of events actually written to the events byte array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientGetCommEventLog(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t     * status,
+                                   uint16_t     * eventCount,
+                                   uint16_t     * msgCount,
+                                   uint8_t      * events,
+                                   uint8_t      * num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (status != NULL) && 
+             (eventCount != NULL) && (msgCount != NULL) && (events != NULL) && 
+             (num != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (status != NULL) && 
+      (eventCount != NULL) && (msgCount != NULL) && (events != NULL) && 
+      (num != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. This function code has no data bytes. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC12_GET_COMM_EVENT_LOG;
+      txPacket->dataLen = 0U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length. Also make sure the events fit.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC12_GET_COMM_EVENT_LOG) ||
+              (rxPacket->dataLen < 7U) ||
+              (rxPacket->dataLen != (byteCount + 1U)) ||
+              ((byteCount - 6U) > *num))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response is valid. */
+          else
+          {
+            /* Extract the status word, event count and message count. */
+            *status     = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[1]);
+            *eventCount = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[3]);
+            *msgCount   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[5]);
+            /* Copy the events. */
+            for (uint8_t idx = 0U; idx < (byteCount - 6U); idx++)
+            {
+              events[idx] = rxPacket->pdu.data[7U + idx];
+            }
+            /* Update the number of events. */
+            *num = byteCount - 6U;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientGetCommEventLog ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the server ID report from a remote slave. This includes the server
+**            ID, its run indicator status and optionally additional device specific
+**            data.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     data Pointer to byte array where the received server ID data will be
+**            written to.
+** \param     len Pointer to the size of the data byte array. This function updates it
+**            with the number of bytes actually written to the data byte array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReportServerId(tTbxMbClient   channel,
+                                  uint8_t        node,
+                                  uint8_t      * data,
+                                  uint8_t      * len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (data != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (data != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. This function code has no data bytes. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC17_REPORT_SERVER_ID;
+      txPacket->dataLen = 0U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length. Also make sure the data fits.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC17_REPORT_SERVER_ID) ||
+              (rxPacket->dataLen < 1U) ||
+              (rxPacket->dataLen != (byteCount + 1U)) ||
+              (byteCount > *len))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response is valid. */
+          else
+          {
+            /* Copy the server ID data. */
+            for (uint8_t idx = 0U; idx < byteCount; idx++)
+            {
+              data[idx] = rxPacket->pdu.data[1U + idx];
+            }
+            /* Update the length. */
+            *len = byteCount;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReportServerId ***/
+
+
+/************************************************************************************//**
+** \brief     Reads device identification objects from a remote slave. 
+** \details   The read device ID code determines which objects are read:
+**              - TBX_MB_DEVID_READ_BASIC: the basic objects (0x00..0x02).
+**              - TBX_MB_DEVID_READ_REGULAR: the basic and regular objects (0x00..0x7F).
+**              - TBX_MB_DEVID_READ_EXTENDED: all objects (0x00..0xFF).
+**              - TBX_MB_DEVID_READ_INDIVIDUAL: only the object with the specified id.
+**            With stream access (basic, regular, extended), reading starts at the object
+**            with the specified id and this function automatically sends follow-up
+**            requests, until the server reported that no more objects follow.
+**            The received objects are stored one after the other in the "objects" byte
+**            array. Each object is stored as: object id (1 byte), value length (1 byte),
+**            value (length bytes). Objects that the server does not support are simply
+**            not present.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     code Read device ID code (TBX_MB_DEVID_READ_xxx).
+** \param     objectId Id of the object to start reading at (stream access) or the object
+**            to read (individual access). Use TBX_MB_DEVID_OBJ_VENDOR_NAME to read all
+**            objects of a category.
+** \param     objects Pointer to byte array where the received objects will be written
+**            to.
+** \param     len Pointer to the size of the objects byte array. This function updates it
+**            with the number of bytes actually written to the objects byte array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadDeviceId(tTbxMbClient   channel,
+                                uint8_t        node,
+                                uint8_t        code,
+                                uint8_t        objectId,
+                                uint8_t      * objects,
+                                uint16_t     * len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (code >= TBX_MB_DEVID_READ_BASIC) &&
+             (code <= TBX_MB_DEVID_READ_INDIVIDUAL) && (objects != NULL) && 
+             (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (code >= TBX_MB_DEVID_READ_BASIC) &&
+      (code <= TBX_MB_DEVID_READ_INDIVIDUAL) && (objects != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    uint16_t       objectsLen  = 0U;
+    uint8_t        moreFollows = TBX_TRUE;
+
+    /* Keep requesting objects until the server reported that no more follow. */
+    while (moreFollows == TBX_TRUE)
+    {
+      /* Reset the result and the flag for this loop iteration. */
+      result = TBX_ERROR;
+      moreFollows = TBX_FALSE;
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+      /* Should always work, unless this function is being called recursively. Only
+       * continue with access for preparing the request packet.
+       */
+      if (txPacket != NULL)
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC43_ENCAPSULATED_INTERFACE;
+        txPacket->pdu.data[0] = TBX_MB_MEI_READ_DEVICE_ID;
+        txPacket->pdu.data[1] = code;
+        txPacket->pdu.data[2] = objectId;
+        txPacket->dataLen = 3U;
+        /* Transmit the request and wait for the response to come in. Note that this
+         * function code does not support broadcast requests.
+         */
+        result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+      }
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it echoes
+           * the MEI type and the read device ID code.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC43_ENCAPSULATED_INTERFACE) ||
+              (rxPacket->dataLen < 6U) ||
+              (rxPacket->pdu.data[0] != TBX_MB_MEI_READ_DEVICE_ID) ||
+              (rxPacket->pdu.data[1] != code))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response header looks valid so far. Continue with processing its objects. */
+          else
+          {
+            uint8_t const * objPtr     = &rxPacket->pdu.data[6];
+            uint8_t         numObjects = rxPacket->pdu.data[5];
+            uint8_t         bytesLeft  = rxPacket->dataLen - 6U;
+            /* Loop through the objects in the response. */
+            for (uint8_t objIdx = 0U; objIdx < numObjects; objIdx++)
+            {
+              /* Determine the object's total size, including its id and length. */
+              uint16_t objSize = 0xFFFFU;
+              if (bytesLeft >= 2U)
+              {
+                objSize = 2U + (uint16_t)objPtr[1];
+              }
+              /* Check that the object is completely present in the response and that it
+               * fits in the objects byte array.
+               */
+              if ((objSize > bytesLeft) || (objSize > (*len - objectsLen)))
+              {
+                /* Flag the error and stop the loop. */
+                result = TBX_ERROR;
+                break;
+              }
+              /* Copy the object, including its id and length. */
+              for (uint16_t idx = 0U; idx < objSize; idx++)
+              {
+                objects[objectsLen + idx] = objPtr[idx];
+              }
+              /* Update the loop variables. */
+              objectsLen += objSize;
+              objPtr += objSize;
+              bytesLeft -= (uint8_t)objSize;
+            }
+            /* Check if more objects follow with stream access. Only request them if the
+             * next object id actually moves forward. Otherwise a faulty server could
+             * keep us in this loop forever. A server is allowed to restart at object 0,
+             * for example because its objects changed. This ends the iteration with the
+             * objects read so far.
+             */
+            if ((result == TBX_OK) && (code != TBX_MB_DEVID_READ_INDIVIDUAL) &&
+                (rxPacket->pdu.data[3] == 0xFFU))
+            {
+              if (rxPacket->pdu.data[4] > objectId)
+              {
+                /* Prepare the next request. */
+                objectId = rxPacket->pdu.data[4];
+                moreFollows = TBX_TRUE;
+              }
+              else if (rxPacket->pdu.data[4] != TBX_MB_DEVID_OBJ_VENDOR_NAME)
+              {
+                result = TBX_ERROR;
+              }
+              else
+              {
+                /* Nothing left to do, but MISRA requires this terminating else
+                 * statement.
+                 */
+              }
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+    /* Update the length if successful. */
+    if (result == TBX_OK)
+    {
+      *len = objectsLen;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Reads blocks of registers from file records of a remote slave. 
+** \details   Each block can be of arbitrary length, as long as it stays within the
+**            record number range 0..9999 of its file. This function splits the blocks
+**            into sub-requests and packs as many sub-requests as fit in a single PDU.
+**            This keeps the number of transactions on the bus to a minimum.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     records Pointer to array with the file record blocks to read. The "data"
+**            element of each block points to where the read register values will be
+**            written to.
+** \param     num Number of file record blocks in the array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFileRecords(tTbxMbClient                   channel,
+                                   uint8_t                        node,
+                                   tTbxMbClientFileRecord const * records,
+                                   uint8_t                        num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (records != NULL) && (num > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (records != NULL) && (num > 0U))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Validate the file record blocks. */
+    result = TbxMbClientFileRecordsCheck(records, num);
+    uint8_t  recIdx    = 0U;
+    uint16_t recOffset = 0U;
+
+    /* Keep transferring PDUs, until all blocks are read or an error was detected. */
+    while ((result == TBX_OK) && (recIdx < num))
+    {
+      uint8_t  subRecIdx[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint16_t subOffset[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint8_t  subLen[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint8_t  numSubReqs = 0U;
+      uint16_t respLen    = 0U;
+
+      /* Split the blocks into sub-requests, until the PDU is full. Note that the
+       * response is always longer than the request, so the response determines how 
+       * many register values fit.
+       */
+      while ((recIdx < num) && (numSubReqs < TBX_MB_CLIENT_FILE_SUBREQS_MAX))
+      {
+        uint16_t regsLeft  = records[recIdx].recordLen - recOffset;
+        uint16_t spaceLeft = TBX_MB_FILE_BYTE_COUNT_MAX - respLen;
+        /* Done with this block? */
+        if (regsLeft == 0U)
+        {
+          /* Continue with the next block. */
+          recIdx++;
+          recOffset = 0U;
+        }
+        /* Not enough space left in the response for a sub-response with a register? */
+        else if (spaceLeft < 4U)
+        {
+          /* Stop looping. */
+          break;
+        }
+        else
+        {
+          /* Determine how many register values of this block fit. */
+          uint16_t chunkLen = (spaceLeft - 2U) / 2U;
+          if (chunkLen > regsLeft)
+          {
+            chunkLen = regsLeft;
+          }
+          /* Add the sub-request. */
+          subRecIdx[numSubReqs] = recIdx;
+          subOffset[numSubReqs] = recOffset;
+          subLen[numSubReqs] = (uint8_t)chunkLen;
+          numSubReqs++;
+          /* Update the loop variables. */
+          respLen += 2U + (chunkLen * 2U);
+          recOffset += chunkLen;
+        }
+      }
+      /* Nothing left to request? */
+      if (numSubReqs == 0U)
+      {
+        /* All done. */
+        break;
+      }
+
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+      /* Should always work, unless this function is being called recursively. Only
+       * continue with access for preparing the request packet.
+       */
+      if (txPacket == NULL)
+      {
+        result = TBX_ERROR;
+        break;
+      }
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC20_READ_FILE_RECORD;
+      txPacket->pdu.data[0] = numSubReqs * TBX_MB_FILE_SUBREQ_HDR_LEN;
+      for (uint8_t idx = 0U; idx < numSubReqs; idx++)
+      {
+        tTbxMbClientFileRecord const * record = &records[subRecIdx[idx]];
+        uint8_t * subReq = &txPacket->pdu.data[1U + (idx * TBX_MB_FILE_SUBREQ_HDR_LEN)];
+        subReq[0] = TBX_MB_FILE_REF_TYPE;
+        TbxMbCommonStoreUInt16BE(record->fileNum, &subReq[1]);
+        TbxMbCommonStoreUInt16BE(record->recordNum + subOffset[idx], &subReq[3]);
+        TbxMbCommonStoreUInt16BE(subLen[idx], &subReq[5]);
+      }
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC20_READ_FILE_RECORD) ||
+              (rxPacket->dataLen != (respLen + 1U)) ||
+              (rxPacket->pdu.data[0] != respLen))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response looks valid so far. Continue with processing its sub-responses. */
+          else
+          {
+            uint8_t const * subResp = &rxPacket->pdu.data[1];
+            /* Loop through the sub-responses. */
+            for (uint8_t idx = 0U; idx < numSubReqs; idx++)
+            {
+              /* Check the sub-response length and reference type. */
+              if ((subResp[0] != ((subLen[idx] * 2U) + 1U)) ||
+                  (subResp[1] != TBX_MB_FILE_REF_TYPE))
+              {
+                /* Flag the error and stop the loop. */
+                result = TBX_ERROR;
+                break;
+              }
+              /* Copy the register values. */
+              uint16_t * regValues = &records[subRecIdx[idx]].data[subOffset[idx]];
+              for (uint8_t regIdx = 0U; regIdx < subLen[idx]; regIdx++)
+              {
+                regValues[regIdx] = TbxMbCommonExtractUInt16BE(&subResp[2U + 
+                                                                         (regIdx * 2U)]);
+              }
+              /* Continue with the next sub-response. */
+              subResp += 2U + (subLen[idx] * 2U);
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFileRecords ***/
+
+
+/************************************************************************************//**
+** \brief     Writes blocks of registers to file records of a remote slave. 
+** \details   Each block can be of arbitrary length, as long as it stays within the
+**            record number range 0..9999 of its file. This function splits the blocks
+**            into sub-requests and packs as many sub-requests as fit in a single PDU.
+**            This keeps the number of transactions on the bus to a minimum.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     records Pointer to array with the file record blocks to write. The "data"
+**            element of each block points to the register values to write.
+** \param     num Number of file record blocks in the array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteFileRecords(tTbxMbClient                   channel,
+                                    uint8_t                        node,
+                                    tTbxMbClientFileRecord const * records,
+                                    uint8_t                        num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (records != NULL) && (num > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (records != NULL) && (num > 0U))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Validate the file record blocks. */
+    result = TbxMbClientFileRecordsCheck(records, num);
+    uint8_t  recIdx    = 0U;
+    uint16_t recOffset = 0U;
+
+    /* Keep transferring PDUs, until all blocks are written or an error was detected. */
+    while ((result == TBX_OK) && (recIdx < num))
+    {
+      uint8_t  subRecIdx[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint16_t subOffset[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint8_t  subLen[TBX_MB_CLIENT_FILE_SUBREQS_MAX];
+      uint8_t  numSubReqs = 0U;
+      uint16_t reqLen     = 0U;
+
+      /* Split the blocks into sub-requests, until the PDU is full. */
+      while ((recIdx < num) && (numSubReqs < TBX_MB_CLIENT_FILE_SUBREQS_MAX))
+      {
+        uint16_t regsLeft  = records[recIdx].recordLen - recOffset;
+        uint16_t spaceLeft = TBX_MB_FILE_BYTE_COUNT_MAX - reqLen;
+        /* Done with this block? */
+        if (regsLeft == 0U)
+        {
+          /* Continue with the next block. */
+          recIdx++;
+          recOffset = 0U;
+        }
+        /* Not enough space left in the request for a sub-request with a register? */
+        else if (spaceLeft < (TBX_MB_FILE_SUBREQ_HDR_LEN + 2U))
+        {
+          /* Stop looping. */
+          break;
+        }
+        else
+        {
+          /* Determine how many register values of this block fit. */
+          uint16_t chunkLen = (spaceLeft - TBX_MB_FILE_SUBREQ_HDR_LEN) / 2U;
+          if (chunkLen > regsLeft)
+          {
+            chunkLen = regsLeft;
+          }
+          /* Add the sub-request. */
+          subRecIdx[numSubReqs] = recIdx;
+          subOffset[numSubReqs] = recOffset;
+          subLen[numSubReqs] = (uint8_t)chunkLen;
+          numSubReqs++;
+          /* Update the loop variables. */
+          reqLen += TBX_MB_FILE_SUBREQ_HDR_LEN + (chunkLen * 2U);
+          recOffset += chunkLen;
+        }
+      }
+      /* Nothing left to write? */
+      if (numSubReqs == 0U)
+      {
+        /* All done. */
+        break;
+      }
+
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+      /* Should always work, unless this function is being called recursively. Only
+       * continue with access for preparing the request packet.
+       */
+      if (txPacket == NULL)
+      {
+        result = TBX_ERROR;
+        break;
+      }
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC21_WRITE_FILE_RECORD;
+      txPacket->pdu.data[0] = (uint8_t)reqLen;
+      uint8_t * subReq = &txPacket->pdu.data[1];
+      for (uint8_t idx = 0U; idx < numSubReqs; idx++)
+      {
+        tTbxMbClientFileRecord const * record = &records[subRecIdx[idx]];
+        uint16_t const * regValues = &record->data[subOffset[idx]];
+        subReq[0] = TBX_MB_FILE_REF_TYPE;
+        TbxMbCommonStoreUInt16BE(record->fileNum, &subReq[1]);
+        TbxMbCommonStoreUInt16BE(record->recordNum + subOffset[idx], &subReq[3]);
+        TbxMbCommonStoreUInt16BE(subLen[idx], &subReq[5]);
+        for (uint8_t regIdx = 0U; regIdx < subLen[idx]; regIdx++)
+        {
+          TbxMbCommonStoreUInt16BE(regValues[regIdx], 
+                                   &subReq[TBX_MB_FILE_SUBREQ_HDR_LEN + (regIdx * 2U)]);
+        }
+        /* Continue with the next sub-request. */
+        subReq += TBX_MB_FILE_SUBREQ_HDR_LEN + (subLen[idx] * 2U);
+      }
+      txPacket->dataLen = reqLen + 1U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length. The response is an echo of the request.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC21_WRITE_FILE_RECORD) ||
+              (rxPacket->dataLen != (reqLen + 1U)) ||
+              (rxPacket->pdu.data[0] != reqLen))
+          {
+            result = TBX_ERROR;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteFileRecords ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the values from a FIFO queue of a remote slave. The server removes
+**            the values included in the response from its FIFO queue. If the FIFO queue
+**            holds more values than fit in a single response, call this function again
+**            to read out the remaining values.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter should be in the range
+**            1..247.
+** \param     addr FIFO pointer address of the FIFO queue to read.
+** \param     values Pointer to array where the FIFO queue values will be written to. It
+**            should be able to hold at least TBX_MB_FIFO_COUNT_MAX (31) values.
+** \param     count Location where the number of read values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFifo(tTbxMbClient   channel,
+                            uint8_t        node,
+                            uint16_t       addr,
+                            uint16_t     * values,
+                            uint8_t      * count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (values != NULL) && (count != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) && 
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (values != NULL) && (count != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC24_READ_FIFO_QUEUE;
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      txPacket->dataLen = 2U;
+      /* Transmit the request and wait for the response to come in. Note that this
+       * function code does not support broadcast requests.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          uint16_t byteCnt = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+          uint16_t fifoCnt = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it has the
+           * expected length.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC24_READ_FIFO_QUEUE) ||
+              (rxPacket->dataLen < 4U) ||
+              (fifoCnt > TBX_MB_FIFO_COUNT_MAX) ||
+              (byteCnt != ((fifoCnt * 2U) + 2U)) ||
+              (rxPacket->dataLen != (byteCnt + 2U)))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response is valid. */
+          else
+          {
+            /* Copy the FIFO queue values. */
+            for (uint8_t idx = 0U; idx < fifoCnt; idx++)
+            {
+              values[idx] = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4U + 
+                                                                           (idx * 2U)]);
+            }
+            /* Store the number of values. */
+            *count = (uint8_t)fifoCnt;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFifo ***/
+
+
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response PDU.
+**            Thanks to this functionality, the user can support Modbus function codes
+**            that are either currently not supported or user defined extensions.
+** \details   The "txPdu" and "rxPdu" parameters are pointers to the byte array of the
+**            PDU. The first byte (i.e. txPdu[0]) contains the function code, followed by
+**            its data bytes. When calling this function, set the "len" parameter to the
+**            length of the "txPdu". This function updates the "len" parameter with the
+**            length of the received PDU, which it stores in "rxPdu".
+** \example   Example of manually sending the "Write Single Register 0x06" function code
+**            to a node with address 10 (0x0A) for setting the holding register at
+**            address 40000 to a value of 127:
+**
+**              uint8_t  requestPdu[TBX_MB_TP_PDU_MAX_LEN];
+**              uint8_t  responsePdu[TBX_MB_TP_PDU_MAX_LEN];
+**              uint8_t  pduLen;
+**              uint16_t holdingRegAddr = 40000U;
+**              uint16_t holdingRegValue = 127U;
+**
+**              requestPdu[0] = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
+**              requestPdu[1] = (uint8_t)(holdingRegAddr >> 8U);
+**              requestPdu[2] = (uint8_t) holdingRegAddr;
+**              requestPdu[3] = (uint8_t)(holdingRegValue >> 8U);
+**              requestPdu[4] = (uint8_t) holdingRegValue;
+**              pduLen = 5U;
+**
+**              TbxMbClientCustomFunction(modbusClient, 0x0A, requestPdu, responsePdu, 
+**                                        &pduLen);
+**
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     txPdu Pointer to a byte array with the PDU to transmit.
+** \param     rxPdu Pointer to a byte array with the received response PDU.
+** \param     len Pointer to the PDU length, including the function code.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
+                                   uint8_t              node,
+                                   uint8_t      const * txPdu,
+                                   uint8_t            * rxPdu,
+                                   uint8_t            * len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+             (rxPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+      (rxPdu != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet, but only with a valid packet length.
+     * It should at least have a PDU function code.
+     */
+    tTbxMbTpPacket * txPacket = NULL;
+    if (*len > 0U)
+    {
+      txPacket = TbxMbClientTxPacketClaim(clientCtx);
+    }
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = txPdu[0];
+      txPacket->dataLen = *len - 1U;
+      for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
+      {
+        txPacket->pdu.data[idx] = txPdu[idx + 1U];
+      }
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, node, isBroadcast);
+
+      /* Initialize the length of the response PDU to zero. This default indicates that
+       * no response was received. This is the case in the request was a broadcast one or
+       * it the response was not valid. If will be updated later on, if a valid response
+       * was received.
+       */
+      *len = 0U;
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node. */
+          if (rxPacket->node != node)
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Copy its data. */
+          else
+          {
+            /* Set the length, including the function code. */
+            *len = rxPacket->dataLen + 1U;
+            /* Set the function code. */
+            rxPdu[0] = rxPacket->pdu.code;
+            /* Copy the packet data. */
+            for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+            {
+              rxPdu[idx + 1U] = rxPacket->pdu.data[idx];
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadCoils(). It queues the request and
+**            returns immediately. The event task reports the completion of the request
+**            with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to. It must stay valid until the request completes.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoilsAsync(tTbxMbClient       channel,
+                                  uint8_t            node,
+                                  uint16_t           addr,
+                                  uint16_t           num,
+                                  uint8_t          * coils,
+                                  tTbxMbClientDone   doneFcn,
+                                  void             * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (coils != NULL))
+  {
+    /* Queue the read request. */
+    result = TbxMbClientReadAsync(channel, node, TBX_MB_FC01_READ_COILS, addr, num,
+                                  coils, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoilsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadInputs(). It queues the request and
+**            returns immediately. The event task reports the completion of the request
+**            with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to. It must stay valid until the request
+**            completes.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputsAsync(tTbxMbClient       channel,
+                                   uint8_t            node,
+                                   uint16_t           addr,
+                                   uint16_t           num,
+                                   uint8_t          * inputs,
+                                   tTbxMbClientDone   doneFcn,
+                                   void             * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (inputs != NULL))
+  {
+    /* Queue the read request. */
+    result = TbxMbClientReadAsync(channel, node, TBX_MB_FC02_READ_DISCRETE_INPUTS, addr,
+                                  num, inputs, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadInputRegs(). It queues the request
+**            and returns immediately. The event task reports the completion of the
+**            request with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to. It must stay valid until the request completes.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegsAsync(tTbxMbClient       channel,
+                                      uint8_t            node,
+                                      uint16_t           addr,
+                                      uint8_t            num,
+                                      uint16_t         * inputRegs,
+                                      tTbxMbClientDone   doneFcn,
+                                      void             * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (inputRegs != NULL))
+  {
+    /* Queue the read request. */
+    result = TbxMbClientReadAsync(channel, node, TBX_MB_FC04_READ_INPUT_REGISTERS, addr,
+                                  num, inputRegs, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadHoldingRegs(). It queues the request
+**            and returns immediately. The event task reports the completion of the
+**            request with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to. It must stay valid until the request completes.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegsAsync(tTbxMbClient       channel,
+                                        uint8_t            node,
+                                        uint16_t           addr,
+                                        uint8_t            num,
+                                        uint16_t         * holdingRegs,
+                                        tTbxMbClientDone   doneFcn,
+                                        void             * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (holdingRegs != NULL))
+  {
+    /* Queue the read request. */
+    result = TbxMbClientReadAsync(channel, node, TBX_MB_FC03_READ_HOLDING_REGISTERS,
+                                  addr, num, holdingRegs, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadHoldingRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientWriteCoils(). It queues the request and
+**            returns immediately. The event task reports the completion of the request
+**            with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values. The
+**            values are copied into the request, so the array can be reused right away.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoilsAsync(tTbxMbClient         channel,
+                                   uint8_t              node,
+                                   uint16_t             addr,
+                                   uint16_t             num,
+                                   uint8_t      const * coils,
+                                   tTbxMbClientDone     doneFcn,
+                                   void               * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 1968U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 1968U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Create the new request. Writing just a single coil uses its own function code. */
+    uint8_t code = (num == 1U) ? TBX_MB_FC05_WRITE_SINGLE_COIL :
+                                 TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+    tTbxMbClientReq * req = TbxMbClientReqCreate(node, code, doneFcn, context);
+    /* Only continue if the request could be created. */
+    if (req != NULL)
+    {
+      /* Coil address or start address. */
+      TbxMbCommonStoreUInt16BE(addr, &req->pdu.data[0]);
+      /* Writing just a single coil? */
+      if (num == 1U)
+      {
+        /* Coil value. */
+        uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
+        TbxMbCommonStoreUInt16BE(coilValue, &req->pdu.data[2]);
+        req->dataLen = 4U;
+      }
+      /* Writing multiple coils. */
+      else
+      {
+        /* Determine the number of bytes needed to hold all the coil bits. The cast to
+         * U8 is okay, because we know that num is <= 1968.
+         */
+        uint8_t numBytes = (uint8_t)((num + 7U) / 8U);
+        /* Number of coils. */
+        TbxMbCommonStoreUInt16BE(num, &req->pdu.data[2]);
+        /* Byte count. */
+        req->pdu.data[4] = numBytes;
+        req->dataLen = numBytes + 5U;
+        /* Set pointer to where the coils start in the request and initialize all coil
+         * bits to OFF.
+         */
+        uint8_t * coilData = &req->pdu.data[5];
+        for (uint8_t idx = 0U; idx < numBytes; idx++)
+        {
+          coilData[idx] = 0U;
+        }
+        /* Store the coil values. */
+        for (uint16_t idx = 0U; idx < num; idx++)
+        {
+          /* Should the coil be ON? */
+          if (coils[idx] != TBX_OFF)
+          {
+            coilData[idx / 8U] |= (uint8_t)(1U << (idx % 8U));
+          }
+        }
+      }
+      /* The write makes the cached values of the coils outdated. */
+      TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC01_READ_COILS, addr, num);
+      /* Queue the request. */
+      TbxMbClientReqSubmit(clientCtx, req);
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoilsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientWriteHoldingRegs(). It queues the
+**            request and returns immediately. The event task reports the completion of
+**            the request with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. Range
+**            can be 1..123
+** \param     holdingRegs Pointer to array with the desired holding register values. The
+**            values are copied into the request, so the array can be reused right away.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteHoldingRegsAsync(tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint8_t              num,
+                                         uint16_t     const * holdingRegs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 123U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 123U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Create the new request. Writing just a single holding register uses its own
+     * function code.
+     */
+    uint8_t code = (num == 1U) ? TBX_MB_FC06_WRITE_SINGLE_REGISTER :
+                                 TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
+    tTbxMbClientReq * req = TbxMbClientReqCreate(node, code, doneFcn, context);
+    /* Only continue if the request could be created. */
+    if (req != NULL)
+    {
+      /* Holding register address or start address. */
+      TbxMbCommonStoreUInt16BE(addr, &req->pdu.data[0]);
+      /* Writing just a single holding register? */
+      if (num == 1U)
+      {
+        /* Holding register value. */
+        TbxMbCommonStoreUInt16BE(holdingRegs[0], &req->pdu.data[2]);
+        req->dataLen = 4U;
+      }
+      /* Writing multiple holding registers. */
+      else
+      {
+        /* Determine byte count needed for storing the holding register values. */
+        uint8_t byteCount = num * 2U;
+        /* Number of holding registers. */
+        TbxMbCommonStoreUInt16BE(num, &req->pdu.data[2]);
+        /* Byte count. */
+        req->pdu.data[4] = byteCount;
+        req->dataLen = byteCount + 5U;
+        /* Store the holding register values. */
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &req->pdu.data[5U + (idx * 2U)]);
+        }
+      }
+      /* The write makes the cached values of the holding registers outdated. */
+      TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC03_READ_HOLDING_REGISTERS,
+                                 addr, num);
+      /* Queue the request. */
+      TbxMbClientReqSubmit(clientCtx, req);
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientCustomFunction(). It queues the request
+**            and returns immediately. The event task reports the completion of the
+**            request with the callback function.
+** \details   The "txPdu" and "rxPdu" parameters are pointers to the byte array of the
+**            PDU. The first byte (i.e. txPdu[0]) contains the function code, followed by
+**            its data bytes. When calling this function, set the "len" parameter to the
+**            length of the "txPdu". The request PDU is copied into the request, so the
+**            "txPdu" array can be reused right away. The "rxPdu" array and the "len"
+**            parameter must remain valid until the completion of the request. Upon
+**            successful completion, "rxPdu" holds the response PDU and "len" its length.
+**            Note that the response PDU can also be an exception response. The "len"
+**            parameter stays 0 for a broadcast request and if no response was received.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     txPdu Pointer to a byte array with the PDU to transmit.
+** \param     rxPdu Pointer to a byte array for the received response PDU. It should be
+**            able to hold TBX_MB_TP_PDU_MAX_LEN bytes.
+** \param     len Pointer to the PDU length, including the function code.
+** \param     doneFcn Function to call upon completion of the request (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the request was queued, TBX_ERROR otherwise.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunctionAsync(tTbxMbClient         channel,
+                                       uint8_t              node,
+                                       uint8_t      const * txPdu,
+                                       uint8_t            * rxPdu,
+                                       uint8_t            * len,
+                                       tTbxMbClientDone     doneFcn,
+                                       void               * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+             (rxPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+      (rxPdu != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Only continue with a valid packet length. It should at least have a PDU function
+     * code.
+     */
+    if ((*len > 0U) && (*len <= TBX_MB_TP_PDU_MAX_LEN))
+    {
+      /* Create the new request. */
+      tTbxMbClientReq * req = TbxMbClientReqCreate(node, txPdu[0], doneFcn, context);
+      /* Only continue if the request could be created. */
+      if (req != NULL)
+      {
+        /* Copy the request PDU data. */
+        req->dataLen = *len - 1U;
+        for (uint8_t idx = 0U; idx < req->dataLen; idx++)
+        {
+          req->pdu.data[idx] = txPdu[idx + 1U];
+        }
+        /* Store where to write the response PDU to. Its length stays zero, until a
+         * response is received.
+         */
+        *len = 0U;
+        req->values = rxPdu;
+        req->rawLen = len;
+        /* Invalidate the cached values that the request could change. Writes of coils
+         * and holding registers only change the written elements. Other function
+         * codes, except for reads, could change any element of the node.
+         */
+        uint16_t writeAddr = TbxMbCommonExtractUInt16BE(&req->pdu.data[0]);
+        uint16_t writeNum = TbxMbCommonExtractUInt16BE(&req->pdu.data[2]);
+        switch (req->pdu.code)
+        {
+          case TBX_MB_FC01_READ_COILS:
+          case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+          case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+          case TBX_MB_FC04_READ_INPUT_REGISTERS:
+          {
+            /* Nothing to invalidate, because reads do not change any elements. */
+          }
+          break;
+
+          case TBX_MB_FC05_WRITE_SINGLE_COIL:
+          {
+            TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC01_READ_COILS,
+                                       writeAddr, 1U);
+          }
+          break;
+
+          case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+          {
+            TbxMbClientCacheInvalidate(clientCtx, node, TBX_MB_FC01_READ_COILS,
+                                       writeAddr, writeNum);
+          }
+          break;
+
+          case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+          {
+            TbxMbClientCacheInvalidate(clientCtx, node,
+                                       TBX_MB_FC03_READ_HOLDING_REGISTERS, writeAddr,
+                                       1U);
+          }
+          break;
+
+          case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+          {
+            TbxMbClientCacheInvalidate(clientCtx, node,
+                                       TBX_MB_FC03_READ_HOLDING_REGISTERS, writeAddr,
+                                       writeNum);
+          }
+          break;
+
+          default:
+          {
+            TbxMbClientCacheInvalidate(clientCtx, node, 0U, 0U, 0U);
+          }
+          break;
+        }
+        /* Queue the request. */
+        TbxMbClientReqSubmit(clientCtx, req);
+        /* Update the result. */
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunctionAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Cancels the asynchronous requests that were submitted with the specified
+**            callback parameter. Useful when the callback parameter is about to become
+**            invalid. The requests still run their course, but without storing read
+**            values or a response PDU and without calling their completion callback.
+** \param     channel Handle to the Modbus client channel.
+** \param     context Parameter of the completion callback of the requests to cancel.
+**
+****************************************************************************************/
+void TbxMbClientCancel(tTbxMbClient         channel,
+                       void         const * context)
+{
+  /* Verify the parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Cancel the requests. */
+    TbxMbClientReqCancel(clientCtx, context);
+  }
+} /*** end of TbxMbClientCancel ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a poll group on the client channel. The scheduler of the client
+**            channel reads the elements of the poll group every period into a local
+**            value image, using asynchronous requests. The application obtains the
+**            values from the value image, together with their age. The scheduler runs
+**            the poll groups earliest deadline first. The deadline of a poll is the time
+**            of its next release.
+** \param     channel Handle to the Modbus client channel object.
+** \param     node The address of the server (1..247).
+** \param     code Function code for reading the elements. Either
+**            TBX_MB_FC01_READ_COILS, TBX_MB_FC02_READ_DISCRETE_INPUTS,
+**            TBX_MB_FC03_READ_HOLDING_REGISTERS or TBX_MB_FC04_READ_INPUT_REGISTERS.
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of elements to read. Range can be 1..2000 for coils and
+**            discrete inputs and 1..125 for registers.
+** \param     period Poll period in milliseconds.
+** \param     priority Priority of the poll group. For equal deadlines, the poll group
+**            with the higher priority value goes first.
+** \return    Handle to the newly created poll group if successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbClientPollGroup TbxMbClientPollGroupCreate(tTbxMbClient channel,
+                                                 uint8_t      node,
+                                                 uint8_t      code,
+                                                 uint16_t     addr,
+                                                 uint16_t     num,
+                                                 uint16_t     period,
+                                                 uint8_t      priority)
+{
+  tTbxMbClientPollGroup result = NULL;
+  uint16_t              numMax = 0U;
+  size_t                elemSize = sizeof(uint8_t);
+
+  /* Determine the maximum number of elements and the element size for the function
+   * code.
+   */
+  if ((code == TBX_MB_FC01_READ_COILS) || (code == TBX_MB_FC02_READ_DISCRETE_INPUTS))
+  {
+    numMax = 2000U;
+  }
+  else if ((code == TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
+           (code == TBX_MB_FC04_READ_INPUT_REGISTERS))
+  {
+    numMax = 125U;
+    elemSize = sizeof(uint16_t);
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= numMax) &&
+             (period > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= numMax) &&
+      (period > 0U))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Determine the size of the buffer that holds both the value image and the receive
+     * buffer.
+     */
+    size_t bufferSize = (size_t)num * elemSize * 2U;
+    /* Allocate memory for the new poll group context and its buffer. */
+    tTbxMbClientGroupCtx * newGroupCtx;
+    newGroupCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientGroupCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newGroupCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientGroupCtx));
+      newGroupCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientGroupCtx));
+    }
+    uint8_t * newBuffer = TbxMemPoolAllocate(bufferSize);
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newBuffer == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, bufferSize);
+      newBuffer = TbxMemPoolAllocate(bufferSize);
+    }
+    /* Verify memory allocation of the poll group context and its buffer. */
+    TBX_ASSERT((newGroupCtx != NULL) && (newBuffer != NULL));
+    /* Only continue if the memory allocation succeeded. */
+    if ((newGroupCtx != NULL) && (newBuffer != NULL))
+    {
+      /* Initialize the poll group context. The first poll is released right away. */
+      newGroupCtx->type = TBX_MB_CLIENT_GROUP_CONTEXT_TYPE;
+      newGroupCtx->clientCtx = clientCtx;
+      newGroupCtx->node = node;
+      newGroupCtx->code = code;
+      newGroupCtx->addr = addr;
+      newGroupCtx->num = num;
+      newGroupCtx->period = period;
+      newGroupCtx->priority = priority;
+      newGroupCtx->state = TBX_MB_CLIENT_GROUP_STATE_IDLE;
+      newGroupCtx->releaseMs = clientCtx->timeMs;
+      newGroupCtx->values = &newBuffer[0];
+      newGroupCtx->rxValues = &newBuffer[bufferSize / 2U];
+      newGroupCtx->valid = TBX_FALSE;
+      newGroupCtx->updateMs = 0U;
+      newGroupCtx->overruns = 0U;
+      /* Add it to the client's poll group list. */
+      TbxCriticalSectionEnter();
+      newGroupCtx->next = clientCtx->groupList;
+      clientCtx->groupList = newGroupCtx;
+      TbxCriticalSectionExit();
+      /* The scheduler runs from the polling function of the client channel. */
+      TbxMbClientStartPolling(clientCtx);
+      /* Update the result. */
+      result = newGroupCtx;
+    }
+    /* Memory allocation only partially succeeded. */
+    else
+    {
+      /* Give the allocated memory back to the memory pool. */
+      if (newGroupCtx != NULL)
+      {
+        TbxMemPoolRelease(newGroupCtx);
+      }
+      if (newBuffer != NULL)
+      {
+        TbxMemPoolRelease(newBuffer);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientPollGroupCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a poll group, previously created with
+**            TbxMbClientPollGroupCreate(). A read request of the poll group that is
+**            still in progress, completes without updating the value image.
+** \param     group Handle to the poll group to release.
+**
+****************************************************************************************/
+void TbxMbClientPollGroupFree(tTbxMbClientPollGroup group)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(group != NULL);
+
+  /* Only continue with valid parameters. */
+  if (group != NULL)
+  {
+    /* Convert the poll group pointer to the context structure. */
+    tTbxMbClientGroupCtx * groupCtx = (tTbxMbClientGroupCtx *)group;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(groupCtx->type == TBX_MB_CLIENT_GROUP_CONTEXT_TYPE);
+    tTbxMbClientCtx * clientCtx = groupCtx->clientCtx;
+    /* Remove it from the client's poll group list. */
+    TbxCriticalSectionEnter();
+    if (clientCtx->groupList == groupCtx)
+    {
+      clientCtx->groupList = groupCtx->next;
+    }
+    else
+    {
+      tTbxMbClientGroupCtx * prevGroup = clientCtx->groupList;
+      while ((prevGroup != NULL) && (prevGroup->next != groupCtx))
+      {
+        prevGroup = prevGroup->next;
+      }
+      if (prevGroup != NULL)
+      {
+        prevGroup->next = groupCtx->next;
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Make sure a read request in progress no longer accesses the poll group. */
+    if (groupCtx->state == TBX_MB_CLIENT_GROUP_STATE_BUSY)
+    {
+      TbxMbClientReqCancel(clientCtx, groupCtx);
+    }
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    groupCtx->type = 0U;
+    /* Give the poll group context and its buffer back to the memory pool. */
+    TbxMemPoolRelease(groupCtx->values);
+    TbxMemPoolRelease(groupCtx);
+  }
+} /*** end of TbxMbClientPollGroupFree ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the coil or discrete input values from the value image of the poll
+**            group.
+** \param     group Handle to the poll group.
+** \param     bits Pointer to array with at least as many elements as the poll group,
+**            where the TBX_ON / TBX_OFF values will be written to.
+** \param     age Pointer to where the time in milliseconds since the last update of the
+**            value image will be written to (optional).
+** \return    TBX_OK if successful, TBX_ERROR if the poll group does not read bits or
+**            if no values were read yet.
+**
+****************************************************************************************/
+uint8_t TbxMbClientPollGroupReadBits(tTbxMbClientPollGroup   group,
+                                     uint8_t               * bits,
+                                     uint32_t              * age)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((group != NULL) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((group != NULL) && (bits != NULL))
+  {
+    /* Convert the poll group pointer to the context structure. */
+    tTbxMbClientGroupCtx * groupCtx = (tTbxMbClientGroupCtx *)group;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(groupCtx->type == TBX_MB_CLIENT_GROUP_CONTEXT_TYPE);
+    uint8_t const * values = (uint8_t const *)groupCtx->values;
+    /* Only continue with a poll group that reads bits. */
+    if ((groupCtx->code == TBX_MB_FC01_READ_COILS) ||
+        (groupCtx->code == TBX_MB_FC02_READ_DISCRETE_INPUTS))
+    {
+      /* Copy the value image, such that the scheduler cannot update it halfway. */
+      TbxCriticalSectionEnter();
+      if (groupCtx->valid == TBX_TRUE)
+      {
+        for (uint16_t idx = 0U; idx < groupCtx->num; idx++)
+        {
+          bits[idx] = values[idx];
+        }
+        /* Determine the age of the values, if requested. */
+        if (age != NULL)
+        {
+          *age = groupCtx->clientCtx->timeMs - groupCtx->updateMs;
+        }
+        result = TBX_OK;
+      }
+      TbxCriticalSectionExit();
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientPollGroupReadBits ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the register values from the value image of the poll group.
+** \param     group Handle to the poll group.
+** \param     regs Pointer to array with at least as many elements as the poll group,
+**            where the register values will be written to.
+** \param     age Pointer to where the time in milliseconds since the last update of the
+**            value image will be written to (optional).
+** \return    TBX_OK if successful, TBX_ERROR if the poll group does not read registers
+**            or if no values were read yet.
+**
+****************************************************************************************/
+uint8_t TbxMbClientPollGroupReadRegs(tTbxMbClientPollGroup   group,
+                                     uint16_t              * regs,
+                                     uint32_t              * age)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((group != NULL) && (regs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((group != NULL) && (regs != NULL))
+  {
+    /* Convert the poll group pointer to the context structure. */
+    tTbxMbClientGroupCtx * groupCtx = (tTbxMbClientGroupCtx *)group;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(groupCtx->type == TBX_MB_CLIENT_GROUP_CONTEXT_TYPE);
+    uint16_t const * values = (uint16_t const *)groupCtx->values;
+    /* Only continue with a poll group that reads registers. */
+    if ((groupCtx->code == TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
+        (groupCtx->code == TBX_MB_FC04_READ_INPUT_REGISTERS))
+    {
+      /* Copy the value image, such that the scheduler cannot update it halfway. */
+      TbxCriticalSectionEnter();
+      if (groupCtx->valid == TBX_TRUE)
+      {
+        for (uint16_t idx = 0U; idx < groupCtx->num; idx++)
+        {
+          regs[idx] = values[idx];
+        }
+        /* Determine the age of the values, if requested. */
+        if (age != NULL)
+        {
+          *age = groupCtx->clientCtx->timeMs - groupCtx->updateMs;
+        }
+        result = TBX_OK;
+      }
+      TbxCriticalSectionExit();
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientPollGroupReadRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of overruns of the poll group. An overrun happens each
+**            time a poll is due, while the previous poll did not yet complete. A
+**            steadily increasing number means that the bus cannot keep up with the
+**            configured poll load.
+** \param     group Handle to the poll group.
+** \return    Number of overruns.
+**
+****************************************************************************************/
+uint32_t TbxMbClientPollGroupOverruns(tTbxMbClientPollGroup group)
+{
+  uint32_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(group != NULL);
+
+  /* Only continue with valid parameters. */
+  if (group != NULL)
+  {
+    /* Convert the poll group pointer to the context structure. */
+    tTbxMbClientGroupCtx * groupCtx = (tTbxMbClientGroupCtx *)group;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(groupCtx->type == TBX_MB_CLIENT_GROUP_CONTEXT_TYPE);
+    /* Update the result. */
+    result = groupCtx->overruns;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientPollGroupOverruns ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of coils from the server with the specified node address.
+**            The range can hold more coils than fit in a single request. The client
+**            automatically splits it into multiple requests, with at most 2000 coils
+**            each. These are issued one after the other and the function returns once
+**            all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. The range must
+**            stay within the data table, so addr + num can be at most 65536.
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were read before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were read, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoilsRange(tTbxMbClient   channel,
+                                  uint8_t        node,
+                                  uint16_t       addr,
+                                  uint32_t       num,
+                                  uint8_t      * coils,
+                                  uint32_t     * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (coils != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node, TBX_MB_FC01_READ_COILS, addr, num,
+                              coils, NULL, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoilsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of discrete inputs from the server with the specified node
+**            address. The range can hold more discrete inputs than fit in a single
+**            request. The client automatically splits it into multiple requests, with
+**            at most 2000 discrete inputs each. These are issued one after the other
+**            and the function returns once all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were read before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were read, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputsRange(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t       addr,
+                                   uint32_t       num,
+                                   uint8_t      * inputs,
+                                   uint32_t     * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (inputs != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node, TBX_MB_FC02_READ_DISCRETE_INPUTS, addr, num,
+                              inputs, NULL, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of input registers from the server with the specified node
+**            address. The range can hold more input registers than fit in a single
+**            request. The client automatically splits it into multiple requests, with
+**            at most 125 input registers each. These are issued one after the other and
+**            the function returns once all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were read before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were read, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegsRange(tTbxMbClient   channel,
+                                      uint8_t        node,
+                                      uint16_t       addr,
+                                      uint32_t       num,
+                                      uint16_t     * inputRegs,
+                                      uint32_t     * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (inputRegs != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node, TBX_MB_FC04_READ_INPUT_REGISTERS, addr, num,
+                              inputRegs, NULL, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of holding registers from the server with the specified node
+**            address. The range can hold more holding registers than fit in a single
+**            request. The client automatically splits it into multiple requests, with
+**            at most 125 holding registers each. These are issued one after the other
+**            and the function returns once all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were read before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were read, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegsRange(tTbxMbClient   channel,
+                                        uint8_t        node,
+                                        uint16_t       addr,
+                                        uint32_t       num,
+                                        uint16_t     * holdingRegs,
+                                        uint32_t     * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (holdingRegs != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node,
+                              TBX_MB_FC03_READ_HOLDING_REGISTERS, addr, num,
+                              holdingRegs, NULL, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadHoldingRegsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of coils to the server with the specified node address. The
+**            range can hold more coils than fit in a single request. The client
+**            automatically splits it into multiple requests, with at most 1968 coils
+**            each. These are issued one after the other and the function returns once
+**            all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. The range must
+**            stay within the data table, so addr + num can be at most 65536.
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were written before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were written, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoilsRange(tTbxMbClient    channel,
+                                   uint8_t         node,
+                                   uint16_t        addr,
+                                   uint32_t        num,
+                                   uint8_t const * coils,
+                                   uint32_t      * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (coils != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node, TBX_MB_FC15_WRITE_MULTIPLE_COILS, addr, num,
+                              NULL, coils, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoilsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of holding registers to the server with the specified node
+**            address. The range can hold more holding registers than fit in a single
+**            request. The client automatically splits it into multiple requests, with
+**            at most 123 holding registers each. These are issued one after the other
+**            and the function returns once all completed or one failed.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     holdingRegs Pointer to array with the desired holding register values.
+** \param     numDone Pointer to where the number of elements, counting from the start of
+**            the range, that were written before the first failed request is written to
+**            (optional).
+** \return    TBX_OK if all elements were written, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteHoldingRegsRange(tTbxMbClient     channel,
+                                         uint8_t          node,
+                                         uint16_t         addr,
+                                         uint32_t         num,
+                                         uint16_t const * holdingRegs,
+                                         uint32_t       * numDone)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (holdingRegs != NULL))
+  {
+    /* Transfer the range with blocking requests. */
+    result = TbxMbClientRange(channel, node,
+                              TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS, addr, num,
+                              NULL, holdingRegs, numDone);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegsRange ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadCoilsRange(). It queues all the
+**            requests that the range is split into and returns immediately. This way
+**            the requests are pipelined, if the window of the channel allows multiple
+**            requests to await a response (see TbxMbClientSetWindow()). The event task
+**            reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. The range must
+**            stay within the data table, so addr + num can be at most 65536.
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to. It must stay valid until the range completes.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoilsRangeAsync(tTbxMbClient            channel,
+                                       uint8_t                 node,
+                                       uint16_t                addr,
+                                       uint32_t                num,
+                                       uint8_t               * coils,
+                                       tTbxMbClientRangeDone   doneFcn,
+                                       void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (coils != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node, TBX_MB_FC01_READ_COILS, addr, num,
+                                   coils, NULL, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoilsRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadInputsRange(). It queues all the
+**            requests that the range is split into and returns immediately. This way
+**            the requests are pipelined, if the window of the channel allows multiple
+**            requests to await a response (see TbxMbClientSetWindow()). The event task
+**            reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to. It must stay valid until the range
+**            completes.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputsRangeAsync(tTbxMbClient            channel,
+                                        uint8_t                 node,
+                                        uint16_t                addr,
+                                        uint32_t                num,
+                                        uint8_t               * inputs,
+                                        tTbxMbClientRangeDone   doneFcn,
+                                        void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (inputs != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node,
+                                   TBX_MB_FC02_READ_DISCRETE_INPUTS, addr, num,
+                                   inputs, NULL, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputsRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadInputRegsRange(). It queues all the
+**            requests that the range is split into and returns immediately. This way
+**            the requests are pipelined, if the window of the channel allows multiple
+**            requests to await a response (see TbxMbClientSetWindow()). The event task
+**            reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to. It must stay valid until the range completes.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegsRangeAsync(tTbxMbClient            channel,
+                                           uint8_t                 node,
+                                           uint16_t                addr,
+                                           uint32_t                num,
+                                           uint16_t              * inputRegs,
+                                           tTbxMbClientRangeDone   doneFcn,
+                                           void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (inputRegs != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node,
+                                   TBX_MB_FC04_READ_INPUT_REGISTERS, addr, num,
+                                   inputRegs, NULL, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegsRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientReadHoldingRegsRange(). It queues all
+**            the requests that the range is split into and returns immediately. This
+**            way the requests are pipelined, if the window of the channel allows
+**            multiple requests to await a response (see TbxMbClientSetWindow()). The
+**            event task reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to. It must stay valid until the range completes.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegsRangeAsync(tTbxMbClient            channel,
+                                             uint8_t                 node,
+                                             uint16_t                addr,
+                                             uint32_t                num,
+                                             uint16_t              * holdingRegs,
+                                             tTbxMbClientRangeDone   doneFcn,
+                                             void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (holdingRegs != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node,
+                                   TBX_MB_FC03_READ_HOLDING_REGISTERS, addr, num,
+                                   holdingRegs, NULL, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadHoldingRegsRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientWriteCoilsRange(). It queues all the
+**            requests that the range is split into and returns immediately. This way
+**            the requests are pipelined, if the window of the channel allows multiple
+**            requests to await a response (see TbxMbClientSetWindow()). The event task
+**            reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. The range must
+**            stay within the data table, so addr + num can be at most 65536.
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values. The
+**            values are copied into the requests, so the array can be reused right away.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoilsRangeAsync(tTbxMbClient            channel,
+                                        uint8_t                 node,
+                                        uint16_t                addr,
+                                        uint32_t                num,
+                                        uint8_t const         * coils,
+                                        tTbxMbClientRangeDone   doneFcn,
+                                        void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (coils != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node,
+                                   TBX_MB_FC15_WRITE_MULTIPLE_COILS, addr, num,
+                                   NULL, coils, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoilsRangeAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientWriteHoldingRegsRange(). It queues all
+**            the requests that the range is split into and returns immediately. This
+**            way the requests are pipelined, if the window of the channel allows
+**            multiple requests to await a response (see TbxMbClientSetWindow()). The
+**            event task reports the completion of the range with the callback function.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. The
+**            range must stay within the data table, so addr + num can be at most 65536.
+** \param     holdingRegs Pointer to array with the desired holding register values. The
+**            values are copied into the requests, so the array can be reused right away.
+** \param     doneFcn Function to call upon completion of the range (optional).
+** \param     context Parameter to pass on to the doneFcn callback function.
+** \return    TBX_OK if the requests were queued, TBX_ERROR otherwise. If just the first
+**            part of the requests could be queued, TBX_OK is returned and the callback
+**            function reports the failure.
+** \attention A blocking request on the same channel goes ahead of the queued
+**            asynchronous requests, once the ones in progress completed.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteHoldingRegsRangeAsync(tTbxMbClient            channel,
+                                              uint8_t                 node,
+                                              uint16_t                addr,
+                                              uint32_t                num,
+                                              uint16_t const        * holdingRegs,
+                                              tTbxMbClientRangeDone   doneFcn,
+                                              void                  * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= (65536UL - addr)) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= (65536UL - addr)) && (holdingRegs != NULL))
+  {
+    /* Queue the requests of the range. */
+    result = TbxMbClientRangeAsync(channel, node,
+                                   TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS, addr, num,
+                                   NULL, holdingRegs, doneFcn, context);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegsRangeAsync ***/
 
 
 /*********************************** end of tbxmb_client.c *****************************/
@@ -34,6 +34,16 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Node state where the node responds to requests. */
+#define TBX_MB_CLIENT_NODE_STATE_UP         (0U)
+
+/** \brief Node state where the node stopped responding to requests. */
+#define TBX_MB_CLIENT_NODE_STATE_DOWN       (1U)
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -43,6 +53,73 @@ extern "C" {
 typedef void * tTbxMbClient;
 
 
+/** \brief Handle to a poll group of a Modbus client channel, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbClientPollGroup;
+
+
+/** \brief Block of registers in a file record, used for reading and writing file
+ *         records with function codes 20 and 21. The block can be larger than what fits
+ *         in a single PDU. The client automatically splits it into multiple
+ *         sub-requests.
+ */
+typedef struct
+{
+  uint16_t   fileNum;                            /**< File number (1..65535).          */
+  uint16_t   recordNum;                          /**< Record number (0..9999).         */
+  uint16_t   recordLen;                          /**< Number of registers.             */
+  uint16_t * data;                               /**< Register values.                 */
+} tTbxMbClientFileRecord;
+
+
+/** \brief Statistics of the read cache of a client channel. Only reads of elements that
+ *         lie within a cached range count as a hit or a miss. The hit ratio is
+ *         hits / (hits + misses).
+ */
+typedef struct
+{
+  uint32_t   hits;                               /**< Reads served from the cache.     */
+  uint32_t   misses;                             /**< Cacheable reads that used the bus*/
+  uint32_t   savedMs;                            /**< Estimated bus time saved (ms).   */
+} tTbxMbClientCacheStats;
+
+
+/** \brief Callback function that reports the completion of an asynchronous request.
+ *         The result is TBX_OK if a valid response was received, TBX_ERROR otherwise.
+ *         It is called from the context of TbxMbEventTask().
+ */
+typedef void (* tTbxMbClientDone)(tTbxMbClient channel,
+                                  uint8_t      result,
+                                  void       * context);
+
+
+/** \brief Callback function that reports the completion of an asynchronous range
+ *         request. The result is TBX_OK if all elements of the range were transferred,
+ *         TBX_ERROR otherwise. In both cases, numDone holds the number of elements,
+ *         counting from the start of the range, that were transferred before the first
+ *         failed request. The requests that were still queued at that point are
+ *         cancelled. Requests that were already in progress might still have
+ *         transferred elements beyond numDone. It is called from the context of
+ *         TbxMbEventTask().
+ */
+typedef void (* tTbxMbClientRangeDone)(tTbxMbClient channel,
+                                       uint8_t      result,
+                                       uint32_t     numDone,
+                                       void       * context);
+
+
+/** \brief Callback function that reports a state change of a node, if node health
+ *         tracking is enabled. The state is either TBX_MB_CLIENT_NODE_STATE_UP or
+ *         TBX_MB_CLIENT_NODE_STATE_DOWN. It is called from the context that detected the
+ *         state change: TbxMbEventTask() for asynchronous requests and the calling task
+ *         for blocking requests.
+ */
+typedef void (* tTbxMbClientNodeStateChange)(tTbxMbClient channel,
+                                             uint8_t      node,
+                                             uint8_t      state);
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -52,6 +129,41 @@ tTbxMbClient TbxMbClientCreate          (tTbxMbTp             transport,
 
 void         TbxMbClientFree            (tTbxMbClient         channel);
 
+void         TbxMbClientSetWindow       (tTbxMbClient         channel,
+                                         uint8_t              window);
+
+void         TbxMbClientSetCoalescing   (tTbxMbClient         channel,
+                                         uint8_t              enable,
+                                         uint16_t             gapMax);
+
+uint8_t      TbxMbClientSetAdaptiveTimeout(tTbxMbClient       channel,
+                                           uint8_t            enable,
+                                           uint16_t           timeoutMin,
+                                           uint16_t           timeoutMax);
+
+uint16_t     TbxMbClientNodeTimeout     (tTbxMbClient         channel,
+                                         uint8_t              node);
+
+uint8_t      TbxMbClientSetNodeHealth   (tTbxMbClient         channel,
+                                         uint8_t              enable,
+                                         uint8_t              failMax,
+                                         uint16_t             probeMin,
+                                         uint16_t             probeMax,
+                                         tTbxMbClientNodeStateChange stateChangeFcn);
+
+uint8_t      TbxMbClientNodeState       (tTbxMbClient         channel,
+                                         uint8_t              node);
+
+uint8_t      TbxMbClientCacheAdd        (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint8_t              code,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint16_t             ttl);
+
+void         TbxMbClientCacheGetStats   (tTbxMbClient         channel,
+                                         tTbxMbClientCacheStats * stats);
+
 uint8_t      TbxMbClientReadCoils       (tTbxMbClient         channel,
                                          uint8_t              node,
                                          uint16_t             addr,
@@ -93,12 +205,222 @@ uint8_t      TbxMbClientDiagnostics     (tTbxMbClient         channel,
                                          uint16_t             subcode,
                                          uint16_t           * count);
 
+uint8_t      TbxMbClientGetCommEventCounter(tTbxMbClient      channel,
+                                            uint8_t           node,
+                                            uint16_t        * status,
+                                            uint16_t        * count);
+
+uint8_t      TbxMbClientGetCommEventLog (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t           * status,
+                                         uint16_t           * eventCount,
+                                         uint16_t           * msgCount,
+                                         uint8_t            * events,
+                                         uint8_t            * num);
+
+uint8_t      TbxMbClientReportServerId  (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint8_t            * data,
+                                         uint8_t            * len);
+
+uint8_t      TbxMbClientReadDeviceId    (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint8_t              code,
+                                         uint8_t              objectId,
+                                         uint8_t            * objects,
+                                         uint16_t           * len);
+
+uint8_t      TbxMbClientReadFileRecords (tTbxMbClient                   channel,
+                                         uint8_t                        node,
+                                         tTbxMbClientFileRecord const * records,
+                                         uint8_t                        num);
+
+uint8_t      TbxMbClientWriteFileRecords(tTbxMbClient                   channel,
+                                         uint8_t                        node,
+                                         tTbxMbClientFileRecord const * records,
+                                         uint8_t                        num);
+
+uint8_t      TbxMbClientReadFifo        (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t           * values,
+                                         uint8_t            * count);
+
 uint8_t      TbxMbClientCustomFunction  (tTbxMbClient         channel,
                                          uint8_t              node,
                                          uint8_t      const * txPdu,
                                          uint8_t            * rxPdu,
                                          uint8_t            * len);
 
+uint8_t      TbxMbClientReadCoilsAsync  (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t            * coils,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * context);
+
+uint8_t      TbxMbClientReadInputsAsync (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t            * inputs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * context);
+
+uint8_t      TbxMbClientReadInputRegsAsync(tTbxMbClient       channel,
+                                           uint8_t            node,
+                                           uint16_t           addr,
+                                           uint8_t            num,
+                                           uint16_t         * inputRegs,
+                                           tTbxMbClientDone   doneFcn,
+                                           void             * context);
+
+uint8_t      TbxMbClientReadHoldingRegsAsync(tTbxMbClient     channel,
+                                             uint8_t          node,
+                                             uint16_t         addr,
+                                             uint8_t          num,
+                                             uint16_t       * holdingRegs,
+                                             tTbxMbClientDone doneFcn,
+                                             void           * context);
+
+uint8_t      TbxMbClientWriteCoilsAsync (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t      const * coils,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * context);
+
+uint8_t      TbxMbClientWriteHoldingRegsAsync(tTbxMbClient         channel,
+                                              uint8_t              node,
+                                              uint16_t             addr,
+                                              uint8_t              num,
+                                              uint16_t     const * holdingRegs,
+                                              tTbxMbClientDone     doneFcn,
+                                              void               * context);
+
+uint8_t      TbxMbClientCustomFunctionAsync(tTbxMbClient         channel,
+                                            uint8_t              node,
+                                            uint8_t      const * txPdu,
+                                            uint8_t            * rxPdu,
+                                            uint8_t            * len,
+                                            tTbxMbClientDone     doneFcn,
+                                            void               * context);
+
+void         TbxMbClientCancel          (tTbxMbClient         channel,
+                                         void         const * context);
+
+tTbxMbClientPollGroup TbxMbClientPollGroupCreate(tTbxMbClient channel,
+                                                 uint8_t      node,
+                                                 uint8_t      code,
+                                                 uint16_t     addr,
+                                                 uint16_t     num,
+                                                 uint16_t     period,
+                                                 uint8_t      priority);
+
+void         TbxMbClientPollGroupFree   (tTbxMbClientPollGroup group);
+
+uint8_t      TbxMbClientPollGroupReadBits(tTbxMbClientPollGroup   group,
+                                          uint8_t               * bits,
+                                          uint32_t              * age);
+
+uint8_t      TbxMbClientPollGroupReadRegs(tTbxMbClientPollGroup   group,
+                                          uint16_t              * regs,
+                                          uint32_t              * age);
+
+uint32_t     TbxMbClientPollGroupOverruns(tTbxMbClientPollGroup group);
+
+uint8_t      TbxMbClientReadCoilsRange(tTbxMbClient channel,
+                                       uint8_t      node,
+                                       uint16_t     addr,
+                                       uint32_t     num,
+                                       uint8_t    * coils,
+                                       uint32_t   * numDone);
+
+uint8_t      TbxMbClientReadInputsRange(tTbxMbClient channel,
+                                        uint8_t      node,
+                                        uint16_t     addr,
+                                        uint32_t     num,
+                                        uint8_t    * inputs,
+                                        uint32_t   * numDone);
+
+uint8_t      TbxMbClientReadInputRegsRange(tTbxMbClient channel,
+                                           uint8_t      node,
+                                           uint16_t     addr,
+                                           uint32_t     num,
+                                           uint16_t   * inputRegs,
+                                           uint32_t   * numDone);
+
+uint8_t      TbxMbClientReadHoldingRegsRange(tTbxMbClient channel,
+                                             uint8_t      node,
+                                             uint16_t     addr,
+                                             uint32_t     num,
+                                             uint16_t   * holdingRegs,
+                                             uint32_t   * numDone);
+
+uint8_t      TbxMbClientWriteCoilsRange(tTbxMbClient    channel,
+                                        uint8_t         node,
+                                        uint16_t        addr,
+                                        uint32_t        num,
+                                        uint8_t const * coils,
+                                        uint32_t      * numDone);
+
+uint8_t      TbxMbClientWriteHoldingRegsRange(tTbxMbClient     channel,
+                                              uint8_t          node,
+                                              uint16_t         addr,
+                                              uint32_t         num,
+                                              uint16_t const * holdingRegs,
+                                              uint32_t       * numDone);
+
+uint8_t      TbxMbClientReadCoilsRangeAsync(tTbxMbClient          channel,
+                                            uint8_t               node,
+                                            uint16_t              addr,
+                                            uint32_t              num,
+                                            uint8_t             * coils,
+                                            tTbxMbClientRangeDone doneFcn,
+                                            void                * context);
+
+uint8_t      TbxMbClientReadInputsRangeAsync(tTbxMbClient          channel,
+                                             uint8_t               node,
+                                             uint16_t              addr,
+                                             uint32_t              num,
+                                             uint8_t             * inputs,
+                                             tTbxMbClientRangeDone doneFcn,
+                                             void                * context);
+
+uint8_t      TbxMbClientReadInputRegsRangeAsync(tTbxMbClient          channel,
+                                                uint8_t               node,
+                                                uint16_t              addr,
+                                                uint32_t              num,
+                                                uint16_t            * inputRegs,
+                                                tTbxMbClientRangeDone doneFcn,
+                                                void                * context);
+
+uint8_t      TbxMbClientReadHoldingRegsRangeAsync(tTbxMbClient          channel,
+                                                  uint8_t               node,
+                                                  uint16_t              addr,
+                                                  uint32_t              num,
+                                                  uint16_t            * holdingRegs,
+                                                  tTbxMbClientRangeDone doneFcn,
+                                                  void                * context);
+
+uint8_t      TbxMbClientWriteCoilsRangeAsync(tTbxMbClient          channel,
+                                             uint8_t               node,
+                                             uint16_t              addr,
+                                             uint32_t              num,
+                                             uint8_t       const * coils,
+                                             tTbxMbClientRangeDone doneFcn,
+                                             void                * context);
+
+uint8_t      TbxMbClientWriteHoldingRegsRangeAsync(tTbxMbClient          channel,
+                                                   uint8_t               node,
+                                                   uint16_t              addr,
+                                                   uint32_t              num,
+                                                   uint16_t      const * holdingRegs,
+                                                   tTbxMbClientRangeDone doneFcn,
+                                                   void                * context);
+
 
 #ifdef __cplusplus
 }
@@ -47,10 +47,139 @@ typedef void (* tTbxMbClientPoll)   (void        * context);
 typedef void (* tTbxMbClientProcess)(tTbxMbEvent * event);
 
 
+/** \brief Asynchronous request of a client channel. It holds a copy of the request PDU.
+ *         Read requests store the values of the response in the application's array,
+ *         upon completion. Custom function code requests store the entire response PDU,
+ *         which can also be an exception response. The transaction identifier matches a
+ *         response to its request, while multiple requests await a response.
+ */
+typedef struct t_tbx_mb_client_req
+{
+  uint8_t                      node;             /**< Node address of the server.      */
+  uint8_t                      dataLen;          /**< Request PDU data length.         */
+  tTbxMbTpPdu                  pdu;              /**< Request PDU.                     */
+  uint16_t                     num;              /**< Number of elements.              */
+  void                       * values;           /**< Array for read values.           */
+  uint8_t                    * rawLen;           /**< Response PDU length (custom).    */
+  tTbxMbClientDone             doneFcn;          /**< Completion callback (optional).  */
+  void                       * doneContext;      /**< Parameter for the callback.      */
+  uint16_t                     transId;          /**< Transaction identifier.          */
+  uint8_t                      state;            /**< Request state.                   */
+  uint32_t                     startMs;          /**< Start time of the state.         */
+  uint16_t                     cacheGen;         /**< Cache generation when queued.    */
+  struct t_tbx_mb_client_req * members;          /**< Requests covered by this one.    */
+  struct t_tbx_mb_client_req * next;             /**< Next request in the queue.       */
+} tTbxMbClientReq;
+
+
+/** \brief Poll group context. It's what the tTbxMbClientPollGroup opaque pointer points
+ *         to. The scheduler releases a poll of the group each period. The deadline of a
+ *         released poll is the next release time. Of all released polls, the one with
+ *         the earliest deadline goes on the bus first. The response is read into the
+ *         receive buffer first and then copied to the value image, such that the
+ *         application never reads a partially updated value image.
+ */
+typedef struct t_tbx_mb_client_group_ctx
+{
+  uint8_t                            type;       /**< Context type.                    */
+  struct t_tbx_mb_client_ctx       * clientCtx;  /**< Client channel of the group.     */
+  uint8_t                            node;       /**< Node address of the server.      */
+  uint8_t                            code;       /**< Function code of the reads.      */
+  uint16_t                           addr;       /**< Address of the first element.    */
+  uint16_t                           num;        /**< Number of elements.              */
+  uint16_t                           period;     /**< Poll period (ms).                */
+  uint8_t                            priority;   /**< Priority for equal deadlines.    */
+  uint8_t                            state;      /**< Poll state.                      */
+  uint32_t                           releaseMs;  /**< Time of the next release.        */
+  void                             * values;     /**< Value image.                     */
+  void                             * rxValues;   /**< Receive buffer.                  */
+  uint8_t                   volatile valid;      /**< Value image holds read values.   */
+  uint32_t                  volatile updateMs;   /**< Time of the last update.         */
+  uint32_t                  volatile overruns;   /**< Number of missed polls.          */
+  struct t_tbx_mb_client_group_ctx * next;       /**< Next poll group of the channel.  */
+} tTbxMbClientGroupCtx;
+
+
+/** \brief Asynchronous range request. The range is split into chunks that each fit in
+ *         a single request. All chunks are queued at once, such that they can be
+ *         pipelined. The range request completes once all its chunks completed. Only the
+ *         elements before the first failed chunk count as transferred. The chunks that
+ *         are still queued at that point, are cancelled.
+ */
+typedef struct
+{
+  tTbxMbClientRangeDone              doneFcn;    /**< Completion callback (optional).  */
+  void                             * doneContext; /**< Parameter for the callback.     */
+  uint32_t                           num;        /**< Number of elements of the range. */
+  uint32_t                           numDone;    /**< Offset of the first failed chunk.*/
+  uint16_t                           chunksLeft; /**< Chunks yet to complete.          */
+} tTbxMbClientRangeCtx;
+
+
+/** \brief Chunk of an asynchronous range request. */
+typedef struct
+{
+  tTbxMbClientRangeCtx             * rangeCtx;   /**< Range request of the chunk.      */
+  uint32_t                           offset;     /**< Offset of the chunk in the range.*/
+} tTbxMbClientRangeChunk;
+
+
+/** \brief Round trip time statistics of a node, from which its response timeout is
+ *         derived. Just like the retransmission timer of TCP, the smoothed round trip
+ *         time and its mean deviation are exponentially weighted moving averages. They
+ *         are stored in fixed point, scaled by 8 and 4, respectively. Each response
+ *         timeout doubles the timeout of the node, until the next measurement.
+ */
+typedef struct
+{
+  uint16_t                           srtt;       /**< Smoothed round trip time (ms*8). */
+  uint16_t                           rttVar;     /**< Mean deviation (ms*4).           */
+  uint8_t                            valid;      /**< TBX_TRUE once measured.          */
+  uint8_t                            backoff;    /**< Timeout doublings.               */
+} tTbxMbClientNodeRtt;
+
+
+/** \brief Health of a node. After a number of consecutive response timeouts, the node
+ *         goes down. Requests to a node that is down fail right away, without using the
+ *         bus. Only when its probe is due, a single request goes on the bus to probe the
+ *         node. The interval between probes doubles with each failed probe. The node is
+ *         up again, once it responds.
+ */
+typedef struct
+{
+  uint8_t                            state;      /**< Node state (up/down).            */
+  uint8_t                            failures;   /**< Consecutive response timeouts.   */
+  uint8_t                            probing;    /**< TBX_TRUE while probing.          */
+  uint16_t                           probeDelay; /**< Interval between probes (ms).    */
+  uint32_t                           probeMs;    /**< Time of the next probe.          */
+} tTbxMbClientNodeHealth;
+
+
+/** \brief Entry of the read cache. It holds the data of a range of elements, in the
+ *         format of a read response: Packed bits or big endian registers. A read that
+ *         covers the entire range fills the entry. Reads within the range are then
+ *         served from the entry, until its time to live passed or until a write to the
+ *         range invalidates it.
+ */
+typedef struct t_tbx_mb_client_cache_entry
+{
+  uint8_t                              node;     /**< Node address of the server.      */
+  uint8_t                              code;     /**< Function code of the reads.      */
+  uint16_t                             addr;     /**< Address of the first element.    */
+  uint16_t                             num;      /**< Number of elements.              */
+  uint16_t                             ttl;      /**< Time to live (ms).               */
+  uint8_t                              valid;    /**< Entry holds read data.           */
+  uint32_t                             fillMs;   /**< Time of the last fill.           */
+  uint16_t                             busMs;    /**< Bus time of the last fill (ms).  */
+  uint8_t                            * data;     /**< Read data in response format.    */
+  struct t_tbx_mb_client_cache_entry * next;     /**< Next cache entry of the channel. */
+} tTbxMbClientCacheEntry;
+
+
 /** \brief Modbus client channel layer context that groups all channel specific data. 
  *         It's what the tTbxMbClient opaque pointer points to.
  */
-typedef struct
+typedef struct t_tbx_mb_client_ctx
 {
   /* Event interface methods. The following three entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
@@ -65,6 +194,35 @@ typedef struct
   uint16_t             responseTimeout;          /**< Maximum response wait time (ms). */
   uint16_t             turnaroundDelay;          /**< Delay (ms) after broadcast PDU.  */
   tTbxMbOsalSem        transceiveSem;            /**< PDU transmit/receive semaphore.  */
+  uint8_t     volatile syncActive;               /**< Blocking request in progress.    */
+  uint8_t     volatile syncWaiting;              /**< Blocking requests waiting.       */
+  tTbxMbClientReq    * reqHead;                  /**< First queued async request.      */
+  tTbxMbClientReq    * reqTail;                  /**< Last queued async request.       */
+  tTbxMbClientReq    * reqTransmit;              /**< Async request being transmitted. */
+  tTbxMbClientReq    * reqSent;                  /**< Requests awaiting a response.    */
+  uint8_t              reqSentNum;               /**< Number of requests in reqSent.   */
+  uint8_t              reqWindow;                /**< Max requests awaiting a response.*/
+  uint16_t             reqTransId;               /**< Next transaction identifier.     */
+  uint8_t              reqPolling;               /**< TBX_TRUE while being polled.     */
+  uint16_t             tickTime;                 /**< Last millisecond tick time.      */
+  uint32_t    volatile timeMs;                   /**< Millisecond time of the channel. */
+  tTbxMbClientGroupCtx * groupList;              /**< Linked list with poll groups.    */
+  uint8_t              coalesce;                 /**< Merge neighboring reads.         */
+  uint16_t             coalesceGap;              /**< Max elements between merged reads*/
+  tTbxMbClientNodeRtt * nodeRtt;                 /**< Per node RTT (NULL = unused).    */
+  uint8_t              adaptive;                 /**< Adaptive response timeouts.      */
+  uint16_t             timeoutMin;               /**< Min adaptive response timeout.   */
+  uint16_t             timeoutMax;               /**< Max adaptive response timeout.   */
+  tTbxMbClientNodeHealth * nodeHealth;           /**< Node health (NULL = unused).     */
+  uint8_t              health;                   /**< Node health tracking.            */
+  uint8_t              nodesDown;                /**< Number of nodes that are down.   */
+  uint8_t              failMax;                  /**< Timeouts before a node is down.  */
+  uint16_t             probeMin;                 /**< Min interval between probes.     */
+  uint16_t             probeMax;                 /**< Max interval between probes.     */
+  tTbxMbClientNodeStateChange stateChangeFcn;    /**< Node state change callback.      */
+  tTbxMbClientCacheEntry * cacheList;            /**< Linked list with cache entries.  */
+  uint16_t             cacheGen;                 /**< Incremented by invalidations.    */
+  tTbxMbClientCacheStats cacheStats;             /**< Read cache statistics.           */
 } tTbxMbClientCtx;
 
 
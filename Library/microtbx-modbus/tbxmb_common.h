@@ -59,12 +59,33 @@ extern "C" {
 /** \brief Modbus function code 08 - Diagnostics. */
 #define TBX_MB_FC08_DIAGNOSTICS                       (8U)
 
+/** \brief Modbus function code 11 - Get Comm Event Counter. */
+#define TBX_MB_FC11_GET_COMM_EVENT_COUNTER            (11U)
+
+/** \brief Modbus function code 12 - Get Comm Event Log. */
+#define TBX_MB_FC12_GET_COMM_EVENT_LOG                (12U)
+
 /** \brief Modbus function code 15 - Write Multiple Coils. */
 #define TBX_MB_FC15_WRITE_MULTIPLE_COILS              (15U)
 
 /** \brief Modbus function code 16 - Write Multiple Registers. */
 #define TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS          (16U)
 
+/** \brief Modbus function code 17 - Report Server ID. */
+#define TBX_MB_FC17_REPORT_SERVER_ID                  (17U)
+
+/** \brief Modbus function code 20 - Read File Record. */
+#define TBX_MB_FC20_READ_FILE_RECORD                  (20U)
+
+/** \brief Modbus function code 21 - Write File Record. */
+#define TBX_MB_FC21_WRITE_FILE_RECORD                 (21U)
+
+/** \brief Modbus function code 24 - Read FIFO Queue. */
+#define TBX_MB_FC24_READ_FIFO_QUEUE                   (24U)
+
+/** \brief Modbus function code 43 - Encapsulated Interface Transport. */
+#define TBX_MB_FC43_ENCAPSULATED_INTERFACE            (43U)
+
 
 /* ------------------------- Exception codes ----------------------------------------- */
 /** \brief Modbus exception code 01 - Illegal function. */
@@ -79,6 +100,15 @@ extern "C" {
 /** \brief Modbus exception code 04 - Server device failure. */
 #define TBX_MB_EC04_SERVER_DEVICE_FAILURE             (4U)
 
+/** \brief Modbus exception code 06 - Server device busy. */
+#define TBX_MB_EC06_SERVER_DEVICE_BUSY                (6U)
+
+/** \brief Modbus exception code 10 - Gateway path unavailable. */
+#define TBX_MB_EC10_GATEWAY_PATH_UNAVAILABLE          (10U)
+
+/** \brief Modbus exception code 11 - Gateway target device failed to respond. */
+#define TBX_MB_EC11_GATEWAY_TARGET_FAILED             (11U)
+
 
 /* ------------------------- Diagnostics sub-function codes -------------------------- */
 /** \brief Diagnostics sub-function code - Return Query Data. */
@@ -103,6 +133,122 @@ extern "C" {
 #define TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT       (15U)
 
 
+/* ------------------------- Communication event log --------------------------------- */
+/** \brief Maximum number of events in the communication event log. */
+#define TBX_MB_COMM_EVENT_LOG_LEN                     (64U)
+
+/** \brief Communication event - Server receive event. Bit 7 is always set. */
+#define TBX_MB_COMM_EVENT_RECEIVE                     (0x80U)
+
+/** \brief Communication event - Server receive event flag: Communication error. */
+#define TBX_MB_COMM_EVENT_RECEIVE_COMM_ERROR          (0x02U)
+
+/** \brief Communication event - Server receive event flag: Character overrun. */
+#define TBX_MB_COMM_EVENT_RECEIVE_OVERRUN             (0x10U)
+
+/** \brief Communication event - Server receive event flag: Broadcast received. */
+#define TBX_MB_COMM_EVENT_RECEIVE_BROADCAST           (0x40U)
+
+/** \brief Communication event - Server send event. Bit 7 is always cleared and bit 6 is
+ *         always set.
+ */
+#define TBX_MB_COMM_EVENT_SEND                        (0x40U)
+
+/** \brief Communication event - Server send event flag: Read exception sent (exception
+ *         codes 1-3).
+ */
+#define TBX_MB_COMM_EVENT_SEND_READ_EXCEPTION         (0x01U)
+
+/** \brief Communication event - Server send event flag: Server abort exception sent
+ *         (exception code 4).
+ */
+#define TBX_MB_COMM_EVENT_SEND_ABORT_EXCEPTION        (0x02U)
+
+/** \brief Communication event - Server send event flag: Server busy exception sent
+ *         (exception codes 5-6).
+ */
+#define TBX_MB_COMM_EVENT_SEND_BUSY_EXCEPTION         (0x04U)
+
+/** \brief Communication event - Server send event flag: Server program NAK exception
+ *         sent (exception code 7).
+ */
+#define TBX_MB_COMM_EVENT_SEND_NAK_EXCEPTION          (0x08U)
+
+
+/* ------------------------- Encapsulated interface types ---------------------------- */
+/** \brief MEI type 14 - Read Device Identification. */
+#define TBX_MB_MEI_READ_DEVICE_ID                     (0x0EU)
+
+
+/* ------------------------- Read device ID codes ------------------------------------ */
+/** \brief Read device ID code - Stream access to the basic device identification. */
+#define TBX_MB_DEVID_READ_BASIC                       (1U)
+
+/** \brief Read device ID code - Stream access to the regular device identification. */
+#define TBX_MB_DEVID_READ_REGULAR                     (2U)
+
+/** \brief Read device ID code - Stream access to the extended device identification. */
+#define TBX_MB_DEVID_READ_EXTENDED                    (3U)
+
+/** \brief Read device ID code - Individual access to one specific object. */
+#define TBX_MB_DEVID_READ_INDIVIDUAL                  (4U)
+
+
+/* ------------------------- Device identification objects --------------------------- */
+/** \brief Device identification object - Vendor name (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_VENDOR_NAME                  (0x00U)
+
+/** \brief Device identification object - Product code (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_PRODUCT_CODE                 (0x01U)
+
+/** \brief Device identification object - Major minor revision (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_MAJOR_MINOR_REVISION         (0x02U)
+
+/** \brief Device identification object - Vendor URL (regular, optional). */
+#define TBX_MB_DEVID_OBJ_VENDOR_URL                   (0x03U)
+
+/** \brief Device identification object - Product name (regular, optional). */
+#define TBX_MB_DEVID_OBJ_PRODUCT_NAME                 (0x04U)
+
+/** \brief Device identification object - Model name (regular, optional). */
+#define TBX_MB_DEVID_OBJ_MODEL_NAME                   (0x05U)
+
+/** \brief Device identification object - User application name (regular, optional). */
+#define TBX_MB_DEVID_OBJ_USER_APP_NAME                (0x06U)
+
+/** \brief First object identifier of the regular device identification category. */
+#define TBX_MB_DEVID_OBJ_REGULAR_FIRST                (0x03U)
+
+/** \brief First object identifier of the extended device identification category. */
+#define TBX_MB_DEVID_OBJ_EXTENDED_FIRST               (0x80U)
+
+
+/* ------------------------- File record access -------------------------------------- */
+/** \brief Reference type of a file record sub-request. Always 6 as per the protocol. */
+#define TBX_MB_FILE_REF_TYPE                          (6U)
+
+/** \brief Lowest file number. */
+#define TBX_MB_FILE_NUM_MIN                           (0x0001U)
+
+/** \brief Highest record number within a file. */
+#define TBX_MB_FILE_RECORD_NUM_MAX                    (9999U)
+
+/** \brief Maximum value of the byte count field in file record requests and
+ *         responses.
+ */
+#define TBX_MB_FILE_BYTE_COUNT_MAX                    (0xF5U)
+
+/** \brief Number of header bytes in a file record sub-request (reference type, file
+ *         number, record number and record length).
+ */
+#define TBX_MB_FILE_SUBREQ_HDR_LEN                    (7U)
+
+
+/* ------------------------- FIFO queue ---------------------------------------------- */
+/** \brief Maximum number of FIFO queue values in a single read FIFO queue response. */
+#define TBX_MB_FIFO_COUNT_MAX                         (31U)
+
+
 /* ------------------------- Bit masks ----------------------------------------------- */
 /** \brief Bit mask to OR to the function code to flag it as an exception response. */
 #define TBX_MB_FC_EXCEPTION_MASK                      (0x80U)
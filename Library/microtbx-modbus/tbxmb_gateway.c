@@ -0,0 +1,1126 @@
+/************************************************************************************//**
+* \file         tbxmb_gateway.c
+* \brief        Modbus gateway source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_gateway_private.h"               /* MicroTBX-Modbus gateway private    */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being a gateway. */
+#define TBX_MB_GATEWAY_CONTEXT_TYPE     (52U)
+
+/** \brief Unique context type to identify a context as being an upstream transport of a
+ *         gateway.
+ */
+#define TBX_MB_GATEWAY_UPSTREAM_CONTEXT_TYPE (53U)
+
+/** \brief Request slot is free. */
+#define TBX_MB_GATEWAY_REQ_STATE_FREE    (0U)
+
+/** \brief Request was forwarded and awaits its completion on the bus. */
+#define TBX_MB_GATEWAY_REQ_STATE_FORWARD (1U)
+
+/** \brief Request is attached to an identical read request that was forwarded. */
+#define TBX_MB_GATEWAY_REQ_STATE_ATTACHED (2U)
+
+/** \brief Request completed and its response awaits transmission. */
+#define TBX_MB_GATEWAY_REQ_STATE_RESPOND (3U)
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbGatewayPoll            (tTbxMbGateway            gateway);
+
+static void TbxMbGatewayProcessEvent    (tTbxMbEvent            * event);
+
+static uint8_t TbxMbGatewayForward      (tTbxMbGatewayCtx       * gatewayCtx,
+                                         tTbxMbGatewayUpstream  * upstreamCtx,
+                                         tTbxMbTpPacket   const * rxPacket);
+
+static void TbxMbGatewayReqDone         (tTbxMbClient             channel,
+                                         uint8_t                  result,
+                                         void                   * context);
+
+static void TbxMbGatewayRespond         (tTbxMbGatewayCtx       * gatewayCtx);
+
+static uint8_t TbxMbGatewayTransmit     (tTbxMbGatewayReq       * req);
+
+static void TbxMbGatewayException       (tTbxMbGatewayUpstream  * upstreamCtx,
+                                         uint8_t                  unitId,
+                                         uint16_t                 transId,
+                                         uint8_t                  code,
+                                         uint8_t                  exceptionCode);
+
+static uint8_t TbxMbGatewayUpstreamAdd  (tTbxMbGatewayCtx       * gatewayCtx,
+                                         tTbxMbTp                 transport);
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus gateway object and assigns the server side transport layer
+**            object to it. The gateway accepts requests for any unit identifier on this
+**            transport layer. It forwards them to the bus that the routing table maps
+**            the unit identifier to, and relays the response back. A bus is reached
+**            through a client channel. Use TbxMbGatewayAddRoute() to build the routing
+**            table.
+** \details   Each bus gets its own request queue with queueSize entries, such that a
+**            slow bus does not hold up the other ones. Requests that arrive while the
+**            queue of their bus is full, or that the client channel of their bus cannot
+**            queue, are rejected with exception code 06 (server device busy). This
+**            pushes back on the clients, until the bus caught up. The gateway responds
+**            with exception code 10 (gateway path unavailable) for a unit identifier
+**            without a route and with exception code 11 (gateway target device failed
+**            to respond) if the bus did not deliver a response. Exception responses of
+**            the target device are relayed as is. Broadcast requests are forwarded to
+**            all buses. The gateway does not respond to them, as required for a
+**            broadcast request. A bus that cannot queue a broadcast request, drops it,
+**            which the busy counter of the statistics reflects.
+**            Use TbxMbGatewayAddTransport() to accept requests on more transport layers.
+**            Read requests (function codes 01..04) that are identical to a read request
+**            of another transport layer, which is still in progress on the bus, are not
+**            forwarded again. They are attached to the one in progress instead, and its
+**            response is relayed to all of them. When masters on multiple transport
+**            layers poll the same elements, this saves transactions on the bus. Reads
+**            from the same transport layer are not collapsed, because its master only
+**            repeats a read after it timed out. It would get two responses otherwise.
+** \param     transport Handle to a previously created transport layer object to assign
+**            to the gateway. It is used for receiving requests and transmitting
+**            responses.
+** \param     queueSize Number of requests that each bus can hold (1..255).
+** \return    Handle to the newly created Modbus gateway object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbGateway TbxMbGatewayCreate(tTbxMbTp transport,
+                                 uint8_t  queueSize)
+{
+  tTbxMbGateway result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (queueSize >= 1U));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (queueSize >= 1U))
+  {
+    /* Allocate memory for the new gateway context. */
+    tTbxMbGatewayCtx * newGatewayCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newGatewayCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayCtx));
+      newGatewayCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayCtx));
+    }
+    /* Verify memory allocation of the gateway context. */
+    TBX_ASSERT(newGatewayCtx != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newGatewayCtx != NULL)
+    {
+      /* Initialize the gateway context. The events of the transport layers go to the
+       * upstream transports, so the gateway itself only needs the poll function.
+       */
+      newGatewayCtx->type = TBX_MB_GATEWAY_CONTEXT_TYPE;
+      newGatewayCtx->instancePtr = NULL;
+      newGatewayCtx->pollFcn = TbxMbGatewayPoll;
+      newGatewayCtx->processFcn = NULL;
+      newGatewayCtx->upstreamList = NULL;
+      newGatewayCtx->queueSize = queueSize;
+      newGatewayCtx->busList = NULL;
+      newGatewayCtx->routeList = NULL;
+      newGatewayCtx->polling = TBX_FALSE;
+      newGatewayCtx->stats.forwarded = 0U;
+      newGatewayCtx->stats.collapsed = 0U;
+      newGatewayCtx->stats.relayed = 0U;
+      newGatewayCtx->stats.noRoute = 0U;
+      newGatewayCtx->stats.noResponse = 0U;
+      newGatewayCtx->stats.busy = 0U;
+      newGatewayCtx->stats.broadcasts = 0U;
+      newGatewayCtx->bcastLen = 0U;
+      /* Assign the transport layer as the first upstream transport. */
+      if (TbxMbGatewayUpstreamAdd(newGatewayCtx, transport) == TBX_OK)
+      {
+        /* Update the result. */
+        result = newGatewayCtx;
+      }
+      /* Give the gateway context back to the memory pool, if the transport layer could
+       * not be assigned.
+       */
+      else
+      {
+        newGatewayCtx->type = 0U;
+        TbxMemPoolRelease(newGatewayCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayCreate ****/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus gateway object, previously created with
+**            TbxMbGatewayCreate(). Requests that are still in progress on a bus, run
+**            their course, but their responses are no longer relayed.
+** \param     gateway Handle to the Modbus gateway object to release.
+**
+****************************************************************************************/
+void TbxMbGatewayFree(tTbxMbGateway gateway)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(gateway != NULL);
+
+  /* Only continue with valid parameters. */
+  if (gateway != NULL)
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Instruct the event task to stop calling our polling function, in case responses
+     * still await their transmission.
+     */
+    if (gatewayCtx->polling == TBX_TRUE)
+    {
+      tTbxMbEvent newEvent;
+      newEvent.context = gatewayCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    TbxCriticalSectionEnter();
+    gatewayCtx->type = 0U;
+    gatewayCtx->pollFcn = NULL;
+    gatewayCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Give the upstream transports back to the memory pool. */
+    while (gatewayCtx->upstreamList != NULL)
+    {
+      tTbxMbGatewayUpstream * upstreamCtx = gatewayCtx->upstreamList;
+      gatewayCtx->upstreamList = upstreamCtx->next;
+      /* Remove crosslink between the upstream transport and the transport layer. */
+      TbxCriticalSectionEnter();
+      upstreamCtx->tpCtx->anyNode = TBX_FALSE;
+      upstreamCtx->tpCtx->channelCtx = NULL;
+      upstreamCtx->tpCtx = NULL;
+      /* Invalidate the context to protect it from accidentally being used afterwards. */
+      upstreamCtx->type = 0U;
+      upstreamCtx->pollFcn = NULL;
+      upstreamCtx->processFcn = NULL;
+      TbxCriticalSectionExit();
+      TbxMemPoolRelease(upstreamCtx);
+    }
+    /* Give the routing table back to the memory pool. */
+    while (gatewayCtx->routeList != NULL)
+    {
+      tTbxMbGatewayRoute * routeCtx = gatewayCtx->routeList;
+      gatewayCtx->routeList = routeCtx->next;
+      TbxMemPoolRelease(routeCtx);
+    }
+    /* Give the buses back to the memory pool. */
+    while (gatewayCtx->busList != NULL)
+    {
+      tTbxMbGatewayBus * busCtx = gatewayCtx->busList;
+      gatewayCtx->busList = busCtx->next;
+      /* Make sure that the completion of requests still in progress no longer refers
+       * to the request queue.
+       */
+      for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+      {
+        if (busCtx->reqs[idx].state == TBX_MB_GATEWAY_REQ_STATE_FORWARD)
+        {
+          TbxMbClientCancel(busCtx->channel, &busCtx->reqs[idx]);
+        }
+      }
+      /* The same goes for broadcast requests that still share the response PDU
+       * buffer of the gateway.
+       */
+      TbxMbClientCancel(busCtx->channel, gatewayCtx);
+      TbxMemPoolRelease(busCtx->reqs);
+      TbxMemPoolRelease(busCtx);
+    }
+    /* Give the gateway context back to the memory pool. */
+    TbxMemPoolRelease(gatewayCtx);
+  }
+} /*** end of TbxMbGatewayFree ***/
+
+
+/************************************************************************************//**
+** \brief     Adds an entry to the routing table of the gateway. It maps the unit
+**            identifiers unitFirst..unitLast to the nodes on the bus of the client
+**            channel, starting at node address nodeFirst. For example, unit identifiers
+**            1..10 could map to nodes 1..10 on one bus and unit identifiers 11..20 to
+**            nodes 1..10 on another bus. The unit identifier ranges of the entries must
+**            not overlap.
+** \param     gateway Handle to the Modbus gateway object.
+** \param     unitFirst First unit identifier of the range (1..255).
+** \param     unitLast Last unit identifier of the range (unitFirst..255).
+** \param     channel Handle to the client channel of the bus.
+** \param     nodeFirst Node address on the bus of the first unit identifier. All units
+**            of the range must map to a node address in the range 1..247.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbGatewayAddRoute(tTbxMbGateway gateway,
+                             uint8_t       unitFirst,
+                             uint8_t       unitLast,
+                             tTbxMbClient  channel,
+                             uint8_t       nodeFirst)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((gateway != NULL) && (unitFirst != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+             (unitFirst <= unitLast) && (channel != NULL) &&
+             (nodeFirst >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (((uint32_t)nodeFirst + (unitLast - unitFirst)) <=
+              TBX_MB_TP_NODE_ADDR_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((gateway != NULL) && (unitFirst != TBX_MB_TP_NODE_ADDR_BROADCAST) &&
+      (unitFirst <= unitLast) && (channel != NULL) &&
+      (nodeFirst >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (((uint32_t)nodeFirst + (unitLast - unitFirst)) <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Make sure the unit identifiers are not yet routed. */
+    uint8_t              overlap = TBX_FALSE;
+    tTbxMbGatewayRoute * routeCtx = gatewayCtx->routeList;
+    while (routeCtx != NULL)
+    {
+      if ((unitFirst <= routeCtx->unitLast) && (unitLast >= routeCtx->unitFirst))
+      {
+        overlap = TBX_TRUE;
+      }
+      routeCtx = routeCtx->next;
+    }
+    /* Look up the bus of the client channel. */
+    tTbxMbGatewayBus * busCtx = gatewayCtx->busList;
+    while ((busCtx != NULL) && (busCtx->channel != channel))
+    {
+      busCtx = busCtx->next;
+    }
+    /* Add the bus, if this is the first route to it. */
+    if ((overlap == TBX_FALSE) && (busCtx == NULL))
+    {
+      size_t reqsSize = sizeof(tTbxMbGatewayReq) * gatewayCtx->queueSize;
+      /* Allocate memory for the bus and its request queue. */
+      busCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayBus));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (busCtx == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayBus));
+        busCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayBus));
+      }
+      tTbxMbGatewayReq * reqs = TbxMemPoolAllocate(reqsSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (reqs == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, reqsSize);
+        reqs = TbxMemPoolAllocate(reqsSize);
+      }
+      /* Verify memory allocation. */
+      TBX_ASSERT((busCtx != NULL) && (reqs != NULL));
+      /* Only continue if the memory allocation succeeded. */
+      if ((busCtx != NULL) && (reqs != NULL))
+      {
+        /* Initialize the request queue. */
+        for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+        {
+          reqs[idx].gatewayCtx = gatewayCtx;
+          reqs[idx].upstream = NULL;
+          reqs[idx].leader = NULL;
+          reqs[idx].state = TBX_MB_GATEWAY_REQ_STATE_FREE;
+          reqs[idx].unitId = 0U;
+          reqs[idx].node = 0U;
+          reqs[idx].transId = 0U;
+          reqs[idx].len = 0U;
+        }
+        /* Initialize the bus and add it to the gateway. */
+        busCtx->channel = channel;
+        busCtx->reqs = reqs;
+        TbxCriticalSectionEnter();
+        busCtx->next = gatewayCtx->busList;
+        gatewayCtx->busList = busCtx;
+        TbxCriticalSectionExit();
+      }
+      /* Give the memory back, if just one of the allocations succeeded. */
+      else
+      {
+        if (busCtx != NULL)
+        {
+          TbxMemPoolRelease(busCtx);
+          busCtx = NULL;
+        }
+        if (reqs != NULL)
+        {
+          TbxMemPoolRelease(reqs);
+        }
+      }
+    }
+    /* Only continue with the bus of the route. */
+    if ((overlap == TBX_FALSE) && (busCtx != NULL))
+    {
+      /* Allocate memory for the new routing table entry. */
+      routeCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayRoute));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (routeCtx == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayRoute));
+        routeCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayRoute));
+      }
+      /* Verify memory allocation of the routing table entry. */
+      TBX_ASSERT(routeCtx != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (routeCtx != NULL)
+      {
+        /* Initialize the routing table entry and add it to the routing table. */
+        routeCtx->unitFirst = unitFirst;
+        routeCtx->unitLast = unitLast;
+        routeCtx->nodeFirst = nodeFirst;
+        routeCtx->busCtx = busCtx;
+        TbxCriticalSectionEnter();
+        routeCtx->next = gatewayCtx->routeList;
+        gatewayCtx->routeList = routeCtx;
+        TbxCriticalSectionExit();
+        /* Update the result. */
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayAddRoute ***/
+
+
+/************************************************************************************//**
+** \brief     Assigns another server side transport layer object to the gateway. The
+**            gateway accepts requests on it the same way as on the transport layer that
+**            it was created with, and responds to them on the same transport layer. This
+**            way masters on several upstream transport layers share the buses behind the
+**            gateway. For example, a second serial line with its own master.
+** \param     gateway Handle to the Modbus gateway object.
+** \param     transport Handle to a previously created transport layer object to assign
+**            to the gateway.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbGatewayAddTransport(tTbxMbGateway gateway,
+                                 tTbxMbTp      transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((gateway != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((gateway != NULL) && (transport != NULL))
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Add the transport layer as an upstream transport. */
+    result = TbxMbGatewayUpstreamAdd(gatewayCtx, transport);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayAddTransport ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the statistics of the gateway.
+** \param     gateway Handle to the Modbus gateway object.
+** \param     stats Pointer where to store the statistics.
+**
+****************************************************************************************/
+void TbxMbGatewayGetStats(tTbxMbGateway        gateway,
+                          tTbxMbGatewayStats * stats)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((gateway != NULL) && (stats != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((gateway != NULL) && (stats != NULL))
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Copy the statistics. */
+    TbxCriticalSectionEnter();
+    *stats = gatewayCtx->stats;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbGatewayGetStats ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. It is only
+**            active while responses await their transmission, because the transport
+**            layer was still busy.
+** \param     gateway Handle to the Modbus gateway object.
+**
+****************************************************************************************/
+static void TbxMbGatewayPoll(tTbxMbGateway gateway)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(gateway != NULL);
+
+  /* Only continue with valid parameters. */
+  if (gateway != NULL)
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Retry the transmission of the responses. */
+    TbxMbGatewayRespond(gatewayCtx);
+  }
+} /*** end of TbxMbGatewayPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            an upstream transport of the gateway was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the upstream transport context.
+**
+****************************************************************************************/
+static void TbxMbGatewayProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the upstream transport context structure. */
+    tTbxMbGatewayUpstream * upstreamCtx = (tTbxMbGatewayUpstream *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(upstreamCtx != NULL);
+    /* Only continue with a valid context. */
+    if (upstreamCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(upstreamCtx->type == TBX_MB_GATEWAY_UPSTREAM_CONTEXT_TYPE);
+      /* Obtain the gateway of the upstream transport. */
+      tTbxMbGatewayCtx * gatewayCtx = upstreamCtx->gatewayCtx;
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t  exceptionCode = 0U;
+          uint8_t  unitId = 0U;
+          uint16_t transId = 0U;
+          uint8_t  code = 0U;
+          /* Obtain read access to the newly received packet. */
+          tTbxMbTpPacket * rxPacket;
+          rxPacket = upstreamCtx->tpCtx->getRxPacketFcn(upstreamCtx->tpCtx);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Forward the request to its bus. */
+            exceptionCode = TbxMbGatewayForward(gatewayCtx, upstreamCtx, rxPacket);
+            /* Store the request details needed for a possible exception response. */
+            unitId = rxPacket->node;
+            transId = rxPacket->transId;
+            code = rxPacket->pdu.code;
+          }
+          /* Inform the transport layer that were done with the rx packet. */
+          upstreamCtx->tpCtx->receptionDoneFcn(upstreamCtx->tpCtx);
+          /* Reject the request, if it could not be forwarded. Note that transmitFcn()
+           * should only be called after calling receptionDoneFcn().
+           */
+          if (exceptionCode != 0U)
+          {
+            TbxMbGatewayException(upstreamCtx, unitId, transId, code, exceptionCode);
+          }
+        }
+        break;
+
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* The transport layer is available again. Transmit the next response, if
+           * one is waiting.
+           */
+          TbxMbGatewayRespond(gatewayCtx);
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbGatewayProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Forwards a newly received request to the bus that the routing table maps
+**            its unit identifier to.
+** \param     gatewayCtx Pointer to the Modbus gateway context.
+** \param     upstreamCtx Pointer to the upstream transport that received the request.
+** \param     rxPacket Pointer to the request packet.
+** \return    Exception code to reject the request with, if it could not be forwarded.
+**            0 otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbGatewayForward(tTbxMbGatewayCtx       * gatewayCtx,
+                                   tTbxMbGatewayUpstream  * upstreamCtx,
+                                   tTbxMbTpPacket   const * rxPacket)
+{
+  uint8_t result = 0U;
+
+  /* Forward a broadcast request to all buses, because the gateway stands in for all
+   * nodes. The nodes on the buses do not respond to it, so the gateway has nothing to
+   * relay and does not respond either. The client channel of a bus completes it,
+   * once the turnaround delay passed.
+   */
+  if (rxPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+  {
+    /* Store the request PDU as a byte array. The client channel copies it, when
+     * queuing the request, so it can be reused for each bus.
+     */
+    uint8_t pdu[TBX_MB_TP_PDU_MAX_LEN];
+    uint8_t pduLen = rxPacket->dataLen + 1U;
+    pdu[0] = rxPacket->pdu.code;
+    for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+    {
+      pdu[idx + 1U] = rxPacket->pdu.data[idx];
+    }
+    /* Pass it on to the client channel of each bus. A broadcast request gets no
+     * response, so all buses can share the same response PDU buffer.
+     */
+    tTbxMbGatewayBus * busCtx = gatewayCtx->busList;
+    while (busCtx != NULL)
+    {
+      gatewayCtx->bcastLen = pduLen;
+      if (TbxMbClientCustomFunctionAsync(busCtx->channel, TBX_MB_TP_NODE_ADDR_BROADCAST,
+                                         pdu, gatewayCtx->bcastPdu,
+                                         &gatewayCtx->bcastLen, NULL,
+                                         gatewayCtx) == TBX_OK)
+      {
+        gatewayCtx->stats.broadcasts++;
+      }
+      /* The client channel could not queue the request. It cannot be rejected,
+       * because a broadcast request gets no response.
+       */
+      else
+      {
+        gatewayCtx->stats.busy++;
+      }
+      /* Continue with the next bus. */
+      busCtx = busCtx->next;
+    }
+  }
+  else
+  {
+    uint8_t exceptionCode = TBX_MB_EC10_GATEWAY_PATH_UNAVAILABLE;
+    /* Look up the route of the unit identifier. */
+    tTbxMbGatewayRoute * routeCtx = gatewayCtx->routeList;
+    while ((routeCtx != NULL) && ((rxPacket->node < routeCtx->unitFirst) ||
+                                  (rxPacket->node > routeCtx->unitLast)))
+    {
+      routeCtx = routeCtx->next;
+    }
+    /* Only continue with a route. */
+    if (routeCtx != NULL)
+    {
+      tTbxMbGatewayBus * busCtx = routeCtx->busCtx;
+      tTbxMbGatewayReq * req = NULL;
+      /* Find a free entry in the request queue of the bus. */
+      for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+      {
+        if ((req == NULL) && (busCtx->reqs[idx].state == TBX_MB_GATEWAY_REQ_STATE_FREE))
+        {
+          req = &busCtx->reqs[idx];
+        }
+      }
+      /* Reject the request, while the request queue is full. */
+      if (req == NULL)
+      {
+        exceptionCode = TBX_MB_EC06_SERVER_DEVICE_BUSY;
+      }
+      /* Store the request in the queue. */
+      else
+      {
+        req->upstream = upstreamCtx;
+        req->unitId = rxPacket->node;
+        req->node = routeCtx->nodeFirst + (rxPacket->node - routeCtx->unitFirst);
+        req->transId = rxPacket->transId;
+        req->len = rxPacket->dataLen + 1U;
+        req->pdu[0] = rxPacket->pdu.code;
+        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+        {
+          req->pdu[idx + 1U] = rxPacket->pdu.data[idx];
+        }
+        /* Look for an identical read request that is still in progress on the bus.
+         * Reads do not change the state of the node, so one response serves both. The
+         * PDU of a read request always holds the function code, the starting address
+         * and the quantity. Note that the length of a forwarded request cannot be
+         * compared, because it was already reset for the response.
+         * Only requests of another upstream transport qualify. An identical request
+         * of the same upstream transport is a retry of its master, after it timed out.
+         * Attaching it would get the master two responses.
+         */
+        req->leader = NULL;
+        if ((req->pdu[0] >= TBX_MB_FC01_READ_COILS) &&
+            (req->pdu[0] <= TBX_MB_FC04_READ_INPUT_REGISTERS) && (req->len == 5U))
+        {
+          for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+          {
+            tTbxMbGatewayReq * otherReq = &busCtx->reqs[idx];
+            if ((req->leader == NULL) &&
+                (otherReq->state == TBX_MB_GATEWAY_REQ_STATE_FORWARD) &&
+                (otherReq->node == req->node) && (otherReq->upstream != upstreamCtx))
+            {
+              /* Compare the PDUs. */
+              uint8_t pduIdx = 0U;
+              while ((pduIdx < req->len) && (otherReq->pdu[pduIdx] == req->pdu[pduIdx]))
+              {
+                pduIdx++;
+              }
+              if (pduIdx == req->len)
+              {
+                req->leader = otherReq;
+              }
+            }
+          }
+          /* The same goes for the requests that are already attached to it. */
+          for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+          {
+            tTbxMbGatewayReq * otherReq = &busCtx->reqs[idx];
+            if ((req->leader != NULL) &&
+                (otherReq->state == TBX_MB_GATEWAY_REQ_STATE_ATTACHED) &&
+                (otherReq->leader == req->leader) && (otherReq->upstream == upstreamCtx))
+            {
+              req->leader = NULL;
+            }
+          }
+        }
+        /* Attach it to the identical read request, if found. */
+        if (req->leader != NULL)
+        {
+          req->state = TBX_MB_GATEWAY_REQ_STATE_ATTACHED;
+          gatewayCtx->stats.collapsed++;
+          /* Request attached. No exception response needed. */
+          exceptionCode = 0U;
+        }
+        /* Pass it on to the client channel. The request PDU buffer is reused for the
+         * response PDU. This works because the client channel copies the request PDU,
+         * when queuing the request.
+         */
+        else if (TbxMbClientCustomFunctionAsync(busCtx->channel, req->node, req->pdu,
+                                                req->pdu, &req->len, TbxMbGatewayReqDone,
+                                                req) == TBX_OK)
+        {
+          req->state = TBX_MB_GATEWAY_REQ_STATE_FORWARD;
+          gatewayCtx->stats.forwarded++;
+          /* Request forwarded. No exception response needed. */
+          exceptionCode = 0U;
+        }
+        /* The client channel could not queue the request, for example because its
+         * request pool is exhausted. The route exists, so the bus is just busy.
+         */
+        else
+        {
+          exceptionCode = TBX_MB_EC06_SERVER_DEVICE_BUSY;
+        }
+      }
+    }
+    /* Update the statistics, if the request could not be forwarded. */
+    if (exceptionCode == TBX_MB_EC06_SERVER_DEVICE_BUSY)
+    {
+      gatewayCtx->stats.busy++;
+    }
+    else if (exceptionCode != 0U)
+    {
+      gatewayCtx->stats.noRoute++;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+    /* Update the result. */
+    result = exceptionCode;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayForward ***/
+
+
+/************************************************************************************//**
+** \brief     Completion callback of a request that the gateway forwarded to a bus.
+** \param     channel Handle to the client channel of the bus.
+** \param     result TBX_OK if a response was received, TBX_ERROR otherwise.
+** \param     context Pointer to the request in the request queue of the bus.
+**
+****************************************************************************************/
+static void TbxMbGatewayReqDone(tTbxMbClient   channel,
+                                uint8_t        result,
+                                void         * context)
+{
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    tTbxMbGatewayReq * req = (tTbxMbGatewayReq *)context;
+    tTbxMbGatewayCtx * gatewayCtx = req->gatewayCtx;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Relay the response PDU as is, if one was received. */
+    if (result == TBX_OK)
+    {
+      gatewayCtx->stats.relayed++;
+    }
+    /* Respond with an exception instead. The PDU buffer still holds the request,
+     * because it only gets overwritten upon reception of the response.
+     */
+    else
+    {
+      req->pdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      req->pdu[1] = TBX_MB_EC11_GATEWAY_TARGET_FAILED;
+      req->len = 2U;
+      gatewayCtx->stats.noResponse++;
+    }
+    /* The response awaits its transmission. */
+    req->state = TBX_MB_GATEWAY_REQ_STATE_RESPOND;
+    /* Fan the response out to the requests that are attached to this one. */
+    tTbxMbGatewayBus * busCtx = gatewayCtx->busList;
+    while (busCtx != NULL)
+    {
+      for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+      {
+        tTbxMbGatewayReq * attachedReq = &busCtx->reqs[idx];
+        if ((attachedReq->state == TBX_MB_GATEWAY_REQ_STATE_ATTACHED) &&
+            (attachedReq->leader == req))
+        {
+          /* Copy the response PDU. */
+          attachedReq->len = req->len;
+          for (uint8_t pduIdx = 0U; pduIdx < req->len; pduIdx++)
+          {
+            attachedReq->pdu[pduIdx] = req->pdu[pduIdx];
+          }
+          attachedReq->leader = NULL;
+          attachedReq->state = TBX_MB_GATEWAY_REQ_STATE_RESPOND;
+          /* Update the statistics. */
+          if (result == TBX_OK)
+          {
+            gatewayCtx->stats.relayed++;
+          }
+          else
+          {
+            gatewayCtx->stats.noResponse++;
+          }
+        }
+      }
+      /* Continue with the next bus. */
+      busCtx = busCtx->next;
+    }
+    /* Transmit the responses. */
+    TbxMbGatewayRespond(gatewayCtx);
+  }
+} /*** end of TbxMbGatewayReqDone ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits the responses that await their transmission, for as long as the
+**            transport layer accepts them. The polling function retries the remaining
+**            ones later on.
+** \param     gatewayCtx Pointer to the Modbus gateway context.
+**
+****************************************************************************************/
+static void TbxMbGatewayRespond(tTbxMbGatewayCtx * gatewayCtx)
+{
+  uint8_t waiting = TBX_FALSE;
+
+  /* None of the upstream transports is known to be busy yet. */
+  tTbxMbGatewayUpstream * upstreamCtx = gatewayCtx->upstreamList;
+  while (upstreamCtx != NULL)
+  {
+    upstreamCtx->waiting = TBX_FALSE;
+    upstreamCtx = upstreamCtx->next;
+  }
+  /* Loop through the request queues of all buses. */
+  tTbxMbGatewayBus * busCtx = gatewayCtx->busList;
+  while (busCtx != NULL)
+  {
+    for (uint8_t idx = 0U; idx < gatewayCtx->queueSize; idx++)
+    {
+      tTbxMbGatewayReq * req = &busCtx->reqs[idx];
+      /* Transmit the response, if it awaits its transmission, unless an earlier
+       * attempt on the same upstream transport already failed. Transmit the responses
+       * in order in that case.
+       */
+      if ((req->state == TBX_MB_GATEWAY_REQ_STATE_RESPOND) &&
+          (req->upstream->waiting == TBX_FALSE))
+      {
+        if (TbxMbGatewayTransmit(req) == TBX_FALSE)
+        {
+          req->upstream->waiting = TBX_TRUE;
+          waiting = TBX_TRUE;
+        }
+      }
+    }
+    /* Continue with the next bus. */
+    busCtx = busCtx->next;
+  }
+  /* Transmit the exception responses that await their transmission, if any. They
+   * belong to the most recent request of their upstream transport, so they go last.
+   */
+  upstreamCtx = gatewayCtx->upstreamList;
+  while (upstreamCtx != NULL)
+  {
+    if ((upstreamCtx->excReq.state == TBX_MB_GATEWAY_REQ_STATE_RESPOND) &&
+        (upstreamCtx->waiting == TBX_FALSE))
+    {
+      if (TbxMbGatewayTransmit(&upstreamCtx->excReq) == TBX_FALSE)
+      {
+        upstreamCtx->waiting = TBX_TRUE;
+        waiting = TBX_TRUE;
+      }
+    }
+    /* Continue with the next upstream transport. */
+    upstreamCtx = upstreamCtx->next;
+  }
+  /* Start polling to retry the transmission of the remaining responses. */
+  if ((waiting == TBX_TRUE) && (gatewayCtx->polling == TBX_FALSE))
+  {
+    gatewayCtx->polling = TBX_TRUE;
+    tTbxMbEvent newEvent;
+    newEvent.context = gatewayCtx;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+  /* Stop polling once all responses were transmitted. */
+  else if ((waiting == TBX_FALSE) && (gatewayCtx->polling == TBX_TRUE))
+  {
+    gatewayCtx->polling = TBX_FALSE;
+    tTbxMbEvent newEvent;
+    newEvent.context = gatewayCtx;
+    newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+} /*** end of TbxMbGatewayRespond ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits the response of a request on the upstream transport that the
+**            request came in on. The request slot is free again, once the transmission
+**            started.
+** \param     req Pointer to the request whose response awaits its transmission.
+** \return    TBX_TRUE if the transmission started, TBX_FALSE if the transport layer was
+**            still busy.
+**
+****************************************************************************************/
+static uint8_t TbxMbGatewayTransmit(tTbxMbGatewayReq * req)
+{
+  uint8_t       result = TBX_FALSE;
+  tTbxMbTpCtx * tpCtx = req->upstream->tpCtx;
+
+  /* Attempt to obtain write access to the response packet. */
+  tTbxMbTpPacket * txPacket = tpCtx->getTxPacketFcn(tpCtx);
+  /* Prepare the response packet, if the transport layer is available. */
+  if (txPacket != NULL)
+  {
+    txPacket->node = req->unitId;
+    txPacket->transId = req->transId;
+    txPacket->pdu.code = req->pdu[0];
+    txPacket->dataLen = req->len - 1U;
+    for (uint8_t dataIdx = 0U; dataIdx < txPacket->dataLen; dataIdx++)
+    {
+      txPacket->pdu.data[dataIdx] = req->pdu[dataIdx + 1U];
+    }
+    /* The transport layer refuses the transmission while it is still receiving.
+     * Retry later on in this case.
+     */
+    if (tpCtx->transmitFcn(tpCtx) == TBX_OK)
+    {
+      req->state = TBX_MB_GATEWAY_REQ_STATE_FREE;
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits an exception response to a request that the gateway rejected.
+**            If the transport layer is busy, the exception response waits in the
+**            exception slot of the upstream transport, until the transmission of the
+**            responses is retried. The master sends its next request only after it
+**            received the response or timed out. An exception response that still
+**            waits, when the next request is rejected, is therefore outdated and gets
+**            replaced.
+** \param     upstreamCtx Pointer to the upstream transport that received the request.
+** \param     unitId Unit identifier of the request.
+** \param     transId Transaction identifier of the request.
+** \param     code Function code of the request.
+** \param     exceptionCode Exception code of the response.
+**
+****************************************************************************************/
+static void TbxMbGatewayException(tTbxMbGatewayUpstream * upstreamCtx,
+                                  uint8_t                 unitId,
+                                  uint16_t                transId,
+                                  uint8_t                 code,
+                                  uint8_t                 exceptionCode)
+{
+  tTbxMbGatewayReq * excReq = &upstreamCtx->excReq;
+
+  /* Store the exception response in the exception slot. */
+  excReq->unitId = unitId;
+  excReq->transId = transId;
+  excReq->pdu[0] = code | TBX_MB_FC_EXCEPTION_MASK;
+  excReq->pdu[1] = exceptionCode;
+  excReq->len = 2U;
+  /* The exception response awaits its transmission. */
+  excReq->state = TBX_MB_GATEWAY_REQ_STATE_RESPOND;
+  /* Transmit it, together with the other responses that await their transmission. */
+  TbxMbGatewayRespond(upstreamCtx->gatewayCtx);
+} /*** end of TbxMbGatewayException ***/
+
+
+/************************************************************************************//**
+** \brief     Adds an upstream transport to the gateway and assigns the server side
+**            transport layer object to it.
+** \param     gatewayCtx Pointer to the Modbus gateway context.
+** \param     transport Handle to a previously created transport layer object to assign
+**            to the gateway. It is used for receiving requests and transmitting
+**            responses.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbGatewayUpstreamAdd(tTbxMbGatewayCtx * gatewayCtx,
+                                       tTbxMbTp           transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Allocate memory for the new upstream transport context. */
+  tTbxMbGatewayUpstream * upstreamCtx;
+  upstreamCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayUpstream));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (upstreamCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayUpstream));
+    upstreamCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayUpstream));
+  }
+  /* Verify memory allocation of the upstream transport context. */
+  TBX_ASSERT(upstreamCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (upstreamCtx != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the transport layer's interface function. That way there is 
+     * no need to do it later on, making it more run-time efficient. Also check that
+     * it's not already linked to another channel.
+     */
+    TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
+               (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
+               (tpCtx->channelCtx == NULL));
+    /* Initialize the upstream transport context. It has no need for polling. */
+    upstreamCtx->type = TBX_MB_GATEWAY_UPSTREAM_CONTEXT_TYPE;
+    upstreamCtx->instancePtr = NULL;
+    upstreamCtx->pollFcn = NULL;
+    upstreamCtx->processFcn = TbxMbGatewayProcessEvent;
+    upstreamCtx->gatewayCtx = gatewayCtx;
+    upstreamCtx->waiting = TBX_FALSE;
+    upstreamCtx->excReq.gatewayCtx = gatewayCtx;
+    upstreamCtx->excReq.upstream = upstreamCtx;
+    upstreamCtx->excReq.leader = NULL;
+    upstreamCtx->excReq.state = TBX_MB_GATEWAY_REQ_STATE_FREE;
+    upstreamCtx->excReq.unitId = 0U;
+    upstreamCtx->excReq.node = 0U;
+    upstreamCtx->excReq.transId = 0U;
+    upstreamCtx->excReq.len = 0U;
+    /* Add it to the gateway. */
+    TbxCriticalSectionEnter();
+    upstreamCtx->next = gatewayCtx->upstreamList;
+    gatewayCtx->upstreamList = upstreamCtx;
+    TbxCriticalSectionExit();
+    /* Crosslink the transport layer. */
+    upstreamCtx->tpCtx = tpCtx;
+    upstreamCtx->tpCtx->channelCtx = upstreamCtx;
+    upstreamCtx->tpCtx->isClient = TBX_FALSE;
+    /* Accept requests for all node addresses, as opposed to just our own. */
+    upstreamCtx->tpCtx->anyNode = TBX_TRUE;
+    /* Update the result. */
+    result = TBX_OK;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayUpstreamAdd ***/
+
+
+/*********************************** end of tbxmb_gateway.c ****************************/
@@ -0,0 +1,89 @@
+/************************************************************************************//**
+* \file         tbxmb_gateway.h
+* \brief        Modbus gateway header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_GATEWAY_H
+#define TBXMB_GATEWAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Handle to a Modbus gateway object, in the format of an opaque pointer. */
+typedef void * tTbxMbGateway;
+
+
+/** \brief Statistics of a Modbus gateway. Note that only identical reads from masters
+ *         on different upstream transport layers are collapsed. A master on a serial
+ *         line waits for the response before sending its next request, so an identical
+ *         read from the same upstream transport layer is a retry. Use
+ *         TbxMbGatewayAddTransport() to give each master its own upstream transport
+ *         layer.
+ */
+typedef struct
+{
+  uint32_t   forwarded;                          /**< Requests forwarded to a bus.     */
+  uint32_t   collapsed;                          /**< Reads attached to identical ones.*/
+  uint32_t   relayed;                            /**< Responses relayed back.          */
+  uint32_t   noRoute;                            /**< Requests without a route.        */
+  uint32_t   noResponse;                         /**< Requests without a response.     */
+  uint32_t   busy;                               /**< Requests rejected, bus busy.     */
+  uint32_t   broadcasts;                         /**< Broadcasts forwarded to a bus.   */
+} tTbxMbGatewayStats;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+tTbxMbGateway TbxMbGatewayCreate        (tTbxMbTp                     transport,
+                                         uint8_t                      queueSize);
+
+void          TbxMbGatewayFree          (tTbxMbGateway                gateway);
+
+uint8_t       TbxMbGatewayAddRoute      (tTbxMbGateway                gateway,
+                                         uint8_t                      unitFirst,
+                                         uint8_t                      unitLast,
+                                         tTbxMbClient                 channel,
+                                         uint8_t                      nodeFirst);
+
+uint8_t       TbxMbGatewayAddTransport  (tTbxMbGateway                gateway,
+                                         tTbxMbTp                     transport);
+
+void          TbxMbGatewayGetStats      (tTbxMbGateway                gateway,
+                                         tTbxMbGatewayStats         * stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_GATEWAY_H */
+/*********************************** end of tbxmb_gateway.h ****************************/
@@ -0,0 +1,145 @@
+/************************************************************************************//**
+* \file         tbxmb_gateway_private.h
+* \brief        Modbus gateway private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_GATEWAY_PRIVATE_H
+#define TBXMB_GATEWAY_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Modbus gateway interface function to detect events in a polling manner. */
+typedef void (* tTbxMbGatewayPoll)   (void        * context);
+
+
+/** \brief Modbus gateway interface function for processing events. */
+typedef void (* tTbxMbGatewayProcess)(tTbxMbEvent * event);
+
+
+/** \brief Request that the gateway forwarded to a bus. The PDU buffer first holds the
+ *         request PDU and, once the bus completed the request, the response PDU. A read
+ *         request that is identical to one already forwarded, is attached to that one
+ *         instead. It then gets a copy of its response PDU.
+ */
+typedef struct t_tbx_mb_gateway_req
+{
+  struct t_tbx_mb_gateway_ctx      * gatewayCtx; /**< Gateway of the request.          */
+  struct t_tbx_mb_gateway_upstream * upstream;   /**< Upstream transport to respond on.*/
+  struct t_tbx_mb_gateway_req      * leader;     /**< Forwarded request if attached.   */
+  uint8_t                            state;      /**< Request state.                   */
+  uint8_t                            unitId;     /**< Unit identifier of the request.  */
+  uint8_t                            node;       /**< Node address on the bus.         */
+  uint16_t                           transId;    /**< Transaction identifier.          */
+  uint8_t                            len;        /**< PDU length, incl. function code. */
+  uint8_t                            pdu[TBX_MB_TP_PDU_MAX_LEN]; /**< PDU bytes.       */
+} tTbxMbGatewayReq;
+
+
+/** \brief Upstream transport of the gateway, on which it receives requests and
+ *         transmits responses. Each upstream transport has its own event interface,
+ *         such that the gateway knows on which one a request came in.
+ */
+typedef struct t_tbx_mb_gateway_upstream
+{
+  /* Event interface methods. The following three entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void                             * instancePtr; /**< Reserved for C++ wrapper.       */
+  tTbxMbGatewayPoll                  pollFcn;    /**< Event poll function.             */
+  tTbxMbGatewayProcess               processFcn; /**< Event process function.          */
+  /* Private members. */
+  uint8_t                            type;       /**< Context type.                    */
+  struct t_tbx_mb_gateway_ctx      * gatewayCtx; /**< Gateway of the transport.        */
+  tTbxMbTpCtx                      * tpCtx;      /**< Assigned transport layer context.*/
+  uint8_t                            waiting;    /**< TBX_TRUE while responses wait.   */
+  tTbxMbGatewayReq                   excReq;     /**< Exception awaiting transmission. */
+  struct t_tbx_mb_gateway_upstream * next;       /**< Next upstream transport.         */
+} tTbxMbGatewayUpstream;
+
+
+/** \brief Bus behind the gateway, reached through a client channel. Each bus has its own
+ *         bounded queue with requests, such that a slow bus does not hold up the other
+ *         ones.
+ */
+typedef struct t_tbx_mb_gateway_bus
+{
+  tTbxMbClient                       channel;    /**< Client channel of the bus.       */
+  tTbxMbGatewayReq                 * reqs;       /**< Request queue of the bus.        */
+  struct t_tbx_mb_gateway_bus      * next;       /**< Next bus of the gateway.         */
+} tTbxMbGatewayBus;
+
+
+/** \brief Entry of the routing table. It maps a range of unit identifiers to the nodes
+ *         on a bus, starting at the specified node address.
+ */
+typedef struct t_tbx_mb_gateway_route
+{
+  uint8_t                            unitFirst;  /**< First unit identifier.           */
+  uint8_t                            unitLast;   /**< Last unit identifier.            */
+  uint8_t                            nodeFirst;  /**< Node address of the first unit.  */
+  tTbxMbGatewayBus                 * busCtx;     /**< Bus the units map to.            */
+  struct t_tbx_mb_gateway_route    * next;       /**< Next entry of the routing table. */
+} tTbxMbGatewayRoute;
+
+
+/** \brief Modbus gateway context that groups all gateway specific data. It's what the
+ *         tTbxMbGateway opaque pointer points to.
+ */
+typedef struct t_tbx_mb_gateway_ctx
+{
+  /* Event interface methods. The following three entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from. 
+   */
+  void                             * instancePtr; /**< Reserved for C++ wrapper.       */
+  tTbxMbGatewayPoll                  pollFcn;    /**< Event poll function.             */
+  tTbxMbGatewayProcess               processFcn; /**< Event process function.          */
+  /* Private members. */
+  uint8_t                            type;       /**< Context type.                    */
+  tTbxMbGatewayUpstream            * upstreamList; /**< Upstream transports.           */
+  uint8_t                            queueSize;  /**< Request queue size of each bus.  */
+  tTbxMbGatewayBus                 * busList;    /**< Linked list with the buses.      */
+  tTbxMbGatewayRoute               * routeList;  /**< Linked list with the routes.     */
+  uint8_t                            polling;    /**< TBX_TRUE while being polled.     */
+  tTbxMbGatewayStats                 stats;      /**< Statistics.                      */
+  uint8_t                            bcastPdu[TBX_MB_TP_PDU_MAX_LEN]; /**< Bcast rsp.  */
+  uint8_t                            bcastLen;   /**< Broadcast response PDU length.   */
+} tTbxMbGatewayCtx;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_GATEWAY_PRIVATE_H */
+/*********************************** end of tbxmb_gateway_private.h ********************/
@@ -89,6 +89,10 @@ static tTbxMbTpPacket * TbxMbRtuGetRxPacket     (tTbxMbTp               transpor
 
 static tTbxMbTpPacket * TbxMbRtuGetTxPacket     (tTbxMbTp               transport);
 
+static void             TbxMbRtuCursorBegin     (tTbxMbTp               transport,
+                                                 tTbxMbTpCursor       * cursor,
+                                                 uint8_t              * pdu);
+
 static uint8_t          TbxMbRtuValidate        (tTbxMbTp               transport);
 
 static void             TbxMbRtuTransmitComplete(tTbxMbUartPort         port);
@@ -100,6 +104,10 @@ static void             TbxMbRtuDataReceived    (tTbxMbUartPort         port,
 static uint16_t         TbxMbRtuCalculatCrc     (uint8_t        const * data, 
                                                  uint16_t               len);
 
+static uint16_t         TbxMbRtuUpdateCrc       (uint16_t               crc,
+                                                 uint8_t        const * data, 
+                                                 uint16_t               len);
+
 
 /****************************************************************************************
 * Local data declarations
@@ -178,16 +186,30 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
       newTpCtx->receptionDoneFcn = TbxMbRtuReceptionDone;
       newTpCtx->getRxPacketFcn = TbxMbRtuGetRxPacket;
       newTpCtx->getTxPacketFcn = TbxMbRtuGetTxPacket;
+      newTpCtx->fastPathFcn = NULL;
+      newTpCtx->cursorBeginFcn = TbxMbRtuCursorBegin;
+      /* A serial line only allows a client to have one request awaiting a response. */
+      newTpCtx->outstandingMax = 1U;
+      newTpCtx->anyNode = TBX_FALSE;
       newTpCtx->nodeAddr = nodeAddr;
       newTpCtx->port = port;
       newTpCtx->state = TBX_MB_RTU_STATE_INIT;
       newTpCtx->rxTime = TbxMbPortTimerCount();
+      newTpCtx->txDone = TBX_FALSE;
+      newTpCtx->txCursor.ptr = NULL;
+      newTpCtx->txCursor.checksum = 0U;
+      newTpCtx->txCursor.checksumFcn = NULL;
+      newTpCtx->txPacket.transId = 0U;
+      newTpCtx->rxPacket.transId = 0U;
       newTpCtx->initStateExitSem = TbxMbOsalSemCreate();
       newTpCtx->diagInfo.busMsgCnt = 0U;
       newTpCtx->diagInfo.busCommErrCnt = 0U;
       newTpCtx->diagInfo.busExcpErrCnt = 0U;
       newTpCtx->diagInfo.srvMsgCnt = 0U;
       newTpCtx->diagInfo.srvNoRespCnt = 0U;
+      newTpCtx->diagInfo.commEventCnt = 0U;
+      newTpCtx->diagInfo.commEventsNext = 0U;
+      newTpCtx->diagInfo.commEventsNum = 0U;
       /* Store the transport context in the lookup table. */
       tbxMbRtuCtx[port] = newTpCtx;
       /* Initialize the port. Note the RTU always uses 8 databits. */
@@ -369,8 +391,12 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
               tpCtx->state = TBX_MB_RTU_STATE_IDLE;
               TbxCriticalSectionExit();
             }
-            /* Newly received packet is valid. */
-            else
+            /* Newly received packet is valid. Give the linked channel the opportunity
+             * to process it right away, which saves the round trip through the event
+             * queue.
+             */
+            else if ( (tpCtx->fastPathFcn == NULL) || 
+                      (tpCtx->fastPathFcn(tpCtx->channelCtx) == TBX_FALSE) )
             {
               /* Post an event to the linked channel for further processing of the PDU.*/
               tTbxMbEvent pduRxEvent;
@@ -378,12 +404,25 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
               pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
               TbxMbOsalEventPost(&pduRxEvent, TBX_FALSE);
             }
+            else
+            {
+              /* Nothing left to do, because the channel already processed the packet,
+               * but MISRA requires this terminating else statement.
+               */
+            }
           }
           /* Frame was marked as not okay (NOK) during its reception. Most likely a
            * 1.5 character timeout. 
            */
           else
           {
+            /* Log the communication error, in case we are a server. */
+            if (tpCtx->isClient == TBX_FALSE)
+            {
+              TbxMbTpCommEventAdd(&tpCtx->diagInfo, 
+                                  TBX_MB_COMM_EVENT_RECEIVE | 
+                                  TBX_MB_COMM_EVENT_RECEIVE_COMM_ERROR);
+            }
             /* Discard the newly received frame by transitioning back to IDLE. */
             TbxCriticalSectionEnter();
             tpCtx->state = TBX_MB_RTU_STATE_IDLE;
@@ -397,14 +436,19 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
       {
         TbxCriticalSectionEnter();
         uint16_t txDoneTimeCopy = tpCtx->txDoneTime;
+        uint8_t  txDoneCopy = tpCtx->txDone;
         TbxCriticalSectionExit();
         /* Calculate the number of time ticks that elapsed since completing the packet
          * transmission. Note that this calculation works, even if the timer counter
          * overflowed.
          */
         uint16_t deltaTicks = TbxMbPortTimerCount() - txDoneTimeCopy;
-        /* After t3_5 it's time to transition to the IDLE state. */
-        if (deltaTicks >= tpCtx->t3_5Ticks)
+        /* After t3_5 it's time to transition to the IDLE state. Note that this function
+         * could still be called before the transmission completed. This happens when
+         * the fast path of the channel started the transmission, while the request to
+         * stop calling this function was not yet processed.
+         */
+        if ( (txDoneCopy == TBX_TRUE) && (deltaTicks >= tpCtx->t3_5Ticks) )
         {
           /* Transition back to the IDLE state. */
           TbxCriticalSectionEnter();
@@ -554,6 +598,7 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
          * completion of the transmission.
          */
         tpCtx->state = TBX_MB_RTU_STATE_TRANSMISSION;
+        tpCtx->txDone = TBX_FALSE;
       }
     }
     TbxCriticalSectionExit();
@@ -573,11 +618,35 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
        * PDU. For client->server transfers the address field is the servers's node
        * address (unicast) or 0 (broadcast) and the client channel will have stored it in
        * the txPacket.node element. For server-client transfers it always the servers's
-       * node address as stored when creating the RTU transport layer context.
+       * node address as stored when creating the RTU transport layer context. Except
+       * for a server that serves any node, such as a gateway. It responds with the node
+       * address of the request, which the channel stored in the txPacket.node element.
        */
-      aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket.node : tpCtx->nodeAddr;
-      /* Populate the ADU tail. For RTU it is the CRC16 right after the PDU's data. */
-      uint16_t adu_crc = TbxMbRtuCalculatCrc(aduPtr, aduLen - 2U);
+      if ((tpCtx->isClient == TBX_TRUE) || (tpCtx->anyNode == TBX_TRUE))
+      {
+        aduPtr[0] = tpCtx->txPacket.node;
+      }
+      else
+      {
+        aduPtr[0] = tpCtx->nodeAddr;
+      }
+      /* Populate the ADU tail. For RTU it is the CRC16 right after the PDU's data. If
+       * the channel wrote the PDU data with an output cursor that ended right at the
+       * end of the PDU, the CRC16 was already calculated while writing. Otherwise a
+       * separate pass over the ADU is needed.
+       */
+      uint16_t adu_crc;
+      if ( (tpCtx->txCursor.checksumFcn != NULL) &&
+           (tpCtx->txCursor.ptr == &aduPtr[aduLen - 2U]) )
+      {
+        adu_crc = tpCtx->txCursor.checksum;
+      }
+      else
+      {
+        adu_crc = TbxMbRtuCalculatCrc(aduPtr, aduLen - 2U);
+      }
+      /* The output cursor is used up. */
+      tpCtx->txCursor.checksumFcn = NULL;
       aduPtr[aduLen - 2U] = (uint8_t)adu_crc;                         /* CRC16 low.  */
       aduPtr[aduLen - 1U] = (uint8_t)(adu_crc >> 8U);                 /* CRC16 high. */
       /* Pass ADU transmit request on to the UART module. */
@@ -598,6 +667,16 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
       /* Increment the total number of not sent responses. */
       tpCtx->diagInfo.srvNoRespCnt++;
     }
+    /* Server that completed processing a request? */
+    else if (tpCtx->isClient == TBX_FALSE)
+    {
+      /* Update the communication event counter and log. */
+      TbxMbTpCommEventResponse(&tpCtx->diagInfo, &tpCtx->txPacket);
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
   }
   /* Give the result back to the caller. */
   return result;
@@ -719,6 +798,10 @@ static tTbxMbTpPacket * TbxMbRtuGetTxPacket(tTbxMbTp transport)
     TbxCriticalSectionExit();
     if (currentState != TBX_MB_RTU_STATE_TRANSMISSION)
     {
+      /* The channel is about to prepare a new packet. Discard a possibly earlier ended
+       * output cursor, because it no longer relates to the packet's contents.
+       */
+      tpCtx->txCursor.checksumFcn = NULL;
       /* Update the result. */
       result = &tpCtx->txPacket;
     }
@@ -728,6 +811,48 @@ static tTbxMbTpPacket * TbxMbRtuGetTxPacket(tTbxMbTp transport)
 } /*** end of TbxMbRtuGetTxPacket ***/
 
 
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to start writing the PDU data
+**            of the transmission packet with an output cursor. The running CRC16 starts
+**            with the address field and the function code, which must already be set.
+** \param     transport Handle to RTU transport layer object.
+** \param     cursor Pointer to the output cursor to initialize.
+** \param     pdu Pointer to the PDU to write, starting with its function code.
+**
+****************************************************************************************/
+static void TbxMbRtuCursorBegin(tTbxMbTp         transport,
+                                tTbxMbTpCursor * cursor,
+                                uint8_t        * pdu)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (cursor != NULL) && (pdu != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (cursor != NULL) && (pdu != NULL))
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
+    /* Determine the address field, in the same way as when transmitting the ADU. */
+    uint8_t aduHead[2];
+    if ((tpCtx->isClient == TBX_TRUE) || (tpCtx->anyNode == TBX_TRUE))
+    {
+      aduHead[0] = tpCtx->txPacket.node;
+    }
+    else
+    {
+      aduHead[0] = tpCtx->nodeAddr;
+    }
+    aduHead[1] = pdu[0];
+    /* Initialize the cursor such that it writes the bytes after the function code. */
+    cursor->ptr = &pdu[1];
+    cursor->checksum = TbxMbRtuCalculatCrc(aduHead, (uint16_t)sizeof(aduHead));
+    cursor->checksumFcn = TbxMbRtuUpdateCrc;
+  }
+} /*** end of TbxMbRtuCursorBegin ***/
+
+
 /************************************************************************************//**
 ** \brief     Validates a newly received communication packet, stored in the transport
 **            layer object.
@@ -787,6 +912,12 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
       {
         /* Increment the total number of received packets with an incorrect CRC. */
         tpCtx->diagInfo.busCommErrCnt++;
+        /* Log the communication error, in case we are a server. */
+        if (tpCtx->isClient == TBX_FALSE)
+        {
+          TbxMbTpCommEventAdd(&tpCtx->diagInfo, TBX_MB_COMM_EVENT_RECEIVE | 
+                                                TBX_MB_COMM_EVENT_RECEIVE_COMM_ERROR);
+        }
       }
       /* CRC16 check passed. */
       else
@@ -796,14 +927,23 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
          */
         if (tpCtx->isClient == TBX_FALSE)
         {
-          /* Only process frames that are addressed to us (unicast or broadcast). */
+          /* Only process frames that are addressed to us (unicast or broadcast). A
+           * server that serves any node, such as a gateway, processes all frames.
+           */
           if ((tpCtx->rxPacket.node == tpCtx->nodeAddr) ||
-              (tpCtx->rxPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST))
+              (tpCtx->rxPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST) ||
+              (tpCtx->anyNode == TBX_TRUE))
           {
             /* Increment the total number of received packets with a correct CRC, that
              * were addressed to us. Either via unicast of broadcast.
              */
             tpCtx->diagInfo.srvMsgCnt++;
+            /* Log the reception of the request. */
+            TbxMbTpCommEventAdd(&tpCtx->diagInfo, 
+                                (tpCtx->rxPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST) ?
+                                (TBX_MB_COMM_EVENT_RECEIVE | 
+                                 TBX_MB_COMM_EVENT_RECEIVE_BROADCAST) :
+                                TBX_MB_COMM_EVENT_RECEIVE);
             /* Set the node address in the txPacket node element. It is used during
              * transmission to decide if the actual sending of the response should be
              * suppressed, which is the case for TBX_MB_TP_NODE_ADDR_BROADCAST. No need
@@ -822,6 +962,10 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
           if ( (tpCtx->rxPacket.node >= TBX_MB_TP_NODE_ADDR_MIN) ||
                (tpCtx->rxPacket.node <= TBX_MB_TP_NODE_ADDR_MAX) )
           {
+            /* RTU frames do not hold a transaction identifier. With just one request
+             * awaiting a response, the response belongs to the last transmitted one.
+             */
+            tpCtx->rxPacket.transId = tpCtx->txPacket.transId;
             /* Packet is valid. Update the result accordingly. */
             result = TBX_OK;
           }
@@ -878,6 +1022,7 @@ static void TbxMbRtuTransmitComplete(tTbxMbUartPort port)
         /* Store the time that the transmission completed. */
         TbxCriticalSectionEnter();
         tpCtx->txDoneTime = TbxMbPortTimerCount();
+        tpCtx->txDone = TBX_TRUE;
         TbxCriticalSectionExit();
         /* Instruct the event task to start calling our polling function. Needed to
          * detect the 3.5 character timeout, after which we can transition back to the
@@ -1043,6 +1188,28 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
 ****************************************************************************************/
 static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data, 
                                     uint16_t         len)
+{
+  uint16_t result;
+
+  /* Start with the initial CRC16 value and run it over all the data bytes. */
+  result = TbxMbRtuUpdateCrc(0xFFFFU, data, len);
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuCalculatCrc ***/
+
+
+/************************************************************************************//**
+** \brief     Updates a running Modbus RTU defined CRC16 checksum with the bytes in the
+**            specified data array.
+** \param     crc The running CRC16 checksum value, 0xFFFF at the start.
+** \param     data Pointer to the byte array with data.
+** \param     len Number of data bytes to include in the CRC16 calculation.
+** \return    The updated CRC16 checksum value.
+**
+****************************************************************************************/
+static uint16_t TbxMbRtuUpdateCrc(uint16_t         crc,
+                                  uint8_t  const * data, 
+                                  uint16_t         len)
 {
   /* Lookup table for fast CRC16 calculation. Made static to lower the stack load. */
   static const uint16_t tbxMbRtuCrcTable[] =
@@ -1081,7 +1248,6 @@ static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data,
     0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
   };
   uint16_t result = 0U;
-  uint16_t crc = 0xFFFFU;
 
   /* Loop over all the data bytes. */
   for (uint16_t byteIdx = 0; byteIdx < len; byteIdx++)
@@ -1095,7 +1261,7 @@ static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data,
   result = crc;
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbRtuCalculatCrc ***/
+} /*** end of TbxMbRtuUpdateCrc ***/
 
 
 /*********************************** end of tbxmb_rtu.c ********************************/
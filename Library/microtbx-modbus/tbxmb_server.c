@@ -45,47 +45,160 @@
 /** \brief Unique context type to identify a context as being a server channel. */
 #define TBX_MB_SERVER_CONTEXT_TYPE     (37U)
 
+/** \brief Unique context type to identify a context as being a server FIFO queue. */
+#define TBX_MB_SERVER_FIFO_CONTEXT_TYPE (24U)
+
+/** \brief Unique context type to identify a context as being a server register image. */
+#define TBX_MB_SERVER_IMAGE_CONTEXT_TYPE (30U)
+
+#ifndef TBX_MB_SERVER_BUILTIN_HANDLERS_ENABLE
+/** \brief Configuration macro to register the built-in function code handlers with
+ *         each newly created server. Set it to 0 to start out with an empty handler
+ *         table instead. The application then registers just the handlers it needs with
+ *         TbxMbServerSetHandler(), such that the linker can leave out the unused ones.
+ *         You can override this configuration by adding a macro with the same name, to
+ *         "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_BUILTIN_HANDLERS_ENABLE (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_IMAGE_READ_RETRIES
+/** \brief Maximum number of attempts for reading a consistent snapshot from a register
+ *         image. A new attempt is only needed in the rare case that the application
+ *         published an update, while the server was reading from the image. Only when
+ *         the application publishes updates back-to-back, faster than the server can
+ *         read the snapshot, all attempts fail and the server responds with a server
+ *         device failure exception. You can override this configuration by adding a
+ *         macro with the same name, to "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_IMAGE_READ_RETRIES (8U)
+#endif
+
+#ifndef TBX_MB_SERVER_PENDING_TIMEOUT_MS
+/** \brief Maximum time in milliseconds that a request can stay parked, after a callback
+ *         function returned TBX_MB_SERVER_PENDING. When the application does not call
+ *         TbxMbServerCompleteRequest() in time, the server drops the request without
+ *         responding. By then the client already timed out and possibly moved on to its
+ *         next request. Keep it below the response timeout of the client. You can
+ *         override this configuration by adding a macro with the same name, to
+ *         "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_PENDING_TIMEOUT_MS (500U)
+#endif
+
+/** \brief Internal exception code that a function code handler reports, when one of the
+ *         callback functions returned TBX_MB_SERVER_PENDING. It is never transmitted.
+ */
+#define TBX_MB_SERVER_EC_PENDING       (0U)
+
+/** \brief No request is parked. */
+#define TBX_MB_SERVER_PENDING_NONE     (0U)
+
+/** \brief A request is parked, waiting for the application to complete it. */
+#define TBX_MB_SERVER_PENDING_PARKED   (1U)
+
+/** \brief The application completed the parked request. */
+#define TBX_MB_SERVER_PENDING_COMPLETED (2U)
+
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
+static void TbxMbServerPoll                  (tTbxMbServer            channel);
+
 static void TbxMbServerProcessEvent          (tTbxMbEvent           * event);
 
-static void TbxMbServerFC01ReadCoils         (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static uint8_t TbxMbServerFastPath           (void                  * channelCtx);
 
-static void TbxMbServerFC02ReadInputs        (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static void TbxMbServerHandle                (tTbxMbServerCtx       * context,
+                                              uint8_t         const * rxPdu,
+                                              uint8_t               * txPdu,
+                                              uint8_t               * len);
 
-static void TbxMbServerFC03ReadHoldingRegs   (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static uint8_t TbxMbServerIsPending          (tTbxMbTpPacket  const * txPacket);
 
-static void TbxMbServerFC04ReadInputRegs     (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static uint8_t TbxMbServerModelEnter         (tTbxMbServerCtx       * model,
+                                              tTbxMbServerCtx const * channel);
 
-static void TbxMbServerFC05WriteSingleCoil   (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static void TbxMbServerModelExit             (tTbxMbServerCtx       * model);
 
-static void TbxMbServerFC06WriteSingleReg    (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static void TbxMbServerModelUnbind           (tTbxMbServerCtx       * channel);
 
-static void TbxMbServerFC08Diagnostics       (tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+static uint8_t TbxMbServerFileSubReqCheck    (uint8_t         const * subReq);
+
+static uint8_t TbxMbServerDeviceIdConformity (tTbxMbServerCtx       * context);
+
+static uint8_t TbxMbServerExceptionCode      (tTbxMbServerResult      srvResult);
+
+static uint8_t TbxMbServerImageServes        (tTbxMbServerCtx       * context,
+                                              tTbxMbServerTable       table);
+
+static uint8_t TbxMbServerImageRespond       (tTbxMbServerCtx       * context,
+                                              tTbxMbServerTable       table,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              uint8_t               * txPdu);
+
+static size_t TbxMbServerImageCopySize       (tTbxMbServerTable       table,
+                                              uint16_t                num);
+
+static uint8_t TbxMbServerBitmapRespond      (tTbxMbServerBitmap const * bitmap,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              uint8_t               * txPdu);
+
+static tTbxMbServerResult TbxMbServerBitmapWrite(tTbxMbServerBitmap       * bitmap,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              uint8_t         const * bits);
+
+static uint8_t TbxMbServerRegArrayRespond    (tTbxMbServerRegArray const * array,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              uint8_t               * txPdu,
+                                              tTbxMbTpCtx           * tpCtx);
 
-static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
+static tTbxMbServerResult TbxMbServerRegArrayWrite(tTbxMbServerRegArray     * array,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              uint8_t         const * data);
+
+static void TbxMbServerChangesPush           (tTbxMbServerCtx       * context,
+                                              tTbxMbServerTable       table,
+                                              uint16_t                addr,
+                                              uint16_t                num);
+
+static tTbxMbServerBitmap * TbxMbServerDirtyBitmap(tTbxMbServerCtx  * context,
+                                              tTbxMbServerTable       table);
+
+static void TbxMbServerDirtyMark             (tTbxMbServerCtx       * context,
+                                              tTbxMbServerTable       table,
+                                              uint16_t                addr,
+                                              uint16_t                num);
+
+static uint8_t TbxMbServerBitCount           (uint32_t                word);
+
+static void TbxMbServerBitsPack              (uint32_t const volatile * words,
+                                              uint16_t                offset,
+                                              uint16_t                num,
+                                              uint8_t               * bits);
+
+static void TbxMbServerBitsMerge             (uint8_t         const * bits,
+                                              uint16_t                num,
+                                              uint32_t              * words,
+                                              uint16_t                offset);
+
+static uint32_t TbxMbServerCacheImageSeq     (tTbxMbServerCtx const * context);
+
+static uint8_t TbxMbServerCacheLookup        (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
 
-static void TbxMbServerFC16WriteMultipleRegs (tTbxMbServerCtx       * context,
+static void TbxMbServerCacheStore            (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket);
+                                              tTbxMbTpPacket  const * txPacket,
+                                              uint32_t                generation,
+                                              uint32_t                imageSeq);
 
 
 /************************************************************************************//**
@@ -135,7 +248,7 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
       /* Initialize the channel context. Start by crosslinking the transport layer. */
       newServerCtx->type = TBX_MB_SERVER_CONTEXT_TYPE;
       newServerCtx->instancePtr = NULL;
-      newServerCtx->pollFcn = NULL;
+      newServerCtx->pollFcn = TbxMbServerPoll;
       newServerCtx->processFcn = TbxMbServerProcessEvent;
       newServerCtx->readInputFcn = NULL;
       newServerCtx->readCoilFcn = NULL;
@@ -143,8 +256,93 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
       newServerCtx->readInputRegFcn = NULL;
       newServerCtx->readHoldingRegFcn = NULL;
       newServerCtx->writeHoldingRegFcn = NULL;
+      newServerCtx->validateCoilsFcn = NULL;
+      newServerCtx->commitCoilsFcn = NULL;
+      newServerCtx->validateHoldingRegsFcn = NULL;
+      newServerCtx->commitHoldingRegsFcn = NULL;
+      newServerCtx->readDeviceIdFcn = NULL;
+      newServerCtx->reportServerIdFcn = NULL;
+      newServerCtx->devIdConformity = 0U;
+      newServerCtx->devIdLastObj = 0U;
+      newServerCtx->readFileRecordFcn = NULL;
+      newServerCtx->writeFileRecordFcn = NULL;
+      newServerCtx->fifoList = NULL;
+      newServerCtx->imageCtx = NULL;
+      newServerCtx->coilBitmap.addr = 0U;
+      newServerCtx->coilBitmap.num = 0U;
+      newServerCtx->coilBitmap.words = NULL;
+      newServerCtx->inputBitmap.addr = 0U;
+      newServerCtx->inputBitmap.num = 0U;
+      newServerCtx->inputBitmap.words = NULL;
+      newServerCtx->holdingRegArray.addr = 0U;
+      newServerCtx->holdingRegArray.num = 0U;
+      newServerCtx->holdingRegArray.regs = NULL;
+      newServerCtx->changes.slots = 0U;
+      newServerCtx->changes.buffer = NULL;
+      newServerCtx->changes.head = 0U;
+      newServerCtx->changes.tail = 0U;
+      newServerCtx->changes.lost = 0U;
+      newServerCtx->coilDirty.addr = 0U;
+      newServerCtx->coilDirty.num = 0U;
+      newServerCtx->coilDirty.words = NULL;
+      newServerCtx->holdingRegDirty.addr = 0U;
+      newServerCtx->holdingRegDirty.num = 0U;
+      newServerCtx->holdingRegDirty.words = NULL;
+      newServerCtx->cacheEntries = NULL;
+      newServerCtx->cacheSize = 0U;
+      newServerCtx->cacheNext = 0U;
+      newServerCtx->cacheGeneration = 0U;
+      newServerCtx->cacheHits = 0U;
+      newServerCtx->cacheMisses = 0U;
       newServerCtx->customFunctionFcn = NULL;
+      newServerCtx->pendingState = TBX_MB_SERVER_PENDING_NONE;
+      newServerCtx->pendingDataLen = 0U;
+      newServerCtx->pendingNode = 0U;
+      newServerCtx->pendingTickTime = 0U;
+      newServerCtx->pendingElapsedMs = 0U;
+      for (uint8_t idx = 0U; idx < TBX_MB_SERVER_HANDLERS_NUM; idx++)
+      {
+        newServerCtx->handlers[idx] = NULL;
+      }
+#if (TBX_MB_SERVER_BUILTIN_HANDLERS_ENABLE > 0U)
+      /* Register the built-in function code handlers. */
+      newServerCtx->handlers[TBX_MB_FC01_READ_COILS] = TbxMbServerFC01ReadCoils;
+      newServerCtx->handlers[TBX_MB_FC02_READ_DISCRETE_INPUTS] = 
+        TbxMbServerFC02ReadInputs;
+      newServerCtx->handlers[TBX_MB_FC03_READ_HOLDING_REGISTERS] = 
+        TbxMbServerFC03ReadHoldingRegs;
+      newServerCtx->handlers[TBX_MB_FC04_READ_INPUT_REGISTERS] = 
+        TbxMbServerFC04ReadInputRegs;
+      newServerCtx->handlers[TBX_MB_FC05_WRITE_SINGLE_COIL] = 
+        TbxMbServerFC05WriteSingleCoil;
+      newServerCtx->handlers[TBX_MB_FC06_WRITE_SINGLE_REGISTER] = 
+        TbxMbServerFC06WriteSingleReg;
+      newServerCtx->handlers[TBX_MB_FC08_DIAGNOSTICS] = TbxMbServerFC08Diagnostics;
+      newServerCtx->handlers[TBX_MB_FC11_GET_COMM_EVENT_COUNTER] = 
+        TbxMbServerFC11GetCommEventCounter;
+      newServerCtx->handlers[TBX_MB_FC12_GET_COMM_EVENT_LOG] = 
+        TbxMbServerFC12GetCommEventLog;
+      newServerCtx->handlers[TBX_MB_FC15_WRITE_MULTIPLE_COILS] = 
+        TbxMbServerFC15WriteMultipleCoils;
+      newServerCtx->handlers[TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS] = 
+        TbxMbServerFC16WriteMultipleRegs;
+      newServerCtx->handlers[TBX_MB_FC17_REPORT_SERVER_ID] = 
+        TbxMbServerFC17ReportServerId;
+      newServerCtx->handlers[TBX_MB_FC20_READ_FILE_RECORD] = 
+        TbxMbServerFC20ReadFileRecord;
+      newServerCtx->handlers[TBX_MB_FC21_WRITE_FILE_RECORD] = 
+        TbxMbServerFC21WriteFileRecord;
+      newServerCtx->handlers[TBX_MB_FC24_READ_FIFO_QUEUE] = TbxMbServerFC24ReadFifoQueue;
+      newServerCtx->handlers[TBX_MB_FC43_ENCAPSULATED_INTERFACE] = 
+        TbxMbServerFC43ReadDeviceId;
+#endif /* (TBX_MB_SERVER_BUILTIN_HANDLERS_ENABLE > 0U) */
       newServerCtx->tpCtx = tpCtx;
+      newServerCtx->modelCtx = newServerCtx;
+      newServerCtx->boundList = NULL;
+      newServerCtx->boundNext = NULL;
+      newServerCtx->requestTpCtx = tpCtx;
+      newServerCtx->modelLocked = TBX_FALSE;
+      newServerCtx->modelBusy = TBX_FALSE;
       newServerCtx->tpCtx->channelCtx = newServerCtx;
       newServerCtx->tpCtx->isClient = TBX_FALSE;
       /* Update the result. */
@@ -174,8 +372,26 @@ void TbxMbServerFree(tTbxMbServer channel)
     tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Instruct the event task to stop calling our polling function, in case a request
+     * is still parked.
+     */
+    if (serverCtx->pendingState != TBX_MB_SERVER_PENDING_NONE)
+    {
+      tTbxMbEvent newEvent;
+      newEvent.context = serverCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+    /* Channels bound to our data model go back to serving their own. */
+    while (serverCtx->boundList != NULL)
+    {
+      TbxMbServerModelUnbind(serverCtx->boundList);
+    }
+    /* Stop serving the data model of another channel. */
+    TbxMbServerModelUnbind(serverCtx);
     /* Remove crosslink between the channel and the transport layer. */
     TbxCriticalSectionEnter();
+    serverCtx->tpCtx->fastPathFcn = NULL;
     serverCtx->tpCtx->channelCtx = NULL;
     serverCtx->tpCtx = NULL;
     /* Invalidate the context to protect it from accidentally being used afterwards. */
@@ -183,6 +399,39 @@ void TbxMbServerFree(tTbxMbServer channel)
     serverCtx->pollFcn = NULL;
     serverCtx->processFcn = NULL;
     TbxCriticalSectionExit();
+    /* Give the FIFO queues back to the memory pool. */
+    while (serverCtx->fifoList != NULL)
+    {
+      tTbxMbServerFifoCtx * fifoCtx = serverCtx->fifoList;
+      serverCtx->fifoList = fifoCtx->next;
+      /* Invalidate the context to protect it from accidentally being used afterwards. */
+      fifoCtx->type = 0U;
+      TbxMemPoolRelease((void *)fifoCtx->buffer);
+      TbxMemPoolRelease(fifoCtx);
+    }
+    /* Give the response cache back to the memory pool. */
+    if (serverCtx->cacheEntries != NULL)
+    {
+      TbxMemPoolRelease(serverCtx->cacheEntries);
+      serverCtx->cacheEntries = NULL;
+    }
+    /* Give the change queue back to the memory pool. */
+    if (serverCtx->changes.buffer != NULL)
+    {
+      TbxMemPoolRelease((void *)serverCtx->changes.buffer);
+      serverCtx->changes.buffer = NULL;
+    }
+    /* Give the dirty bitmaps back to the memory pool. */
+    if (serverCtx->coilDirty.words != NULL)
+    {
+      TbxMemPoolRelease(serverCtx->coilDirty.words);
+      serverCtx->coilDirty.words = NULL;
+    }
+    if (serverCtx->holdingRegDirty.words != NULL)
+    {
+      TbxMemPoolRelease(serverCtx->holdingRegDirty.words);
+      serverCtx->holdingRegDirty.words = NULL;
+    }
     /* Give the channel context back to the memory pool. */
     TbxMemPoolRelease(serverCtx);
   }
@@ -358,1119 +607,5419 @@ void TbxMbServerSetCallbackWriteHoldingReg(tTbxMbServer                channel,
 
 
 /************************************************************************************//**
-** \brief     Registers the callback function that this server calls, whenever it
-**            received a PDU containing a function code not currently supported. With the
-**            aid of this callback function the user can implement support for new
-**            function codes.
+** \brief     Registers the callback functions that this server calls, whenever a client
+**            requests the writing of multiple coils. With these callback functions
+**            registered, the write operation is transactional: The stack first validates
+**            the entire block and only then commits it with a single call. This way
+**            coils are either all written or not at all and the application never sees
+**            a partially processed request.
+** \details   The validation callback is optional. Set it to NULL if the commit callback
+**            performs all checks before writing anything.
+**            Note that these callback functions take precedence over the single coil
+**            write callback for function code 15 - Write Multiple Coils. Function code
+**            5 - Write Single Coil uses them for a block of one coil, in case no single
+**            coil write callback was registered.
 ** \param     channel Handle to the Modbus server channel object.
-** \param     callback Pointer to the callback function.
+** \param     validate Pointer to the validation callback function or NULL.
+** \param     commit Pointer to the commit callback function.
 **
 ****************************************************************************************/
-void TbxMbServerSetCallbackCustomFunction(tTbxMbServer               channel,
-                                          tTbxMbServerCustomFunction callback)
+void TbxMbServerSetCallbackWriteCoils(tTbxMbServer           channel,
+                                      tTbxMbServerWriteCoils validate,
+                                      tTbxMbServerWriteCoils commit)
 {
   /* Verify parameters. */
-  TBX_ASSERT((channel != NULL) && (callback != NULL));
+  TBX_ASSERT((channel != NULL) && (commit != NULL));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (callback != NULL))
+  if ((channel != NULL) && (commit != NULL))
   {
     /* Convert the server channel pointer to the context structure. */
     tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
-    /* Store the callback function pointer. */
+    /* Store the callback function pointers. */
     TbxCriticalSectionEnter();
-    serverCtx->customFunctionFcn = callback;
+    serverCtx->validateCoilsFcn = validate;
+    serverCtx->commitCoilsFcn = commit;
     TbxCriticalSectionExit();
   }
-} /*** end of TbxMbServerSetCallbackCustomFunction ***/
+} /*** end of TbxMbServerSetCallbackWriteCoils ***/
 
 
 /************************************************************************************//**
-** \brief     Event processing function that is automatically called when an event for
-**            this server channel object was received in TbxMbEventTask().
-** \param     event Pointer to the event to process. Note that the event->context points
-**            to the handle of the Modbus server channel object.
+** \brief     Registers the callback functions that this server calls, whenever a client
+**            requests the writing of multiple holding registers. With these callback
+**            functions registered, the write operation is transactional: The stack first
+**            validates the entire block and only then commits it with a single call.
+**            This way holding registers are either all written or not at all and the
+**            application never sees a partially processed request.
+** \details   The validation callback is optional. Set it to NULL if the commit callback
+**            performs all checks before writing anything.
+**            Note that these callback functions take precedence over the single holding
+**            register write callback for function code 16 - Write Multiple Registers.
+**            Function code 6 - Write Single Register uses them for a block of one
+**            register, in case no single holding register write callback was registered.
+** \param     channel Handle to the Modbus server channel object.
+** \param     validate Pointer to the validation callback function or NULL.
+** \param     commit Pointer to the commit callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+void TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer                 channel,
+                                            tTbxMbServerWriteHoldingRegs validate,
+                                            tTbxMbServerWriteHoldingRegs commit)
 {
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((channel != NULL) && (commit != NULL));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((channel != NULL) && (commit != NULL))
   {
-    /* Sanity check the context. */
-    TBX_ASSERT(event->context != NULL);
-    /* Convert the event context to the server channel context structure. */
-    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
-    /* Make sure the context is valid. */
-    TBX_ASSERT(serverCtx != NULL);
-    /* Only continue with a valid context. */
-    if (serverCtx != NULL)
-    {
-      /* Sanity check on the context type. */
-      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
-      /* Filter on the event identifier. */
-      switch (event->id)
-      {
-        case TBX_MB_EVENT_ID_PDU_RECEIVED:
-        {
-          uint8_t okayToSendResponse = TBX_FALSE;
-          /* Obtain read access to the newly received packet and write access to the
-           * response packet. 
-           */
-          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
-          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
-          /* Since we're requested to process a newly received PDU, these packet accesses
-           * should always succeed. Sanity check anyways, just in case.
-           */
-          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
-          /* Only continue with packet access. */
-          if ((rxPacket != NULL) && (txPacket != NULL))
-          {
-            /* Update flag that we can actually send a response, now that we know we 
-             * have access to txPacket.
-             */
-            okayToSendResponse = TBX_TRUE;
-            /* Prepare the response packet function code. */
-            txPacket->pdu.code = rxPacket->pdu.code;
-            /* Filter on the function code. */
-            switch (rxPacket->pdu.code)
-            {
-              /* ---------------- FC01 - Read Coils ---------------------------------- */
-              case TBX_MB_FC01_READ_COILS:
-              {
-                TbxMbServerFC01ReadCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC02 - Read Discrete Inputs ------------------------ */
-              case TBX_MB_FC02_READ_DISCRETE_INPUTS:
-              {
-                TbxMbServerFC02ReadInputs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC03 - Read Holding Registers ---------------------- */
-              case TBX_MB_FC03_READ_HOLDING_REGISTERS:
-              {
-                TbxMbServerFC03ReadHoldingRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC04 - Read Input Registers ------------------------ */
-              case TBX_MB_FC04_READ_INPUT_REGISTERS:
-              {
-                TbxMbServerFC04ReadInputRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC05 - Write Single Coil --------------------------- */
-              case TBX_MB_FC05_WRITE_SINGLE_COIL:
-              {
-                TbxMbServerFC05WriteSingleCoil(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC06 - Write Single Register ----------------------- */
-              case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
-              {
-                TbxMbServerFC06WriteSingleReg(serverCtx, rxPacket, txPacket);
-              }
-              break;
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointers. */
+    TbxCriticalSectionEnter();
+    serverCtx->validateHoldingRegsFcn = validate;
+    serverCtx->commitHoldingRegsFcn = commit;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteHoldingRegs ***/
 
-              /* ---------------- FC08 - Diagnostics --------------------------------- */
-              case TBX_MB_FC08_DIAGNOSTICS:
-              {
-                TbxMbServerFC08Diagnostics(serverCtx, rxPacket, txPacket);
-              }
-              break;
 
-              /* ---------------- FC15 - Write Multiple Coils ------------------------ */
-              case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
-              {
-                TbxMbServerFC15WriteMultipleCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a specific device identification object.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadDeviceId(tTbxMbServer             channel,
+                                        tTbxMbServerReadDeviceId callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
-              /* ---------------- FC16 - Write Multiple Registers -------------------- */
-              case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
-              {
-                TbxMbServerFC16WriteMultipleRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. Also reset the cached conformity level and
+     * last object, such that they are determined again with the aid of the new
+     * callback function.
+     */
+    TbxCriticalSectionEnter();
+    serverCtx->readDeviceIdFcn = callback;
+    serverCtx->devIdConformity = 0U;
+    serverCtx->devIdLastObj = 0U;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadDeviceId ***/
 
-              /* ---------------- Unsupported function code -------------------------- */
-              default:
-              {
-                uint8_t handled = TBX_FALSE;
 
-                /* Is a custom function code callback configured? */
-                if (serverCtx->customFunctionFcn != NULL)
-                {
-                  /* Prepare callback parameters. */
-                  uint8_t const * rxPdu  = &rxPacket->pdu.code;
-                  uint8_t       * txPdu  = &txPacket->pdu.code;
-                  uint8_t         pduLen = rxPacket->dataLen + 1U;
-                  /* Call the custom function code callback. */
-                  handled = serverCtx->customFunctionFcn(serverCtx, rxPdu, txPdu, 
-                                                         &pduLen);
-                  /* Did the callback process the PDU and prepare a response? */
-                  if (handled == TBX_TRUE)
-                  {
-                    /* Set the response data length. */
-                    txPacket->dataLen = pduLen - 1U;
-                  }
-                }
-                /* Did the custom function code callback not handle the PDU? */
-                if (handled == TBX_FALSE)
-                {
-                  /* This function code is currently not supported. */
-                  txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-                  txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-                  txPacket->dataLen = 1U;
-                }
-              }
-              break;
-            }
-          }
-          /* Inform the transport layer that were done with the rx packet and no longer
-           * need access to it.
-           */
-          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
-          /* Request the transport layer to transmit the response. Note that
-           * transmitFcn() should only be called after calling receptionDoneFcn().
-           */
-          if (okayToSendResponse == TBX_TRUE)
-          {
-            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
-          }
-        }
-        break;
-      
-        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
-        {
-          /* At this point no additional event handling is needed on this channel upon
-           * PDU transmission completion.
-           */
-        }
-        break;
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the server ID report.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReportServerId(tTbxMbServer               channel,
+                                          tTbxMbServerReportServerId callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
-        default:
-        {
-          /* An unsupported event was dispatched to us. Should not happen. */
-          TBX_ASSERT(TBX_FALSE);
-        }
-        break;
-      }
-    }
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->reportServerIdFcn = callback;
+    TbxCriticalSectionExit();
   }
-} /*** end of TbxMbServerProcessEvent ***/
+} /*** end of TbxMbServerSetCallbackReportServerId ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 1 - Read Coils.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a block of registers from a file record.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
-                                     tTbxMbTpPacket  const * rxPacket,
-                                     tTbxMbTpPacket        * txPacket)
+void TbxMbServerSetCallbackReadFileRecord(tTbxMbServer               channel,
+                                          tTbxMbServerReadFileRecord callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readFileRecordFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadFileRecord ***/
 
-    /* Check if a callback function was registered. */
-    if (context->readCoilFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a block of registers to a file record.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                channel,
+                                           tTbxMbServerWriteFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->writeFileRecordFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever it
+**            received a PDU containing a function code not currently supported. With the
+**            aid of this callback function the user can implement support for new
+**            function codes.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackCustomFunction(tTbxMbServer               channel,
+                                          tTbxMbServerCustomFunction callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->customFunctionFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackCustomFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the handler that this server calls, whenever it received a PDU
+**            with the specified function code. Use it to register individual built-in
+**            handlers, such as TbxMbServerFC03ReadHoldingRegs(), or to replace one with
+**            an application specific handler. Function codes without a handler are
+**            forwarded to the custom function code callback, if one is registered.
+** \param     channel Handle to the Modbus server channel object.
+** \param     code Function code (1..127).
+** \param     handler Pointer to the handler function or NULL to remove the handler.
+**
+****************************************************************************************/
+void TbxMbServerSetHandler(tTbxMbServer        channel,
+                           uint8_t             code,
+                           tTbxMbServerHandler handler)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (code > 0U) && (code < TBX_MB_SERVER_HANDLERS_NUM));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (code > 0U) && (code < TBX_MB_SERVER_HANDLERS_NUM))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the handler function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->handlers[code] = handler;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetHandler ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a FIFO queue object for the server, which a client can read out
+**            with function code 24 - Read FIFO Queue. Use TbxMbServerFifoPush() to add
+**            values to the FIFO queue. The FIFO queue objects are automatically released
+**            when calling TbxMbServerFree().
+** \details   A client can read out at most 31 values per request. When more values are
+**            queued, the oldest 31 values are included in the response and the remaining
+**            ones stay queued for the next request. Size the FIFO queue such that it can
+**            hold all values produced in between two read requests.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr FIFO pointer address that clients use to access the FIFO queue.
+** \param     size Maximum number of values that the FIFO queue can hold.
+** \return    Handle to the newly created FIFO queue object if successful, NULL 
+**            otherwise. Creating a FIFO queue fails if the server already has one with
+**            the same FIFO pointer address.
+**
+****************************************************************************************/
+tTbxMbServerFifo TbxMbServerFifoCreate(tTbxMbServer channel,
+                                       uint16_t     addr,
+                                       uint16_t     size)
+{
+  tTbxMbServerFifo result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (size > 0U) && (size < 0xFFFFU));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (size > 0U) && (size < 0xFFFFU))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Search for a FIFO queue that already uses the same FIFO pointer address. */
+    tTbxMbServerFifoCtx * fifoCtx = serverCtx->fifoList;
+    while ((fifoCtx != NULL) && (fifoCtx->addr != addr))
+    {
+      fifoCtx = fifoCtx->next;
+    }
+    /* Only continue if the FIFO pointer address is still available. Otherwise a
+     * client could never access the second FIFO queue.
+     */
+    if (fifoCtx == NULL)
+    {
+      /* Determine the size of the ring buffer. It needs one extra slot. */
+      size_t bufferSize = ((size_t)size + 1U) * sizeof(uint16_t);
+      /* Allocate memory for the new FIFO queue context and its ring buffer. */
+      tTbxMbServerFifoCtx * newFifoCtx;
+      newFifoCtx = TbxMemPoolAllocate(sizeof(tTbxMbServerFifoCtx));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newFifoCtx == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbServerFifoCtx));
+        newFifoCtx = TbxMemPoolAllocate(sizeof(tTbxMbServerFifoCtx));      
+      }
+      uint16_t * newBuffer = TbxMemPoolAllocate(bufferSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newBuffer == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, bufferSize);
+        newBuffer = TbxMemPoolAllocate(bufferSize);      
+      }
+      /* Verify memory allocation of the FIFO queue context and its ring buffer. */
+      TBX_ASSERT((newFifoCtx != NULL) && (newBuffer != NULL));
+      /* Only continue if the memory allocation succeeded. */
+      if ((newFifoCtx != NULL) && (newBuffer != NULL))
+      {
+        /* Initialize the FIFO queue context. */
+        newFifoCtx->type = TBX_MB_SERVER_FIFO_CONTEXT_TYPE;
+        newFifoCtx->addr = addr;
+        newFifoCtx->slots = size + 1U;
+        newFifoCtx->buffer = newBuffer;
+        newFifoCtx->head = 0U;
+        newFifoCtx->tail = 0U;
+        /* Add it to the server's FIFO queue list. */
+        TbxCriticalSectionEnter();
+        newFifoCtx->next = serverCtx->fifoList;
+        serverCtx->fifoList = newFifoCtx;
+        TbxCriticalSectionExit();
+        /* Update the result. */
+        result = newFifoCtx;
+      }
+      /* Memory allocation only partially succeeded. */
+      else
+      {
+        /* Give the allocated memory back to the memory pool. */
+        if (newFifoCtx != NULL)
+        {
+          TbxMemPoolRelease(newFifoCtx);
+        }
+        if (newBuffer != NULL)
+        {
+          TbxMemPoolRelease(newBuffer);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFifoCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a value to the FIFO queue. This function is lock-free and can be
+**            called from an interrupt service routine, for example the one that samples
+**            the value. Note that there can only be one producer per FIFO queue. In
+**            other words, do not call this function for the same FIFO queue from
+**            different contexts.
+** \param     fifo Handle to the Modbus server FIFO queue object.
+** \param     value The value to add to the FIFO queue.
+** \return    TBX_OK if successful, TBX_ERROR if the FIFO queue is full.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFifoPush(tTbxMbServerFifo fifo,
+                            uint16_t         value)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(fifo != NULL);
+
+  /* Only continue with valid parameters. */
+  if (fifo != NULL)
+  {
+    /* Convert the FIFO queue pointer to the context structure. */
+    tTbxMbServerFifoCtx * fifoCtx = (tTbxMbServerFifoCtx *)fifo;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(fifoCtx->type == TBX_MB_SERVER_FIFO_CONTEXT_TYPE);
+    /* Determine where the head index moves to after the push. */
+    uint16_t head = fifoCtx->head;
+    uint16_t nextHead = head + 1U;
+    if (nextHead >= fifoCtx->slots)
+    {
+      nextHead = 0U;
+    }
+    /* Only continue if the FIFO queue is not full. */
+    if (nextHead != fifoCtx->tail)
+    {
+      /* Store the value before moving the head index. This way the consumer never
+       * reads a slot that is not yet written. Both the buffer and the head index are
+       * volatile, so the compiler cannot reorder these two writes.
+       */
+      fifoCtx->buffer[head] = value;
+      fifoCtx->head = nextHead;
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFifoPush ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of values currently stored in the FIFO queue.
+** \param     fifo Handle to the Modbus server FIFO queue object.
+** \return    Number of values in the FIFO queue.
+**
+****************************************************************************************/
+uint16_t TbxMbServerFifoCount(tTbxMbServerFifo fifo)
+{
+  uint16_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(fifo != NULL);
+
+  /* Only continue with valid parameters. */
+  if (fifo != NULL)
+  {
+    /* Convert the FIFO queue pointer to the context structure. */
+    tTbxMbServerFifoCtx * fifoCtx = (tTbxMbServerFifoCtx *)fifo;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(fifoCtx->type == TBX_MB_SERVER_FIFO_CONTEXT_TYPE);
+    /* Take a snapshot of the indices. */
+    uint16_t head = fifoCtx->head;
+    uint16_t tail = fifoCtx->tail;
+    /* Determine the number of values, taking into account the wrap around. */
+    if (head >= tail)
+    {
+      result = head - tail;
+    }
+    else
+    {
+      result = (fifoCtx->slots - tail) + head;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFifoCount ***/
+
+
+/************************************************************************************//**
+** \brief     Assigns a register image to the server. Once assigned, the server serves
+**            function codes 01 - 04 for the data tables configured in the image directly
+**            from its published snapshot, instead of calling the read callback
+**            functions. Each response is built from a single snapshot, so values that
+**            span multiple registers, such as a 32-bit float, are never torn.
+** \details   Note that write requests are still forwarded to the write callback
+**            functions. From there, the application can publish the newly written values
+**            to the image. The same image can be assigned to multiple servers.
+** \param     channel Handle to the Modbus server channel object.
+** \param     image Handle to the register image object or NULL to remove the image.
+**
+****************************************************************************************/
+void TbxMbServerSetImage(tTbxMbServer      channel,
+                         tTbxMbServerImage image)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Sanity check on the image context type. */
+    TBX_ASSERT((image == NULL) || (((tTbxMbServerImageCtx *)image)->type == 
+                                   TBX_MB_SERVER_IMAGE_CONTEXT_TYPE));
+    /* Store the register image pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->imageCtx = (tTbxMbServerImageCtx *)image;
+    TbxCriticalSectionExit();
+    /* Responses in the cache might have been built from the previous image. */
+    TbxMbServerCacheInvalidate(serverCtx);
+  }
+} /*** end of TbxMbServerSetImage ***/
+
+
+/************************************************************************************//**
+** \brief     Assigns a bitmap with the coils to the server. Once assigned, the server
+**            reads and writes the coils for function codes 01, 05 and 15 directly in the
+**            bitmap, instead of calling the coil callback functions. The bits are
+**            copied with shifts and masks, one 32-bit word at a time.
+** \details   The coil at "addr" is stored in bit 0 of words[0], the next one in bit 1,
+**            etc. Coil "addr + n" is in bit (n % 32) of words[n / 32]. The bitmap is
+**            owned by the application. Note that the server writes whole words, so the
+**            application should only modify the bitmap from the same task as the one
+**            that calls TbxMbEventTask(), or from within a critical section. Whenever
+**            the application changes a coil, it should call TbxMbServerCacheInvalidate()
+**            in case the response cache is enabled.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Element address of the first coil in the bitmap.
+** \param     num Number of coils in the bitmap.
+** \param     words Pointer to the array with the coil bits, consisting of at least
+**            (num + 31) / 32 words. NULL to remove the bitmap.
+**
+****************************************************************************************/
+void TbxMbServerSetCoilBitmap(tTbxMbServer   channel,
+                              uint16_t       addr,
+                              uint16_t       num,
+                              uint32_t     * words)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && 
+             ((words == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && 
+      ((words == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the bitmap configuration. */
+    TbxCriticalSectionEnter();
+    serverCtx->coilBitmap.addr = addr;
+    serverCtx->coilBitmap.num = num;
+    serverCtx->coilBitmap.words = words;
+    TbxCriticalSectionExit();
+    /* Responses in the cache might have been built from the previous coils. */
+    TbxMbServerCacheInvalidate(serverCtx);
+  }
+} /*** end of TbxMbServerSetCoilBitmap ***/
+
+
+/************************************************************************************//**
+** \brief     Assigns an array with the holding registers to the server. Once assigned,
+**            the server reads and writes the holding registers for function codes 03, 06
+**            and 16 directly in the array, instead of calling the holding register
+**            callback functions.
+** \details   Holding register "addr + n" is stored in regs[n]. The array is owned by the
+**            application. Combine it with TbxMbServerChangesEnable() to find out which
+**            registers a client wrote. Whenever the application changes a register, it
+**            should call TbxMbServerCacheInvalidate() in case the response cache is
+**            enabled.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Element address of the first holding register in the array.
+** \param     num Number of holding registers in the array.
+** \param     regs Pointer to the array with the register values. NULL to remove the
+**            array.
+**
+****************************************************************************************/
+void TbxMbServerSetHoldingRegArray(tTbxMbServer   channel,
+                                   uint16_t       addr,
+                                   uint16_t       num,
+                                   uint16_t     * regs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && 
+             ((regs == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && 
+      ((regs == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the array configuration. */
+    TbxCriticalSectionEnter();
+    serverCtx->holdingRegArray.addr = addr;
+    serverCtx->holdingRegArray.num = num;
+    serverCtx->holdingRegArray.regs = regs;
+    TbxCriticalSectionExit();
+    /* Responses in the cache might have been built from the previous registers. */
+    TbxMbServerCacheInvalidate(serverCtx);
+  }
+} /*** end of TbxMbServerSetHoldingRegArray ***/
+
+
+/************************************************************************************//**
+** \brief     Assigns a bitmap with the discrete inputs to the server. Once assigned,
+**            the server reads the discrete inputs for function code 02 directly from the
+**            bitmap, instead of calling the read input callback function. The bits are
+**            copied with shifts and masks, one 32-bit word at a time.
+** \details   The input at "addr" is stored in bit 0 of words[0], the next one in bit 1,
+**            etc. Input "addr + n" is in bit (n % 32) of words[n / 32]. The bitmap is
+**            owned by the application. Whenever the application changes an input, it
+**            should call TbxMbServerCacheInvalidate() in case the response cache is
+**            enabled.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Element address of the first discrete input in the bitmap.
+** \param     num Number of discrete inputs in the bitmap.
+** \param     words Pointer to the array with the input bits, consisting of at least
+**            (num + 31) / 32 words. NULL to remove the bitmap.
+**
+****************************************************************************************/
+void TbxMbServerSetInputBitmap(tTbxMbServer   channel,
+                               uint16_t       addr,
+                               uint16_t       num,
+                               uint32_t     * words)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && 
+             ((words == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && 
+      ((words == NULL) || ((num > 0U) && (((uint32_t)addr + num) <= 65536UL))))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the bitmap configuration. */
+    TbxCriticalSectionEnter();
+    serverCtx->inputBitmap.addr = addr;
+    serverCtx->inputBitmap.num = num;
+    serverCtx->inputBitmap.words = words;
+    TbxCriticalSectionExit();
+    /* Responses in the cache might have been built from the previous inputs. */
+    TbxMbServerCacheInvalidate(serverCtx);
+  }
+} /*** end of TbxMbServerSetInputBitmap ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a register image object. A register image holds a double buffered
+**            copy of one or more data tables. Use TbxMbServerImageSetTable() to
+**            configure its data tables. Afterwards, the application publishes new values
+**            with TbxMbServerImageBeginUpdate(), followed by one or more calls to
+**            TbxMbServerImageWriteBits() / TbxMbServerImageWriteRegs() and finally
+**            TbxMbServerImageEndUpdate(). Readers only ever see the values of the last
+**            completed update.
+** \return    Handle to the newly created register image object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbServerImage TbxMbServerImageCreate(void)
+{
+  tTbxMbServerImage result = NULL;
+
+  /* Allocate memory for the new register image context. */
+  tTbxMbServerImageCtx * newImageCtx = TbxMemPoolAllocate(sizeof(tTbxMbServerImageCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newImageCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbServerImageCtx));
+    newImageCtx = TbxMemPoolAllocate(sizeof(tTbxMbServerImageCtx));      
+  }
+  /* Verify memory allocation of the register image context. */
+  TBX_ASSERT(newImageCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newImageCtx != NULL)
+  {
+    /* Initialize the register image context. Start without any data tables. */
+    newImageCtx->type = TBX_MB_SERVER_IMAGE_CONTEXT_TYPE;
+    for (uint8_t tblIdx = 0U; tblIdx < TBX_MB_SERVER_TABLE_NUM; tblIdx++)
+    {
+      newImageCtx->tables[tblIdx].addr = 0U;
+      newImageCtx->tables[tblIdx].num = 0U;
+      newImageCtx->tables[tblIdx].copies[0] = NULL;
+      newImageCtx->tables[tblIdx].copies[1] = NULL;
+    }
+    newImageCtx->seq = 0U;
+    newImageCtx->active = 0U;
+    newImageCtx->updating = TBX_FALSE;
+    /* Update the result. */
+    result = newImageCtx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a register image object, previously created with
+**            TbxMbServerImageCreate(). Make sure it is no longer assigned to a server.
+** \param     image Handle to the register image object to release.
+**
+****************************************************************************************/
+void TbxMbServerImageFree(tTbxMbServerImage image)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(image != NULL);
+
+  /* Only continue with valid parameters. */
+  if (image != NULL)
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Give the data table storage back to the memory pool. Note that both copies of a
+     * data table are allocated as one block.
+     */
+    for (uint8_t tblIdx = 0U; tblIdx < TBX_MB_SERVER_TABLE_NUM; tblIdx++)
+    {
+      if (imageCtx->tables[tblIdx].copies[0] != NULL)
+      {
+        TbxMemPoolRelease(imageCtx->tables[tblIdx].copies[0]);
+      }
+    }
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    imageCtx->type = 0U;
+    /* Give the register image context back to the memory pool. */
+    TbxMemPoolRelease(imageCtx);
+  }
+} /*** end of TbxMbServerImageFree ***/
+
+
+/************************************************************************************//**
+** \brief     Configures a data table of the register image. Call this function once for
+**            each data table, right after creating the image. All elements start out
+**            with a zero value.
+** \param     image Handle to the register image object.
+** \param     table The data table to configure.
+** \param     addr Element address of the first element in the data table (0..65535).
+** \param     num Number of elements in the data table.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerImageSetTable(tTbxMbServerImage image,
+                                 tTbxMbServerTable table,
+                                 uint16_t          addr,
+                                 uint16_t          num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((image != NULL) && ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM) &&
+             (num > 0U) && (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((image != NULL) && ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM) &&
+      (num > 0U) && (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    tTbxMbServerImageTbl * tbl = &imageCtx->tables[table];
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Data tables can only be configured once. */
+    TBX_ASSERT(tbl->num == 0U);
+    /* Only continue if the data table is not yet configured. */
+    if (tbl->num == 0U)
+    {
+      /* Allocate memory for both copies of the data table in one block. */
+      size_t    copySize = TbxMbServerImageCopySize(table, num);
+      uint8_t * storage = TbxMemPoolAllocate(copySize * 2U);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (storage == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, copySize * 2U);
+        storage = TbxMemPoolAllocate(copySize * 2U);      
+      }
+      /* Verify memory allocation of the data table storage. */
+      TBX_ASSERT(storage != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (storage != NULL)
+      {
+        /* Initialize all elements to zero. */
+        for (size_t idx = 0U; idx < (copySize * 2U); idx++)
+        {
+          storage[idx] = 0U;
+        }
+        /* Initialize the data table. */
+        tbl->copies[0] = &storage[0];
+        tbl->copies[1] = &storage[copySize];
+        tbl->addr = addr;
+        tbl->num = num;
+        /* Update the result. */
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageSetTable ***/
+
+
+/************************************************************************************//**
+** \brief     Starts an update of the register image. This prepares the copy that is not
+**            currently published, such that it holds the same values as the published
+**            snapshot. Afterwards you can write new values to it with
+**            TbxMbServerImageWriteBits() and TbxMbServerImageWriteRegs(), followed by
+**            TbxMbServerImageEndUpdate() to publish them all in one step.
+** \details   There can only be one writer per register image. In other words, do not
+**            update the same image from different tasks.
+** \param     image Handle to the register image object.
+** \return    TBX_OK if successful, TBX_ERROR if an update is already in progress.
+**
+****************************************************************************************/
+uint8_t TbxMbServerImageBeginUpdate(tTbxMbServerImage image)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(image != NULL);
+
+  /* Only continue with valid parameters. */
+  if (image != NULL)
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Only continue if no update is in progress. */
+    if (imageCtx->updating == TBX_FALSE)
+    {
+      uint8_t active = imageCtx->active;
+      /* Copy the published snapshot to the other copy of each data table. */
+      for (uint8_t tblIdx = 0U; tblIdx < TBX_MB_SERVER_TABLE_NUM; tblIdx++)
+      {
+        tTbxMbServerImageTbl * tbl = &imageCtx->tables[tblIdx];
+        if (tbl->num > 0U)
+        {
+          size_t copySize = TbxMbServerImageCopySize((tTbxMbServerTable)tblIdx, 
+                                                     tbl->num);
+          uint8_t const * src = tbl->copies[active];
+          uint8_t volatile * dst = tbl->copies[active ^ 1U];
+          for (size_t idx = 0U; idx < copySize; idx++)
+          {
+            dst[idx] = src[idx];
+          }
+        }
+      }
+      /* Flag the update as being in progress. */
+      imageCtx->updating = TBX_TRUE;
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageBeginUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Writes new values to the coils or discrete inputs data table of the
+**            register image. Only call this function in between 
+**            TbxMbServerImageBeginUpdate() and TbxMbServerImageEndUpdate().
+** \param     image Handle to the register image object.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_COILS or
+**            TBX_MB_SERVER_TABLE_INPUTS.
+** \param     addr Element address of the first element to write (0..65535).
+** \param     num Number of elements to write.
+** \param     values Pointer to array with the new values, one byte per element. Use
+**            TBX_ON for set and TBX_OFF for cleared bits.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerImageWriteBits(tTbxMbServerImage         image,
+                                  tTbxMbServerTable         table,
+                                  uint16_t                  addr,
+                                  uint16_t                  num,
+                                  uint8_t           const * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((image != NULL) && (values != NULL) && 
+             ((table == TBX_MB_SERVER_TABLE_COILS) || 
+              (table == TBX_MB_SERVER_TABLE_INPUTS)));
+
+  /* Only continue with valid parameters. */
+  if ((image != NULL) && (values != NULL) && 
+      ((table == TBX_MB_SERVER_TABLE_COILS) || (table == TBX_MB_SERVER_TABLE_INPUTS)))
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    tTbxMbServerImageTbl * tbl = &imageCtx->tables[table];
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Only continue if an update is in progress and the elements are all part of the
+     * data table.
+     */
+    if ((imageCtx->updating == TBX_TRUE) && (addr >= tbl->addr) &&
+        (((uint32_t)addr + num) <= ((uint32_t)tbl->addr + tbl->num)))
+    {
+      /* Write to the copy that is not published. */
+      uint32_t volatile * words = tbl->copies[imageCtx->active ^ 1U];
+      uint16_t            bitNum = addr - tbl->addr;
+      /* Loop through all the elements. */
+      for (uint16_t idx = 0U; idx < num; idx++)
+      {
+        uint32_t bitMask = 1UL << (bitNum % 32U);
+        if (values[idx] != TBX_OFF)
+        {
+          words[bitNum / 32U] |= bitMask;
+        }
+        else
+        {
+          words[bitNum / 32U] &= ~bitMask;
+        }
+        bitNum++;
+      }
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageWriteBits ***/
+
+
+/************************************************************************************//**
+** \brief     Writes new values to the input registers or holding registers data table
+**            of the register image. Only call this function in between 
+**            TbxMbServerImageBeginUpdate() and TbxMbServerImageEndUpdate().
+** \param     image Handle to the register image object.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_INPUT_REGS or
+**            TBX_MB_SERVER_TABLE_HOLDING_REGS.
+** \param     addr Element address of the first register to write (0..65535).
+** \param     num Number of registers to write.
+** \param     values Pointer to array with the new register values, in your CPUs native
+**            endianess.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerImageWriteRegs(tTbxMbServerImage         image,
+                                  tTbxMbServerTable         table,
+                                  uint16_t                  addr,
+                                  uint16_t                  num,
+                                  uint16_t          const * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((image != NULL) && (values != NULL) && 
+             ((table == TBX_MB_SERVER_TABLE_INPUT_REGS) || 
+              (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)));
+
+  /* Only continue with valid parameters. */
+  if ((image != NULL) && (values != NULL) && 
+      ((table == TBX_MB_SERVER_TABLE_INPUT_REGS) || 
+       (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)))
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    tTbxMbServerImageTbl * tbl = &imageCtx->tables[table];
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Only continue if an update is in progress and the registers are all part of the
+     * data table.
+     */
+    if ((imageCtx->updating == TBX_TRUE) && (addr >= tbl->addr) &&
+        (((uint32_t)addr + num) <= ((uint32_t)tbl->addr + tbl->num)))
+    {
+      /* Write to the copy that is not published. */
+      uint16_t volatile * regs = tbl->copies[imageCtx->active ^ 1U];
+      uint16_t            offset = addr - tbl->addr;
+      /* Loop through all the registers. */
+      for (uint16_t idx = 0U; idx < num; idx++)
+      {
+        regs[offset + idx] = values[idx];
+      }
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageWriteRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Completes the update of the register image, by publishing the newly 
+**            written values in one step.
+** \param     image Handle to the register image object.
+**
+****************************************************************************************/
+void TbxMbServerImageEndUpdate(tTbxMbServerImage image)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(image != NULL);
+
+  /* Only continue with valid parameters. */
+  if (image != NULL)
+  {
+    /* Convert the register image pointer to the context structure. */
+    tTbxMbServerImageCtx * imageCtx = (tTbxMbServerImageCtx *)image;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(imageCtx->type == TBX_MB_SERVER_IMAGE_CONTEXT_TYPE);
+    /* Only continue if an update is in progress. */
+    if (imageCtx->updating == TBX_TRUE)
+    {
+      /* Publish the updated copy. Note that the order is important here. The sequence
+       * counter must only change after switching the active copy. A reader that still
+       * works with the previously active copy then detects that it should try again.
+       */
+      imageCtx->active ^= 1U;
+      imageCtx->seq++;
+      /* Update is no longer in progress. */
+      imageCtx->updating = TBX_FALSE;
+    }
+  }
+} /*** end of TbxMbServerImageEndUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Enables the response cache of the server. SCADA systems typically poll the
+**            exact same read request over and over again. With the response cache
+**            enabled, the server stores the response to function codes 01 - 04 and
+**            sends it again for a next request with the same function code, start
+**            address and quantity, without calling the read callback functions. 
+** \details   The server automatically invalidates the cache upon processing a write
+**            request, or when the published snapshot of the assigned register image
+**            changed. Whenever the application changes the data in some other way, it
+**            should call TbxMbServerCacheInvalidate(). Note that this function should be
+**            called during initialization, before the server starts processing requests.
+** \param     channel Handle to the Modbus server channel object.
+** \param     entries Number of responses to cache. Set to 0 to disable the cache.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerCacheEnable(tTbxMbServer channel,
+                               uint8_t      entries)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    tTbxMbServerCacheEntry * newEntries = NULL;
+    /* Allocate memory for the cache entries, if the cache should be enabled. */
+    if (entries > 0U)
+    {
+      size_t entriesSize = (size_t)entries * sizeof(tTbxMbServerCacheEntry);
+      newEntries = TbxMemPoolAllocate(entriesSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newEntries == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, entriesSize);
+        newEntries = TbxMemPoolAllocate(entriesSize);
+      }
+      /* Verify memory allocation of the cache entries. */
+      TBX_ASSERT(newEntries != NULL);
+      /* Initialize the cache entries. */
+      if (newEntries != NULL)
+      {
+        for (uint8_t idx = 0U; idx < entries; idx++)
+        {
+          newEntries[idx].valid = TBX_FALSE;
+        }
+      }
+    }
+    /* Only continue if the cache should be disabled or the allocation succeeded. */
+    if ((entries == 0U) || (newEntries != NULL))
+    {
+      /* Give a previously enabled cache back to the memory pool. */
+      if (serverCtx->cacheEntries != NULL)
+      {
+        TbxMemPoolRelease(serverCtx->cacheEntries);
+      }
+      /* Store the new cache configuration and reset the statistics. */
+      serverCtx->cacheEntries = newEntries;
+      serverCtx->cacheSize = entries;
+      serverCtx->cacheNext = 0U;
+      serverCtx->cacheHits = 0U;
+      serverCtx->cacheMisses = 0U;
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCacheEnable ***/
+
+
+/************************************************************************************//**
+** \brief     Invalidates all responses in the response cache of the server. The
+**            application should call this function whenever it changed data that the
+**            server reports through its read callback functions. It's safe to call this
+**            function from a different task or an interrupt. A response that the server
+**            is building at the same time is not stored in the cache.
+** \param     channel Handle to the Modbus server channel object.
+**
+****************************************************************************************/
+void TbxMbServerCacheInvalidate(tTbxMbServer channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Move on to the next generation. Cache entries of older generations no longer
+     * match.
+     */
+    TbxCriticalSectionEnter();
+    serverCtx->cacheGeneration++;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerCacheInvalidate ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the statistics of the response cache. The hit rate is
+**            hits / (hits + misses). The statistics reset when calling 
+**            TbxMbServerCacheEnable().
+** \param     channel Handle to the Modbus server channel object.
+** \param     hits Pointer where to store the number of requests served from the cache.
+** \param     misses Pointer where to store the number of cacheable requests that were
+**            not found in the cache.
+**
+****************************************************************************************/
+void TbxMbServerCacheStats(tTbxMbServer   channel,
+                           uint32_t     * hits,
+                           uint32_t     * misses)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (hits != NULL) && (misses != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (hits != NULL) && (misses != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Copy the statistics. */
+    *hits = serverCtx->cacheHits;
+    *misses = serverCtx->cacheMisses;
+  }
+} /*** end of TbxMbServerCacheStats ***/
+
+
+/************************************************************************************//**
+** \brief     Completes the request that the server parked, after one of the callback
+**            functions returned TBX_MB_SERVER_PENDING. Call this function once the data
+**            of the slow source is available. The server then processes the request
+**            again from its polling function, calling the same callback functions, and
+**            transmits the response. For a shared data model, this includes the requests
+**            parked by all channels bound to it. It is safe to call this function from
+**            an interrupt or another task.
+** \param     channel Handle to the Modbus server channel object.
+** \return    TBX_OK if a parked request was flagged for completion, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerCompleteRequest(tTbxMbServer channel)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* The callback functions of a data model receive the handle of the channel that
+     * owns the data model. So complete the parked requests of all channels that are
+     * bound to it as well.
+     */
+    tTbxMbServerCtx * channelCtx = serverCtx;
+    while (channelCtx != NULL)
+    {
+      /* Only a parked request can be completed. */
+      TbxCriticalSectionEnter();
+      if (channelCtx->pendingState == TBX_MB_SERVER_PENDING_PARKED)
+      {
+        channelCtx->pendingState = TBX_MB_SERVER_PENDING_COMPLETED;
+        result = TBX_OK;
+      }
+      TbxCriticalSectionExit();
+      /* Move on to the next channel. */
+      channelCtx = (channelCtx == serverCtx) ? serverCtx->boundList : 
+                                               channelCtx->boundNext;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCompleteRequest ***/
+
+
+/************************************************************************************//**
+** \brief     Enables the change queue of the server. Whenever a client writes coils to
+**            the coil bitmap or holding registers to the holding register array, the
+**            server adds a change record with the data table and the address range to
+**            the queue. The application drains the queue at its own rate with
+**            TbxMbServerChangesGet(), instead of handling each written element in a
+**            write callback function, from the task that runs the Modbus stack.
+** \details   The queue is lock-free, with the server as the producer and the
+**            application as the consumer. When the queue is full, the server drops the
+**            change record and increments the counter reported by
+**            TbxMbServerChangesLost(). Note that this function should be called during
+**            initialization, before the server starts processing requests.
+** \param     channel Handle to the Modbus server channel object.
+** \param     size Maximum number of change records in the queue. Set to 0 to disable
+**            the change queue.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerChangesEnable(tTbxMbServer channel,
+                                 uint16_t     size)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (size < 65535U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (size < 65535U))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    tTbxMbServerChange * newBuffer = NULL;
+    /* Allocate memory for the ring buffer, if the queue should be enabled. It needs one
+     * extra slot to distinguish a full queue from an empty one.
+     */
+    if (size > 0U)
+    {
+      size_t bufferSize = ((size_t)size + 1U) * sizeof(tTbxMbServerChange);
+      newBuffer = TbxMemPoolAllocate(bufferSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newBuffer == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, bufferSize);
+        newBuffer = TbxMemPoolAllocate(bufferSize);
+      }
+      /* Verify memory allocation of the ring buffer. */
+      TBX_ASSERT(newBuffer != NULL);
+    }
+    /* Only continue if the queue should be disabled or the allocation succeeded. */
+    if ((size == 0U) || (newBuffer != NULL))
+    {
+      /* Give a previously enabled queue back to the memory pool. */
+      if (serverCtx->changes.buffer != NULL)
+      {
+        TbxMemPoolRelease((void *)serverCtx->changes.buffer);
+      }
+      /* Store the new queue configuration, starting out empty. */
+      TbxCriticalSectionEnter();
+      serverCtx->changes.buffer = newBuffer;
+      serverCtx->changes.slots = (size > 0U) ? (size + 1U) : 0U;
+      serverCtx->changes.head = 0U;
+      serverCtx->changes.tail = 0U;
+      serverCtx->changes.lost = 0U;
+      TbxCriticalSectionExit();
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerChangesEnable ***/
+
+
+/************************************************************************************//**
+** \brief     Takes the oldest change record from the change queue. Typically called by
+**            the application in a loop, until the queue is empty. Can be called from a
+**            different task than the one that runs the Modbus stack, as long as it's
+**            always the same task.
+** \param     channel Handle to the Modbus server channel object.
+** \param     change Pointer to where the change record is stored.
+** \return    TBX_TRUE if a change record was taken from the queue, TBX_FALSE if the
+**            queue is empty.
+**
+****************************************************************************************/
+uint8_t TbxMbServerChangesGet(tTbxMbServer         channel,
+                              tTbxMbServerChange * change)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (change != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (change != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the queue is not empty. */
+    uint16_t tail = serverCtx->changes.tail;
+    if (tail != serverCtx->changes.head)
+    {
+      /* Read the record before moving the tail index. This way the producer never
+       * overwrites a slot that is not yet read. Both the buffer and the tail index are
+       * volatile, so the compiler cannot reorder the read and the write.
+       */
+      *change = serverCtx->changes.buffer[tail];
+      tail++;
+      if (tail >= serverCtx->changes.slots)
+      {
+        tail = 0U;
+      }
+      serverCtx->changes.tail = tail;
+      /* Update the result. */
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerChangesGet ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of change records that the server dropped, because the
+**            change queue was full. Whenever this number increased, the application
+**            should treat all its data elements as changed.
+** \param     channel Handle to the Modbus server channel object.
+** \return    Total number of dropped change records.
+**
+****************************************************************************************/
+uint32_t TbxMbServerChangesLost(tTbxMbServer channel)
+{
+  uint32_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Read out the counter. */
+    result = serverCtx->changes.lost;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerChangesLost ***/
+
+
+/************************************************************************************//**
+** \brief     Enables the dirty bitmap of a writable data table. Whenever a client
+**            successfully writes elements of the data table with function code 05, 06,
+**            15 or 16, the server sets their bits in the dirty bitmap. This happens
+**            regardless of how the server stores the elements. The application finds out
+**            which elements changed since it last looked, with TbxMbServerDirtyFetch().
+** \details   Element "addr + n" is tracked by bit (n % 32) of word (n / 32). Writes to
+**            elements outside of the range are not tracked. Note that this function
+**            should be called during initialization, before the server starts processing
+**            requests.
+** \param     channel Handle to the Modbus server channel object.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_COILS or
+**            TBX_MB_SERVER_TABLE_HOLDING_REGS.
+** \param     addr Element address of the first element to track.
+** \param     num Number of elements to track. Set to 0 to disable the dirty bitmap.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerDirtyEnable(tTbxMbServer      channel,
+                               tTbxMbServerTable table,
+                               uint16_t          addr,
+                               uint16_t          num)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && 
+             ((table == TBX_MB_SERVER_TABLE_COILS) || 
+              (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)) &&
+             (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && 
+      ((table == TBX_MB_SERVER_TABLE_COILS) || 
+       (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)) &&
+      (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    uint32_t * newWords = NULL;
+    uint16_t   numWords = (uint16_t)(((uint32_t)num + 31U) / 32U);
+    /* Allocate memory for the bitmap, if it should be enabled. */
+    if (num > 0U)
+    {
+      size_t wordsSize = (size_t)numWords * sizeof(uint32_t);
+      newWords = TbxMemPoolAllocate(wordsSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newWords == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, wordsSize);
+        newWords = TbxMemPoolAllocate(wordsSize);
+      }
+      /* Verify memory allocation of the bitmap. */
+      TBX_ASSERT(newWords != NULL);
+      /* Initialize the bitmap with all elements clean. */
+      if (newWords != NULL)
+      {
+        for (uint16_t idx = 0U; idx < numWords; idx++)
+        {
+          newWords[idx] = 0U;
+        }
+      }
+    }
+    /* Only continue if the bitmap should be disabled or the allocation succeeded. */
+    if ((num == 0U) || (newWords != NULL))
+    {
+      tTbxMbServerBitmap * dirty = TbxMbServerDirtyBitmap(serverCtx, table);
+      uint32_t           * oldWords;
+      /* Store the new bitmap configuration. */
+      TbxCriticalSectionEnter();
+      oldWords = dirty->words;
+      dirty->addr = addr;
+      dirty->num = num;
+      dirty->words = newWords;
+      TbxCriticalSectionExit();
+      /* Give a previously enabled bitmap back to the memory pool. */
+      if (oldWords != NULL)
+      {
+        TbxMemPoolRelease(oldWords);
+      }
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDirtyEnable ***/
+
+
+/************************************************************************************//**
+** \brief     Moves the dirty bitmap of a data table to the specified array and clears
+**            it. Afterwards, the array holds the elements that a client wrote since the
+**            last call of this function. Use TbxMbServerDirtyNext() to iterate over
+**            them. The bitmap is scanned one 32-bit word at a time, so even the bitmap
+**            of a large data table is checked in a few microseconds. It's safe to call
+**            this function from a different task.
+** \param     channel Handle to the Modbus server channel object.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_COILS or
+**            TBX_MB_SERVER_TABLE_HOLDING_REGS.
+** \param     words Pointer to the array where the dirty bits are stored, consisting of
+**            at least (num + 31) / 32 words, with "num" as specified when calling
+**            TbxMbServerDirtyEnable().
+** \return    Number of dirty elements. 0 if none of the elements changed.
+**
+****************************************************************************************/
+uint16_t TbxMbServerDirtyFetch(tTbxMbServer        channel,
+                               tTbxMbServerTable   table,
+                               uint32_t          * words)
+{
+  uint16_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (words != NULL) &&
+             ((table == TBX_MB_SERVER_TABLE_COILS) || 
+              (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (words != NULL) &&
+      ((table == TBX_MB_SERVER_TABLE_COILS) || 
+       (table == TBX_MB_SERVER_TABLE_HOLDING_REGS)))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    tTbxMbServerBitmap * dirty = TbxMbServerDirtyBitmap(serverCtx, table);
+    /* Only continue if the dirty bitmap is enabled. */
+    if (dirty->words != NULL)
+    {
+      uint16_t numWords = (uint16_t)(((uint32_t)dirty->num + 31U) / 32U);
+      /* Move the bitmap one word at a time. The critical section makes sure that bits,
+       * which the server sets at the same time, either end up in this fetch or stay
+       * for the next one.
+       */
+      for (uint16_t idx = 0U; idx < numWords; idx++)
+      {
+        TbxCriticalSectionEnter();
+        uint32_t word = dirty->words[idx];
+        dirty->words[idx] = 0U;
+        TbxCriticalSectionExit();
+        words[idx] = word;
+        /* Count the dirty elements, skipping the clean words. */
+        if (word != 0U)
+        {
+          result += TbxMbServerBitCount(word);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDirtyFetch ***/
+
+
+/************************************************************************************//**
+** \brief     Finds the next set bit in a bitmap, as obtained with
+**            TbxMbServerDirtyFetch(). Words without set bits are skipped as a whole.
+**            Example for iterating over all dirty holding registers:
+**              uint16_t offset = 0U;
+**              while (TbxMbServerDirtyNext(dirtyWords, num, &offset) == TBX_TRUE)
+**              {
+**                ProcessRegister(addr + offset);
+**                offset++;
+**              }
+** \param     words Pointer to the bitmap.
+** \param     num Number of bits in the bitmap.
+** \param     offset Pointer to the bit offset where the search starts. It is updated
+**            with the offset of the set bit that was found.
+** \return    TBX_TRUE if a set bit was found, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerDirtyNext(uint32_t const * words,
+                             uint16_t         num,
+                             uint16_t       * offset)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((words != NULL) && (offset != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((words != NULL) && (offset != NULL))
+  {
+    uint32_t bitOffset = *offset;
+    /* Search until the end of the bitmap. */
+    while ((result == TBX_FALSE) && (bitOffset < num))
+    {
+      /* Get the word with the bit offset, without the bits in front of it. */
+      uint32_t word = words[bitOffset / 32U] & (0xFFFFFFFFUL << (bitOffset % 32U));
+      /* Does the remainder of the word have a set bit? */
+      if (word != 0U)
+      {
+        /* Isolate the lowest set bit and determine its position, by counting the
+         * bits that are below it.
+         */
+        uint32_t lowestBit = word & (~word + 1U);
+        bitOffset = ((bitOffset / 32U) * 32U) + TbxMbServerBitCount(lowestBit - 1U);
+        /* Only bits within the bitmap count. */
+        if (bitOffset < num)
+        {
+          *offset = (uint16_t)bitOffset;
+          result = TBX_TRUE;
+        }
+      }
+      /* Move on to the start of the next word. */
+      else
+      {
+        bitOffset = ((bitOffset / 32U) + 1U) * 32U;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDirtyNext ***/
+
+
+/************************************************************************************//**
+** \brief     Binds a server channel to the data model of another server channel. The
+**            data model consists of everything that the server channel serves: its
+**            callback functions, function code handlers, register image, bitmaps,
+**            register array, FIFO queues, response cache, change queue and dirty
+**            bitmaps. This makes it possible to serve a single data model over several
+**            transport layers, for example RTU to local panels and TCP to a SCADA
+**            system, without registering the same callbacks multiple times.
+** \details   The callback functions receive the handle of the channel that owns the data
+**            model, regardless of the channel that received the request. Diagnostics
+**            counters are still reported per channel. All channels process their
+**            requests from the same event task, so one request at a time accesses the
+**            data model. Use TbxMbServerModelLock() to update multiple data elements
+**            consistently from another task. Note that this function should be called
+**            during initialization, before the server starts processing requests.
+** \param     channel Handle to the Modbus server channel object to bind.
+** \param     model Handle to the Modbus server channel object that owns the data model.
+**            It cannot be bound to a data model itself. NULL to make the channel serve
+**            its own data model again.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerBindModel(tTbxMbServer channel,
+                             tTbxMbServer model)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (channel != model));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (channel != model))
+  {
+    /* Convert the server channel pointers to the context structures. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    tTbxMbServerCtx * modelCtx = (tTbxMbServerCtx *)model;
+    /* Sanity check on the context types. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    TBX_ASSERT((modelCtx == NULL) || (modelCtx->type == TBX_MB_SERVER_CONTEXT_TYPE));
+    /* Stop serving the data model of another channel. */
+    TbxMbServerModelUnbind(serverCtx);
+    /* Only bind to channels that serve their own data model, to prevent chains. The
+     * channel itself should not have other channels bound to it for the same reason.
+     */
+    if (modelCtx == NULL)
+    {
+      /* Update the result. */
+      result = TBX_OK;
+    }
+    else if ((modelCtx->modelCtx == modelCtx) && (serverCtx->boundList == NULL))
+    {
+      /* Add the channel to the list of channels bound to the data model. */
+      TbxCriticalSectionEnter();
+      serverCtx->boundNext = modelCtx->boundList;
+      modelCtx->boundList = serverCtx;
+      serverCtx->modelCtx = modelCtx;
+      TbxCriticalSectionExit();
+      /* Update the result. */
+      result = TBX_OK;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerBindModel ***/
+
+
+/************************************************************************************//**
+** \brief     Locks the data model of a server channel. While locked, none of the
+**            channels that serve the data model access it. Requests that arrive in the
+**            meantime receive a server device busy exception response, so clients retry
+**            them later. This allows the application to update multiple data elements
+**            from a different task, without clients ever seeing just part of the update.
+** \details   The lock does not block. When the server is processing a request at the
+**            moment, locking fails and the application should try again a bit later.
+**            Keep the data model locked as short as possible.
+** \param     model Handle to the Modbus server channel object that owns the data model.
+** \return    TBX_OK if the data model is now locked, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerModelLock(tTbxMbServer model)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(model != NULL);
+
+  /* Only continue with valid parameters. */
+  if (model != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * modelCtx = (tTbxMbServerCtx *)model;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(modelCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only lock the data model, if the server is not using it. */
+    TbxCriticalSectionEnter();
+    if ((modelCtx->modelBusy == TBX_FALSE) && (modelCtx->modelLocked == TBX_FALSE))
+    {
+      modelCtx->modelLocked = TBX_TRUE;
+      result = TBX_OK;
+    }
+    TbxCriticalSectionExit();
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerModelLock ***/
+
+
+/************************************************************************************//**
+** \brief     Unlocks the data model of a server channel, previously locked with
+**            TbxMbServerModelLock(). Because the application probably changed data
+**            elements, the response cache is invalidated.
+** \param     model Handle to the Modbus server channel object that owns the data model.
+**
+****************************************************************************************/
+void TbxMbServerModelUnlock(tTbxMbServer model)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(model != NULL);
+
+  /* Only continue with valid parameters. */
+  if (model != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * modelCtx = (tTbxMbServerCtx *)model;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(modelCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Responses in the cache might have been built from the previous data. */
+    TbxMbServerCacheInvalidate(modelCtx);
+    /* Release the lock. */
+    TbxCriticalSectionEnter();
+    modelCtx->modelLocked = TBX_FALSE;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerModelUnlock ***/
+
+
+/************************************************************************************//**
+** \brief     Enables or disables the fast path for read requests. With the fast path
+**            enabled, the transport layer hands a newly received packet to the server
+**            right after validating it, from its end-of-frame detection. For function
+**            code 03 and 04 requests that the server answers from memory, meaning the
+**            holding register array or the register image, the server builds the
+**            response and starts its transmission right away. This skips the round trip
+**            through the event queue, which lowers the response turnaround time. All
+**            other requests take the usual path.
+** \details   A function code handler registered with TbxMbServerSetHandler() for
+**            function code 03 or 04 disables the fast path for that function code.
+** \param     channel Handle to the Modbus server channel object.
+** \param     enable TBX_TRUE to enable the fast path, TBX_FALSE to disable it.
+**
+****************************************************************************************/
+void TbxMbServerFastPathEnable(tTbxMbServer channel,
+                               uint8_t      enable)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Register or remove the fast path function with the transport layer. */
+    TbxCriticalSectionEnter();
+    serverCtx->tpCtx->fastPathFcn = (enable == TBX_FALSE) ? NULL : TbxMbServerFastPath;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerFastPathEnable ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. It is only
+**            active while a request is parked.
+** \param     channel Handle to the Modbus server channel object.
+**
+****************************************************************************************/
+static void TbxMbServerPoll(tTbxMbServer channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    uint8_t stopPolling = TBX_FALSE;
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Get the number of ticks that elapsed since the last millisecond detection. Note
+     * that this calculation works, even if the 20 kHz timer counter overflowed.
+     */
+    uint16_t deltaMs = (uint16_t)(TbxMbPortTimerCount() - serverCtx->pendingTickTime) /
+                       20U;
+    /* Update the time that the request is parked. */
+    serverCtx->pendingTickTime += (deltaMs * 20U);
+    serverCtx->pendingElapsedMs += deltaMs;
+    /* Did the application complete the parked request? */
+    if (serverCtx->pendingState == TBX_MB_SERVER_PENDING_COMPLETED)
+    {
+      tTbxMbServerCtx * modelCtx = serverCtx->modelCtx;
+      /* Attempt to obtain write access to the response packet and access to the data
+       * model. This fails while the transport layer is still busy transmitting or
+       * while the application has the data model locked. In this case it is retried
+       * the next time this function is called.
+       */
+      tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
+      if ((txPacket != NULL) && 
+          (TbxMbServerModelEnter(modelCtx, serverCtx) == TBX_TRUE))
+      {
+        /* Process the parked request again, now that its data is available. */
+        uint8_t pduLen = serverCtx->pendingDataLen + 1U;
+        txPacket->pdu.code = serverCtx->pendingPdu.code;
+        TbxMbServerHandle(modelCtx, &serverCtx->pendingPdu.code, &txPacket->pdu.code,
+                          &pduLen);
+        txPacket->dataLen = pduLen - 1U;
+        /* Done with the data model. */
+        TbxMbServerModelExit(modelCtx);
+        /* Did a callback function report that it still cannot respond? */
+        if (TbxMbServerIsPending(txPacket) == TBX_TRUE)
+        {
+          /* Keep the request parked. */
+          TbxCriticalSectionEnter();
+          serverCtx->pendingState = TBX_MB_SERVER_PENDING_PARKED;
+          TbxCriticalSectionExit();
+        }
+        else
+        {
+          /* Restore the node of the request and transmit the response. The transport
+           * layer refuses the transmission while it is receiving another packet. In
+           * this case the response is prepared again the next time this function is
+           * called, until the request times out.
+           */
+          txPacket->node = serverCtx->pendingNode;
+          if (serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx) == TBX_OK)
+          {
+            serverCtx->pendingState = TBX_MB_SERVER_PENDING_NONE;
+            stopPolling = TBX_TRUE;
+          }
+        }
+      }
+    }
+    /* Did the request stay parked for too long? */
+    if ( (stopPolling == TBX_FALSE) && 
+         (serverCtx->pendingElapsedMs >= TBX_MB_SERVER_PENDING_TIMEOUT_MS) )
+    {
+      /* The client already timed out, so drop the request. */
+      serverCtx->pendingState = TBX_MB_SERVER_PENDING_NONE;
+      stopPolling = TBX_TRUE;
+    }
+    /* Done with the parked request? */
+    if (stopPolling == TBX_TRUE)
+    {
+      /* Instruct the event task to stop calling our polling function. */
+      tTbxMbEvent newEvent;
+      newEvent.context = serverCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+  }
+} /*** end of TbxMbServerPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this server channel object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus server channel object.
+**
+****************************************************************************************/
+static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the server channel context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(serverCtx != NULL);
+    /* Only continue with a valid context. */
+    if (serverCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t okayToSendResponse = TBX_FALSE;
+          /* Obtain read access to the newly received packet and write access to the
+           * response packet. 
+           */
+          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
+          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
+          /* Since we're requested to process a newly received PDU, these packet accesses
+           * should always succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
+          /* Only continue with packet access. */
+          if ((rxPacket != NULL) && (txPacket != NULL))
+          {
+            /* Update flag that we can actually send a response, now that we know we 
+             * have access to txPacket.
+             */
+            okayToSendResponse = TBX_TRUE;
+            /* Prepare the response packet function code. */
+            txPacket->pdu.code = rxPacket->pdu.code;
+            /* Obtain the data model that this channel serves. */
+            tTbxMbServerCtx * modelCtx = serverCtx->modelCtx;
+            /* Report that the server is busy, while the application has the data model
+             * locked.
+             */
+            if (TbxMbServerModelEnter(modelCtx, serverCtx) == TBX_FALSE)
+            {
+              txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+              txPacket->pdu.data[0] = TBX_MB_EC06_SERVER_DEVICE_BUSY;
+              txPacket->dataLen = 1U;
+            }
+            else
+            {
+              /* Sample the cache state before processing the request. When the data
+               * changes while the response is being built, the response is not stored.
+               */
+              uint32_t cacheGeneration = modelCtx->cacheGeneration;
+              uint32_t cacheImageSeq = TbxMbServerCacheImageSeq(modelCtx);
+              /* Attempt to serve the request from the response cache first. */
+              if (TbxMbServerCacheLookup(modelCtx, rxPacket, txPacket) == TBX_FALSE)
+              {
+                /* Is another request still parked? The server processes just one
+                 * request at a time, so report that it is busy.
+                 */
+                if (serverCtx->pendingState != TBX_MB_SERVER_PENDING_NONE)
+                {
+                  txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+                  txPacket->pdu.data[0] = TBX_MB_EC06_SERVER_DEVICE_BUSY;
+                  txPacket->dataLen = 1U;
+                }
+                else
+                {
+                  /* Process the request and prepare the response. */
+                  uint8_t pduLen = rxPacket->dataLen + 1U;
+                  TbxMbServerHandle(modelCtx, &rxPacket->pdu.code, &txPacket->pdu.code,
+                                    &pduLen);
+                  txPacket->dataLen = pduLen - 1U;
+                  /* Did a callback function report that it cannot respond right now? */
+                  if (TbxMbServerIsPending(txPacket) == TBX_TRUE)
+                  {
+                    /* Park the request. The transport layer reuses its packets, so
+                     * store a copy of the request, such that it can be processed again
+                     * later on.
+                     */
+                    serverCtx->pendingPdu = rxPacket->pdu;
+                    serverCtx->pendingDataLen = rxPacket->dataLen;
+                    serverCtx->pendingNode = txPacket->node;
+                    serverCtx->pendingTickTime = TbxMbPortTimerCount();
+                    serverCtx->pendingElapsedMs = 0U;
+                    TbxCriticalSectionEnter();
+                    serverCtx->pendingState = TBX_MB_SERVER_PENDING_PARKED;
+                    TbxCriticalSectionExit();
+                    /* Instruct the event task to call our polling function to be able to
+                     * detect the completion of the parked request.
+                     */
+                    tTbxMbEvent newEvent;
+                    newEvent.context = serverCtx;
+                    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+                    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+                    /* No response for now. */
+                    okayToSendResponse = TBX_FALSE;
+                  }
+                  else
+                  {
+                    /* Store the response in the cache, in case it can be reused. */
+                    TbxMbServerCacheStore(modelCtx, rxPacket, txPacket, cacheGeneration,
+                                          cacheImageSeq);
+                  }
+                }
+              }
+              /* Done with the data model. */
+              TbxMbServerModelExit(modelCtx);
+            }
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
+          /* Request the transport layer to transmit the response. Note that
+           * transmitFcn() should only be called after calling receptionDoneFcn().
+           */
+          if (okayToSendResponse == TBX_TRUE)
+          {
+            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
+          }
+        }
+        break;
+      
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* At this point no additional event handling is needed on this channel upon
+           * PDU transmission completion.
+           */
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbServerProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Fast path function that the transport layer calls right after it validated
+**            a newly received packet, if enabled with TbxMbServerFastPathEnable(). It
+**            processes function code 03 and 04 requests that can be answered from
+**            memory, without involving any callback functions.
+** \param     channelCtx Pointer to the Modbus server channel context.
+** \return    TBX_TRUE if the packet was processed and the response transmission started,
+**            TBX_FALSE if the packet should take the usual path through the event queue.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerFastPath(void * channelCtx)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channelCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channelCtx != NULL)
+  {
+    uint8_t served = TBX_FALSE;
+    /* Convert the channel pointer to the server channel context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channelCtx;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Obtain the data model that this channel serves. */
+    tTbxMbServerCtx * modelCtx = serverCtx->modelCtx;
+    /* Obtain read access to the newly received packet and write access to the response
+     * packet.
+     */
+    tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
+    tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
+    /* Only continue with packet access, a well formed request and no parked request. */
+    if ((rxPacket != NULL) && (txPacket != NULL) && (rxPacket->dataLen == 4U) &&
+        (serverCtx->pendingState == TBX_MB_SERVER_PENDING_NONE))
+    {
+      /* A holding registers read request is served from memory, if the built-in 
+       * handler builds the response from the array or the register image.
+       */
+      if (rxPacket->pdu.code == TBX_MB_FC03_READ_HOLDING_REGISTERS)
+      {
+        if ((modelCtx->handlers[TBX_MB_FC03_READ_HOLDING_REGISTERS] == 
+             TbxMbServerFC03ReadHoldingRegs) &&
+            ((modelCtx->holdingRegArray.regs != NULL) || 
+             (TbxMbServerImageServes(modelCtx, 
+                                     TBX_MB_SERVER_TABLE_HOLDING_REGS) == TBX_TRUE)))
+        {
+          served = TBX_TRUE;
+        }
+      }
+      /* An input registers read request is served from memory, if the built-in handler
+       * builds the response from the register image.
+       */
+      else if (rxPacket->pdu.code == TBX_MB_FC04_READ_INPUT_REGISTERS)
+      {
+        if ((modelCtx->handlers[TBX_MB_FC04_READ_INPUT_REGISTERS] == 
+             TbxMbServerFC04ReadInputRegs) &&
+            (TbxMbServerImageServes(modelCtx, 
+                                    TBX_MB_SERVER_TABLE_INPUT_REGS) == TBX_TRUE))
+        {
+          served = TBX_TRUE;
+        }
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+    }
+    /* Only continue if the request can be served from memory and the application does
+     * not have the data model locked.
+     */
+    if ((served == TBX_TRUE) && (TbxMbServerModelEnter(modelCtx, serverCtx) == TBX_TRUE))
+    {
+      /* Process the request and prepare the response. */
+      uint8_t pduLen = rxPacket->dataLen + 1U;
+      txPacket->pdu.code = rxPacket->pdu.code;
+      TbxMbServerHandle(modelCtx, &rxPacket->pdu.code, &txPacket->pdu.code, &pduLen);
+      txPacket->dataLen = pduLen - 1U;
+      /* Done with the data model. */
+      TbxMbServerModelExit(modelCtx);
+      /* Inform the transport layer that were done with the rx packet and request it to
+       * transmit the response.
+       */
+      serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
+      (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
+      /* Update the result. */
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFastPath ***/
+
+
+/************************************************************************************//**
+** \brief     Processes a request PDU by calling the handler of its function code, or the
+**            custom function code callback otherwise, and prepares the response PDU.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPdu Pointer to the request PDU, starting with the function code.
+** \param     txPdu Pointer to the response PDU. The caller already stored the function
+**            code of the request in its first byte.
+** \param     len Pointer to the request PDU length, including the function code. The
+**            length of the response PDU is written to it.
+**
+****************************************************************************************/
+static void TbxMbServerHandle(tTbxMbServerCtx       * context,
+                              uint8_t         const * rxPdu,
+                              uint8_t               * txPdu,
+                              uint8_t               * len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    uint8_t             handled = TBX_FALSE;
+    tTbxMbServerHandler handler = NULL;
+    /* Look up the handler of the function code. Function codes with the exception bit
+     * set are never valid in a request.
+     */
+    if (rxPdu[0] < TBX_MB_SERVER_HANDLERS_NUM)
+    {
+      handler = context->handlers[rxPdu[0]];
+    }
+    /* Is a handler registered for the function code? */
+    if (handler != NULL)
+    {
+      handled = handler(context, rxPdu, txPdu, len);
+    }
+    /* Is a custom function code callback configured? */
+    else if (context->customFunctionFcn != NULL)
+    {
+      handled = context->customFunctionFcn(context, rxPdu, txPdu, len);
+      /* A custom function could have changed data. */
+      TbxMbServerCacheInvalidate(context);
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+    /* This function code is currently not supported, if no handler processed the PDU
+     * and prepared a response.
+     */
+    if (handled == TBX_FALSE)
+    {
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txPdu[1] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      *len = 2U;
+    }
+  }
+} /*** end of TbxMbServerHandle ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if the response packet holds the internal exception response,
+**            which signals that a callback function returned TBX_MB_SERVER_PENDING.
+** \param     txPacket Pointer to the response packet.
+** \return    TBX_TRUE if the request should be parked, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerIsPending(tTbxMbTpPacket const * txPacket)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(txPacket != NULL);
+
+  /* Only continue with valid parameters. */
+  if (txPacket != NULL)
+  {
+    /* Check for an exception response with the internal exception code. */
+    if ( ((txPacket->pdu.code & TBX_MB_FC_EXCEPTION_MASK) != 0U) &&
+         (txPacket->dataLen == 1U) && 
+         (txPacket->pdu.data[0] == TBX_MB_SERVER_EC_PENDING) )
+    {
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerIsPending ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains access to a data model, for processing a request of a channel.
+** \param     model Pointer to the Modbus server channel context that owns the data
+**            model.
+** \param     channel Pointer to the Modbus server channel context that received the
+**            request.
+** \return    TBX_TRUE if access was obtained, TBX_FALSE if the application has the data
+**            model locked.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerModelEnter(tTbxMbServerCtx       * model,
+                                     tTbxMbServerCtx const * channel)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((model != NULL) && (channel != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((model != NULL) && (channel != NULL))
+  {
+    /* Only access the data model if the application does not have it locked. */
+    TbxCriticalSectionEnter();
+    if (model->modelLocked == TBX_FALSE)
+    {
+      model->modelBusy = TBX_TRUE;
+      result = TBX_TRUE;
+    }
+    TbxCriticalSectionExit();
+    /* Make the diagnostics of the channel's transport layer available to the function
+     * code handlers.
+     */
+    if (result == TBX_TRUE)
+    {
+      model->requestTpCtx = channel->tpCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerModelEnter ***/
+
+
+/************************************************************************************//**
+** \brief     Releases access to a data model, obtained with TbxMbServerModelEnter().
+** \param     model Pointer to the Modbus server channel context that owns the data
+**            model.
+**
+****************************************************************************************/
+static void TbxMbServerModelExit(tTbxMbServerCtx * model)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(model != NULL);
+
+  /* Only continue with valid parameters. */
+  if (model != NULL)
+  {
+    /* Restore the channel's own transport layer and release access. */
+    model->requestTpCtx = model->tpCtx;
+    TbxCriticalSectionEnter();
+    model->modelBusy = TBX_FALSE;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerModelExit ***/
+
+
+/************************************************************************************//**
+** \brief     Makes a channel serve its own data model again, in case it was bound to the
+**            data model of another channel.
+** \param     channel Pointer to the Modbus server channel context.
+**
+****************************************************************************************/
+static void TbxMbServerModelUnbind(tTbxMbServerCtx * channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters and a bound channel. */
+  if ((channel != NULL) && (channel->modelCtx != channel))
+  {
+    tTbxMbServerCtx * modelCtx = channel->modelCtx;
+    TbxCriticalSectionEnter();
+    /* Remove the channel from the list of channels bound to the data model. */
+    if (modelCtx->boundList == channel)
+    {
+      modelCtx->boundList = channel->boundNext;
+    }
+    else
+    {
+      tTbxMbServerCtx * prevCtx = modelCtx->boundList;
+      while ((prevCtx != NULL) && (prevCtx->boundNext != channel))
+      {
+        prevCtx = prevCtx->boundNext;
+      }
+      if (prevCtx != NULL)
+      {
+        prevCtx->boundNext = channel->boundNext;
+      }
+    }
+    /* Serve the channel's own data model. */
+    channel->boundNext = NULL;
+    channel->modelCtx = channel;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerModelUnbind ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 1 - Read Coils.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC01ReadCoils(tTbxMbServer          channel,
+                                 uint8_t       const * rxPdu,
+                                 uint8_t             * txPdu,
+                                 uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function, bitmap or register image was assigned. */
+    if ((context->readCoilFcn == NULL) && (context->coilBitmap.words == NULL) &&
+        (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_COILS) == TBX_FALSE))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of coils is invalid. */
+    else if ((numCoils < 1U) || (numCoils > 2000U))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the response should be built from the bitmap. */
+    else if (context->coilBitmap.words != NULL)
+    {
+      txDataLen = TbxMbServerBitmapRespond(&context->coilBitmap, startAddr, numCoils, 
+                                           txPdu);
+    }
+    /* Check if the response should be built from the register image. */
+    else if (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_COILS) == TBX_TRUE)
+    {
+      txDataLen = TbxMbServerImageRespond(context, TBX_MB_SERVER_TABLE_COILS, 
+                                          startAddr, numCoils, txPdu);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Determine the number of bytes needed to hold all the coil bits. The cast to
+       * U8 is okay, because we know that numCoils is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numCoils / 8U);
+      if ((numCoils % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txData[0] = numBytes;
+      txDataLen = txData[0] + 1U;
+      /* Prepare loop indices that aid with storing the coil bits. */
+      uint8_t   bitIdx  = 0U;
+      uint8_t   byteIdx = 0U;
+      /* Initialize byte array pointer for writing the coil bits in the response and
+       * already initialize the first byte to all zero (coils OFF) bits.
+       */
+      uint8_t * coilData = &txData[1];
+      coilData[0] = 0U;
+      /* Loop through all the coils. */
+      for (uint16_t idx = 0U; idx < numCoils; idx++)
+      {
+        uint8_t            coilValue = TBX_OFF;
+        tTbxMbServerResult srvResult;
+        /* Obtain coil value. */
+        srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the coil value in the response. Note that the coil bits in a byte are
+           * initialized to all zeroes, so only update if a coil is in the ON state.
+           */
+          if (coilValue != TBX_OFF)
+          {
+            coilData[byteIdx] |= (1U << bitIdx);
+          }
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
+          {
+            /* Reset the bit index, increment the byte index and initialize the byte to
+             * all zero (coils OFF) bits.
+             */
+            bitIdx = 0U;
+            byteIdx++;
+            coilData[byteIdx] = 0U;
+          }
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC01ReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 2 - Read Discrete Inputs.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC02ReadInputs(tTbxMbServer          channel,
+                                  uint8_t       const * rxPdu,
+                                  uint8_t             * txPdu,
+                                  uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function, bitmap or register image was assigned. */
+    if ((context->readInputFcn == NULL) && (context->inputBitmap.words == NULL) &&
+        (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_INPUTS) == TBX_FALSE))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of inputs is invalid. */
+    else if ((numInputs < 1U) || (numInputs > 2000U))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the response should be built from the bitmap. */
+    else if (context->inputBitmap.words != NULL)
+    {
+      txDataLen = TbxMbServerBitmapRespond(&context->inputBitmap, startAddr, numInputs, 
+                                           txPdu);
+    }
+    /* Check if the response should be built from the register image. */
+    else if (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_INPUTS) == TBX_TRUE)
+    {
+      txDataLen = TbxMbServerImageRespond(context, TBX_MB_SERVER_TABLE_INPUTS, 
+                                          startAddr, numInputs, txPdu);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Determine the number of bytes needed to hold all the input bits. The cast to
+       * U8 is okay, because we know that numInputs is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numInputs / 8U);
+      if ((numInputs % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txData[0] = numBytes;
+      txDataLen = txData[0] + 1U;
+      /* Prepare loop indices that aid with storing the input bits. */
+      uint8_t   bitIdx  = 0U;
+      uint8_t   byteIdx = 0U;
+      /* Initialize byte array pointer for writing the input bits in the response and
+       * already initialize the first byte to all zero (input OFF) bits.
+       */
+      uint8_t * inputData = &txData[1];
+      inputData[0] = 0U;
+      /* Loop through all the inputs. */
+      for (uint16_t idx = 0U; idx < numInputs; idx++)
+      {
+        uint8_t            inputValue = TBX_OFF;
+        tTbxMbServerResult srvResult;
+        /* Obtain input value. */
+        srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the input value in the response. Note that the input bits in a byte
+           * are initialized to all zeroes, so only update if an input is in the ON
+           * state.
+           */
+          if (inputValue != TBX_OFF)
+          {
+            inputData[byteIdx] |= (1U << bitIdx);
+          }
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
+          {
+            /* Reset the bit index, increment the byte index and initialize the byte to
+             * all zero (input OFF) bits.
+             */
+            bitIdx = 0U;
+            byteIdx++;
+            inputData[byteIdx] = 0U;
+          }
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC02ReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 3 - Read Holding Registers.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC03ReadHoldingRegs(tTbxMbServer          channel,
+                                       uint8_t       const * rxPdu,
+                                       uint8_t             * txPdu,
+                                       uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function was registered, an array or register image
+     * assigned.
+     */
+    if ((context->readHoldingRegFcn == NULL) && 
+        (context->holdingRegArray.regs == NULL) &&
+        (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_HOLDING_REGS) == TBX_FALSE))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of registers is invalid. */
+    else if ((numRegs < 1U) || (numRegs > 125U))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the response should be built from the holding register array. */
+    else if (context->holdingRegArray.regs != NULL)
+    {
+      txDataLen = TbxMbServerRegArrayRespond(&context->holdingRegArray, startAddr, 
+                                             numRegs, txPdu, context->requestTpCtx);
+    }
+    /* Check if the response should be built from the register image. */
+    else if (TbxMbServerImageServes(context, 
+                                    TBX_MB_SERVER_TABLE_HOLDING_REGS) == TBX_TRUE)
+    {
+      txDataLen = TbxMbServerImageRespond(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, 
+                                          startAddr, numRegs, txPdu);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbTpCursor cursor;
+      /* Write the response with an output cursor, such that the transport layer's
+       * checksum is updated along the way.
+       */
+      TbxMbTpCursorBegin(context->requestTpCtx, &cursor, txPdu);
+      /* Store byte count in the response and prepare the data length. */
+      TbxMbTpCursorPutUInt8(&cursor, (uint8_t)(2U * numRegs));
+      txDataLen = txData[0] + 1U;
+      /* Loop through all the registers. */
+      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      {
+        uint16_t           regValue = 0U;
+        tTbxMbServerResult srvResult;
+        /* Obtain register value. */
+        srvResult = context->readHoldingRegFcn(context, startAddr + idx, &regValue);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register value in the response. */
+          TbxMbTpCursorPutUInt16BE(&cursor, regValue);
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+      }
+      /* Hand the cursor over to the transport layer, unless the response turned into
+       * an exception response.
+       */
+      if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+      {
+        TbxMbTpCursorEnd(context->requestTpCtx, &cursor);
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 4 - Read Input Registers.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC04ReadInputRegs(tTbxMbServer          channel,
+                                     uint8_t       const * rxPdu,
+                                     uint8_t             * txPdu,
+                                     uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function was registered or a register image assigned. */
+    if ((context->readInputRegFcn == NULL) && 
+        (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_INPUT_REGS) == TBX_FALSE))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of registers is invalid. */
+    else if ((numRegs < 1U) || (numRegs > 125U))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the response should be built from the register image. */
+    else if (TbxMbServerImageServes(context, TBX_MB_SERVER_TABLE_INPUT_REGS) == TBX_TRUE)
+    {
+      txDataLen = TbxMbServerImageRespond(context, TBX_MB_SERVER_TABLE_INPUT_REGS, 
+                                          startAddr, numRegs, txPdu);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbTpCursor cursor;
+      /* Write the response with an output cursor, such that the transport layer's
+       * checksum is updated along the way.
+       */
+      TbxMbTpCursorBegin(context->requestTpCtx, &cursor, txPdu);
+      /* Store byte count in the response and prepare the data length. */
+      TbxMbTpCursorPutUInt8(&cursor, (uint8_t)(2U * numRegs));
+      txDataLen = txData[0] + 1U;
+      /* Loop through all the registers. */
+      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      {
+        uint16_t           regValue = 0U;
+        tTbxMbServerResult srvResult;
+        /* Obtain register value. */
+        srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register value in the response. */
+          TbxMbTpCursorPutUInt16BE(&cursor, regValue);
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+      }
+      /* Hand the cursor over to the transport layer, unless the response turned into
+       * an exception response.
+       */
+      if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+      {
+        TbxMbTpCursorEnd(context->requestTpCtx, &cursor);
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC04ReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 5 - Write Single Coil.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC05WriteSingleCoil(tTbxMbServer          channel,
+                                       uint8_t       const * rxPdu,
+                                       uint8_t             * txPdu,
+                                       uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function was registered or a bitmap assigned. */
+    if ((context->writeCoilFcn == NULL) && (context->commitCoilsFcn == NULL) &&
+        (context->coilBitmap.words == NULL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the output value is invalid. */
+    else if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's the same as the request. */
+      txData[0U] = rxData[0U];
+      txData[1U] = rxData[1U];
+      txData[2U] = rxData[2U];
+      txData[3U] = rxData[3U];
+      txDataLen = 4U;
+      /* Write the coil value. */
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      uint8_t            coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
+      /* Write the coil to the bitmap, if one was assigned. */
+      if (context->coilBitmap.words != NULL)
+      {
+        uint8_t coilBits = (coilValue == TBX_ON) ? 1U : 0U;
+        srvResult = TbxMbServerBitmapWrite(&context->coilBitmap, startAddr, 1U, 
+                                           &coilBits);
+        /* Inform the application about the change. */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          TbxMbServerChangesPush(context, TBX_MB_SERVER_TABLE_COILS, startAddr, 1U);
+        }
+      }
+      /* Write the coil with the single coil callback, if one was registered. */
+      else if (context->writeCoilFcn != NULL)
+      {
+        srvResult = context->writeCoilFcn(context, startAddr, coilValue);
+      }
+      /* Otherwise write it as a block of one coil with a transactional write. */
+      else
+      {
+        uint8_t coilBits = (coilValue == TBX_ON) ? 1U : 0U;
+        /* Validate the coil first, if a validation callback was registered. */
+        if (context->validateCoilsFcn != NULL)
+        {
+          srvResult = context->validateCoilsFcn(context, startAddr, 1U, &coilBits);
+        }
+        /* Only commit the coil if it is valid. */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          srvResult = context->commitCoilsFcn(context, startAddr, 1U, &coilBits);
+        }
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+    }
+    /* Flag the written elements as dirty, if the write succeeded. */
+    if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+    {
+      TbxMbServerDirtyMark(context, TBX_MB_SERVER_TABLE_COILS, startAddr, 1U);
+    }
+    /* Written data invalidates the cached responses. */
+    TbxMbServerCacheInvalidate(context);
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 6 - Write Single Register.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC06WriteSingleReg(tTbxMbServer          channel,
+                                      uint8_t       const * rxPdu,
+                                      uint8_t             * txPdu,
+                                      uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxData[2]);
+
+    /* Check if a callback function was registered or an array assigned. */
+    if ((context->writeHoldingRegFcn == NULL) && 
+        (context->commitHoldingRegsFcn == NULL) && 
+        (context->holdingRegArray.regs == NULL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's the same as the request. */
+      txData[0U] = rxData[0U];
+      txData[1U] = rxData[1U];
+      txData[2U] = rxData[2U];
+      txData[3U] = rxData[3U];
+      txDataLen = 4U;
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Write the register value to the array, if one was assigned. */
+      if (context->holdingRegArray.regs != NULL)
+      {
+        srvResult = TbxMbServerRegArrayWrite(&context->holdingRegArray, regAddr, 1U,
+                                             &rxData[2]);
+        /* Inform the application about the change. */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          TbxMbServerChangesPush(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, regAddr, 1U);
+        }
+      }
+      /* Write the register with the single register callback, if one was registered. */
+      else if (context->writeHoldingRegFcn != NULL)
+      {
+        srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
+      }
+      /* Otherwise write it as a block of one register with a transactional write. */
+      else
+      {
+        /* Validate the register first, if a validation callback was registered. */
+        if (context->validateHoldingRegsFcn != NULL)
+        {
+          srvResult = context->validateHoldingRegsFcn(context, regAddr, 1U, &regValue);
+        }
+        /* Only commit the register if it is valid. */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          srvResult = context->commitHoldingRegsFcn(context, regAddr, 1U, &regValue);
+        }
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+    }
+    /* Flag the written elements as dirty, if the write succeeded. */
+    if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+    {
+      TbxMbServerDirtyMark(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, regAddr, 1U);
+    }
+    /* Written data invalidates the cached responses. */
+    TbxMbServerCacheInvalidate(context);
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC06WriteSingleReg ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 8 - Diagnostics.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC08Diagnostics(tTbxMbServer          channel,
+                                   uint8_t       const * rxPdu,
+                                   uint8_t             * txPdu,
+                                   uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t         rxDataLen = *len - 1U;
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxData[2]);
+    /* Prepare the most common response. It's typically the sub-function code echoed,
+     * together with a 16-bit unsigned value.
+     */
+    txData[0U] = rxData[0U];
+    txData[1U] = rxData[1U];
+    txDataLen = 4U;
+
+    /* Filter on the received sub-function code. */
+    switch (subCode)
+    {
+      case TBX_MB_DIAG_SC_QUERY_DATA:
+      {
+        /* Echo the received data back. */
+        for (uint8_t idx = 0U; idx < rxDataLen; idx++)
+        {
+         txData[idx] = rxData[idx];
+        }
+        txDataLen = rxDataLen;
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Clear the diagnostic counters. */
+          context->requestTpCtx->diagInfo.busMsgCnt     = 0U;
+          context->requestTpCtx->diagInfo.busCommErrCnt = 0U;
+          context->requestTpCtx->diagInfo.busExcpErrCnt = 0U;
+          context->requestTpCtx->diagInfo.srvMsgCnt     = 0U;
+          context->requestTpCtx->diagInfo.srvNoRespCnt  = 0U;
+          context->requestTpCtx->diagInfo.commEventCnt  = 0U;
+          /* Also clear the communication event log, as reported by function code 12. */
+          context->requestTpCtx->diagInfo.commEventsNext = 0U;
+          context->requestTpCtx->diagInfo.commEventsNum  = 0U;
+          /* Echo the request data field. */
+          TbxMbCommonStoreUInt16BE(dataField, &txData[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.busMsgCnt, 
+                                   &txData[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.busCommErrCnt, 
+                                   &txData[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.busExcpErrCnt, 
+                                   &txData[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.srvMsgCnt, 
+                                   &txData[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txDataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.srvNoRespCnt, 
+                                   &txData[2U]);
+        }
+      }
+      break;
+
+      default:
+      {
+        /* Unsupported sub-function code. Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+        txDataLen = 1U;
+      }
+      break;
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC08Diagnostics ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 11 - Get Comm Event Counter.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC11GetCommEventCounter(tTbxMbServer          channel,
+                                           uint8_t       const * rxPdu,
+                                           uint8_t             * txPdu,
+                                           uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t       * txData    = &txPdu[1];
+    /* Store the status word. It's only non-zero while a previously issued command is
+     * still being processed. New requests never reach this handler in that case,
+     * because they are answered with a server device busy exception.
+     */
+    TbxMbCommonStoreUInt16BE(0x0000U, &txData[0]);
+    /* Store the communication event counter of the transport layer that received the
+     * request.
+     */
+    TbxMbCommonStoreUInt16BE(context->requestTpCtx->diagInfo.commEventCnt, &txData[2]);
+    /* Set the response PDU length. */
+    *len = 5U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC11GetCommEventCounter ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 12 - Get Comm Event Log.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC12GetCommEventLog(tTbxMbServer          channel,
+                                       uint8_t       const * rxPdu,
+                                       uint8_t             * txPdu,
+                                       uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx        * context  = (tTbxMbServerCtx *)channel;
+    tTbxMbTpDiagInfo const * diagInfo = &context->requestTpCtx->diagInfo;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t                * txData   = &txPdu[1];
+    uint8_t                  eventIdx = diagInfo->commEventsNext;
+    /* Store the byte count, which covers the status word, event count, message count
+     * and the events.
+     */
+    txData[0] = 6U + diagInfo->commEventsNum;
+    /* Store the status word. Refer to the FC11 handler for details. */
+    TbxMbCommonStoreUInt16BE(0x0000U, &txData[1]);
+    /* Store the communication event counter and the bus message count. */
+    TbxMbCommonStoreUInt16BE(diagInfo->commEventCnt, &txData[3]);
+    TbxMbCommonStoreUInt16BE(diagInfo->busMsgCnt, &txData[5]);
+    /* Copy the events, starting with the most recent one. */
+    for (uint8_t idx = 0U; idx < diagInfo->commEventsNum; idx++)
+    {
+      /* Step back to the previous event, with wrap around. */
+      eventIdx = (eventIdx == 0U) ? (TBX_MB_COMM_EVENT_LOG_LEN - 1U) : (eventIdx - 1U);
+      txData[7U + idx] = diagInfo->commEvents[eventIdx];
+    }
+    /* Set the response PDU length. */
+    *len = txData[0] + 2U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC12GetCommEventLog ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 15 - Write Multiple Coils.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC15WriteMultipleCoils(tTbxMbServer          channel,
+                                          uint8_t       const * rxPdu,
+                                          uint8_t             * txPdu,
+                                          uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxData[2]);
+    uint8_t  byteCnt   = rxData[4];
+    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
+     * because the range validity of numCoils is not yet checked.
+     */
+    uint16_t numBytes = (uint16_t)(numCoils / 8U);
+    if ((numCoils % 8U) != 0U)
+    {
+      numBytes++;
+    }
+    /* Check if a callback function was registered or a bitmap assigned. */
+    if ((context->writeCoilFcn == NULL) && (context->commitCoilsFcn == NULL) &&
+        (context->coilBitmap.words == NULL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
     /* Check if the quantity of coils is invalid. */
-    else if ((numCoils < 1U) || (numCoils > 2000U))
+    else if (((numCoils < 1U) || (numCoils > 1968U)))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of bytes is invalid. */
+    else if (numBytes != byteCnt)
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the coils should be written to the bitmap. */
+    else if (context->coilBitmap.words != NULL)
+    {
+      tTbxMbServerResult srvResult;
+      /* Write all coil bits in one go. */
+      srvResult = TbxMbServerBitmapWrite(&context->coilBitmap, startAddr, numCoils, 
+                                         &rxData[5]);
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+      /* All coils written. */
+      else
+      {
+        /* Inform the application about the change. */
+        TbxMbServerChangesPush(context, TBX_MB_SERVER_TABLE_COILS, startAddr, numCoils);
+        /* Prepare the response and its data length. It's the same as the request. */
+        txData[0U] = rxData[0U];
+        txData[1U] = rxData[1U];
+        txData[2U] = rxData[2U];
+        txData[3U] = rxData[3U];
+        txDataLen = 4U;
+      }
+    }
+    /* Check if the coils should be written with a transactional write operation. */
+    else if (context->commitCoilsFcn != NULL)
+    {
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Initialize byte array pointer for reading the coil bits from the request. */
+      uint8_t const    * coilData  = &rxData[5];
+      /* Check that the entire block is within the address range. */
+      if (((uint32_t)startAddr + numCoils) > 65536UL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Validate the entire block first, if a validation callback was registered. */
+      else if (context->validateCoilsFcn != NULL)
+      {
+        srvResult = context->validateCoilsFcn(context, startAddr, numCoils, coilData);
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+      /* Only commit the block if it is valid in its entirety. */
+      if (srvResult == TBX_MB_SERVER_OK)
+      {
+        srvResult = context->commitCoilsFcn(context, startAddr, numCoils, coilData);
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+      /* All coils written. */
+      else
+      {
+        /* Prepare the response and its data length. It's the same as the request. */
+        txData[0U] = rxData[0U];
+        txData[1U] = rxData[1U];
+        txData[2U] = rxData[2U];
+        txData[3U] = rxData[3U];
+        txDataLen = 4U;
+      }
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
+      txData[0U] = rxData[0U];
+      txData[1U] = rxData[1U];
+      txData[2U] = rxData[2U];
+      txData[3U] = rxData[3U];
+      txDataLen = 4U;
+      /* Prepare loop indices that aid with writing the coil bits. */
+      uint8_t         bitIdx  = 0U;
+      uint8_t         byteIdx = 0U;
+      /* Initialize byte array pointer for reading the coil bits from the request. */
+      uint8_t const * coilData = &rxData[5];
+      /* Loop through all the coils. */
+      for (uint16_t idx = 0U; idx < numCoils; idx++)
+      {
+        uint8_t            coilValue = TBX_OFF;
+        tTbxMbServerResult srvResult;
+        /* Extract the requested coil value. */
+        if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
+        {
+          coilValue = TBX_ON;
+        }
+        /* Write the coil value. */
+        srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+        /* Update the bit index. */
+        bitIdx++;
+        /* Time to move to the next byte? */
+        if (bitIdx == 8U)
+        {
+          /* Reset the bit index and increment the byte index. */
+          bitIdx = 0U;
+          byteIdx++;
+        }
+      }
+    }
+    /* Flag the written elements as dirty, if the write succeeded. */
+    if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+    {
+      TbxMbServerDirtyMark(context, TBX_MB_SERVER_TABLE_COILS, startAddr, numCoils);
+    }
+    /* Written data invalidates the cached responses. */
+    TbxMbServerCacheInvalidate(context);
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 16 - Write Multiple
+**            Registers.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC16WriteMultipleRegs(tTbxMbServer          channel,
+                                         uint8_t       const * rxPdu,
+                                         uint8_t             * txPdu,
+                                         uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxData[2]);
+    uint8_t  byteCnt   = rxData[4];
+
+    /* Check if a callback function was registered or an array assigned. */
+    if ((context->writeHoldingRegFcn == NULL) && 
+        (context->commitHoldingRegsFcn == NULL) && 
+        (context->holdingRegArray.regs == NULL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the quantity of registers is invalid. */
+    else if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* Check if the registers should be written to the holding register array. */
+    else if (context->holdingRegArray.regs != NULL)
+    {
+      tTbxMbServerResult srvResult;
+      /* Write all registers in one go. */
+      srvResult = TbxMbServerRegArrayWrite(&context->holdingRegArray, startAddr, numRegs,
+                                           &rxData[5]);
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+      /* All registers written. */
+      else
+      {
+        /* Inform the application about the change. */
+        TbxMbServerChangesPush(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, startAddr,
+                               numRegs);
+        /* Prepare the response and its data length. It's the same as the request. */
+        txData[0U] = rxData[0U];
+        txData[1U] = rxData[1U];
+        txData[2U] = rxData[2U];
+        txData[3U] = rxData[3U];
+        txDataLen = 4U;
+      }
+    }
+    /* Check if the registers should be written with a transactional write operation. */
+    else if (context->commitHoldingRegsFcn != NULL)
+    {
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      uint16_t           regValues[123U];
+      /* Extract all the requested register values. */
+      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      {
+        uint8_t const * regPtr = &rxData[5U + (idx * 2U)];
+        regValues[idx] = TbxMbCommonExtractUInt16BE(regPtr);
+      }
+      /* Check that the entire block is within the address range. */
+      if (((uint32_t)startAddr + numRegs) > 65536UL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Validate the entire block first, if a validation callback was registered. */
+      else if (context->validateHoldingRegsFcn != NULL)
+      {
+        srvResult = context->validateHoldingRegsFcn(context, startAddr, numRegs, 
+                                                    regValues);
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+      /* Only commit the block if it is valid in its entirety. */
+      if (srvResult == TBX_MB_SERVER_OK)
+      {
+        srvResult = context->commitHoldingRegsFcn(context, startAddr, numRegs, 
+                                                  regValues);
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TbxMbServerExceptionCode(srvResult);
+        txDataLen = 1U;
+      }
+      /* All registers written. */
+      else
+      {
+        /* Prepare the response and its data length. It's the same as the request. */
+        txData[0U] = rxData[0U];
+        txData[1U] = rxData[1U];
+        txData[2U] = rxData[2U];
+        txData[3U] = rxData[3U];
+        txDataLen = 4U;
+      }
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
+      txData[0U] = rxData[0U];
+      txData[1U] = rxData[1U];
+      txData[2U] = rxData[2U];
+      txData[3U] = rxData[3U];
+      txDataLen = 4U;
+      /* Loop through all the registers. */
+      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      {
+        uint16_t           regValue;
+        tTbxMbServerResult srvResult;
+        /* Extract the requested register value. */
+        regValue = TbxMbCommonExtractUInt16BE(&rxData[5U + (idx * 2U)]);
+        /* Write the register value. */
+        srvResult = context->writeHoldingRegFcn(context, startAddr + idx, regValue);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+          txData[0] = TbxMbServerExceptionCode(srvResult);
+          txDataLen = 1U;
+          /* Stop looping. */
+          break;
+        }
+      }
+    }
+    /* Flag the written elements as dirty, if the write succeeded. */
+    if ((txPdu[0] & TBX_MB_FC_EXCEPTION_MASK) == 0U)
+    {
+      TbxMbServerDirtyMark(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, startAddr, 
+                           numRegs);
+    }
+    /* Written data invalidates the cached responses. */
+    TbxMbServerCacheInvalidate(context);
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 17 - Report Server ID.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC17ReportServerId(tTbxMbServer          channel,
+                                      uint8_t       const * rxPdu,
+                                      uint8_t             * txPdu,
+                                      uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Check if a callback function was registered. */
+    if (context->reportServerIdFcn == NULL)
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* The server ID data is stored right after the byte count. Initialize its length
+       * to the maximum number of bytes that fit.
+       */
+      uint8_t            idLen = TBX_MB_TP_PDU_DATA_LEN_MAX - 1U;
+      tTbxMbServerResult srvResult;
+      /* Obtain the server ID data. */
+      srvResult = context->reportServerIdFcn(context, &txData[1], &idLen);
+      /* Exception reported or invalid length? Note that the server ID data should at
+       * least contain the server ID and the run indicator status.
+       */
+      if ((srvResult != TBX_MB_SERVER_OK) || (idLen < 2U) || 
+          (idLen > (TBX_MB_TP_PDU_DATA_LEN_MAX - 1U)))
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        txDataLen = 1U;
+      }
+      /* Server ID data is valid. */
+      else
+      {
+        /* Store byte count in the response and prepare the data length. */
+        txData[0] = idLen;
+        txDataLen = idLen + 1U;
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC17ReportServerId ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 20 - Read File Record.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+**            All sub-requests are validated first, before the callback function is
+**            called for each one of them.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC20ReadFileRecord(tTbxMbServer          channel,
+                                      uint8_t       const * rxPdu,
+                                      uint8_t             * txPdu,
+                                      uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t         rxDataLen = *len - 1U;
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint8_t byteCnt = rxData[0];
+
+    /* Check if a callback function was registered. */
+    if (context->readFileRecordFcn == NULL)
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the byte count is invalid. It should hold a whole number of 
+     * sub-requests.
+     */
+    else if ((byteCnt < TBX_MB_FILE_SUBREQ_HDR_LEN) || 
+             (byteCnt > TBX_MB_FILE_BYTE_COUNT_MAX) ||
+             ((byteCnt % TBX_MB_FILE_SUBREQ_HDR_LEN) != 0U) ||
+             (rxDataLen != (byteCnt + 1U)))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      uint8_t  const * subReq;
+      uint8_t          numSubReqs = byteCnt / TBX_MB_FILE_SUBREQ_HDR_LEN;
+      uint16_t         respLen    = 0U;
+      uint8_t          excCode    = 0U;
+
+      /* Loop through all sub-requests to validate them. */
+      for (uint8_t idx = 0U; idx < numSubReqs; idx++)
+      {
+        subReq = &rxData[1U + (idx * TBX_MB_FILE_SUBREQ_HDR_LEN)];
+        /* Check the reference type, file number and record range. */
+        if (TbxMbServerFileSubReqCheck(subReq) != TBX_OK)
+        {
+          /* Flag the exception and stop looping. */
+          excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          break;
+        }
+        /* Update the response length. Each sub-response holds its length, the reference
+         * type and the register values.
+         */
+        respLen += 2U + (TbxMbCommonExtractUInt16BE(&subReq[5]) * 2U);
+        /* Check that the response still fits. */
+        if (respLen > TBX_MB_FILE_BYTE_COUNT_MAX)
+        {
+          /* Flag the exception and stop looping. */
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          break;
+        }
+      }
+
+      /* Only continue with reading the file records if all sub-requests are valid. */
+      if (excCode == 0U)
+      {
+        uint16_t   regValues[(TBX_MB_FILE_BYTE_COUNT_MAX - 2U) / 2U];
+        uint8_t  * subResp = &txData[1];
+        /* Loop through all sub-requests to read their register values. */
+        for (uint8_t idx = 0U; idx < numSubReqs; idx++)
+        {
+          tTbxMbServerResult srvResult;
+          subReq = &rxData[1U + (idx * TBX_MB_FILE_SUBREQ_HDR_LEN)];
+          uint16_t fileNum   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+          uint16_t recordNum = TbxMbCommonExtractUInt16BE(&subReq[3]);
+          uint16_t recordLen = TbxMbCommonExtractUInt16BE(&subReq[5]);
+          /* Read the register values. */
+          srvResult = context->readFileRecordFcn(context, fileNum, recordNum, recordLen,
+                                                 regValues);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            /* Flag the exception and stop looping. */
+            excCode = TbxMbServerExceptionCode(srvResult);
+            break;
+          }
+          /* Store the sub-response. */
+          subResp[0] = (uint8_t)((recordLen * 2U) + 1U);
+          subResp[1] = TBX_MB_FILE_REF_TYPE;
+          for (uint8_t regIdx = 0U; regIdx < recordLen; regIdx++)
+          {
+            TbxMbCommonStoreUInt16BE(regValues[regIdx], &subResp[2U + (regIdx * 2U)]);
+          }
+          /* Continue with the next sub-response. */
+          subResp += 2U + (recordLen * 2U);
+        }
+      }
+
+      /* Exception detected? */
+      if (excCode != 0U)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = excCode;
+        txDataLen = 1U;
+      }
+      /* Response is complete. */
+      else
+      {
+        /* Store the response data length and prepare the packet's data length. */
+        txData[0] = (uint8_t)respLen;
+        txDataLen = respLen + 1U;
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC20ReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 21 - Write File Record.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+**            All sub-requests are validated first, before the callback function is
+**            called for each one of them. This prevents a partial write due to a
+**            malformed sub-request at the end of the PDU.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC21WriteFileRecord(tTbxMbServer          channel,
+                                       uint8_t       const * rxPdu,
+                                       uint8_t             * txPdu,
+                                       uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t         rxDataLen = *len - 1U;
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint8_t byteCnt = rxData[0];
+
+    /* Check if a callback function was registered. */
+    if (context->writeFileRecordFcn == NULL)
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the byte count is invalid. It should at least hold one sub-request with
+     * a single register value.
+     */
+    else if ((byteCnt < (TBX_MB_FILE_SUBREQ_HDR_LEN + 2U)) || 
+             (byteCnt > TBX_MB_FILE_BYTE_COUNT_MAX) ||
+             (rxDataLen != (byteCnt + 1U)))
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
     }
     /* All is good for further processing. */
     else
     {
-      /* Determine the number of bytes needed to hold all the coil bits. The cast to
-       * U8 is okay, because we know that numCoils is <= 2000.
-       */
-      uint8_t numBytes = (uint8_t)(numCoils / 8U);
-      if ((numCoils % 8U) != 0U)
-      {
-        numBytes++;
-      }
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the coil bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the coil bits in the response and
-       * already initialize the first byte to all zero (coils OFF) bits.
-       */
-      uint8_t * coilData = &txPacket->pdu.data[1];
-      coilData[0] = 0U;
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
+      uint8_t  const * subReq;
+      uint16_t         subReqLen;
+      uint8_t          excCode    = 0U;
+      uint8_t          offset     = 0U;
+
+      /* Loop through all sub-requests to validate them. */
+      while ((offset < byteCnt) && (excCode == 0U))
       {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Obtain coil value. */
-        srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        subReq = &rxData[1U + offset];
+        /* Check that the sub-request header is complete. */
+        if ((uint8_t)(byteCnt - offset) < TBX_MB_FILE_SUBREQ_HDR_LEN)
         {
-          /* Store the coil value in the response. Note that the coil bits in a byte are
-           * initialized to all zeroes, so only update if a coil is in the ON state.
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+        }
+        /* Check the reference type, file number and record range. */
+        else if (TbxMbServerFileSubReqCheck(subReq) != TBX_OK)
+        {
+          excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          /* Determine the total length of the sub-request and check that its register
+           * values are all present.
            */
-          if (coilValue != TBX_OFF)
+          subReqLen = TBX_MB_FILE_SUBREQ_HDR_LEN + 
+                      (TbxMbCommonExtractUInt16BE(&subReq[5]) * 2U);
+          if (subReqLen > (uint16_t)(byteCnt - offset))
           {
-            coilData[byteIdx] |= (1U << bitIdx);
+            excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
           }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
+          else
           {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (coils OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            coilData[byteIdx] = 0U;
+            /* Continue with the next sub-request. */
+            offset += (uint8_t)subReqLen;
           }
         }
-        /* Exception detected. */
-        else
+      }
+
+      /* Only continue with writing the file records if all sub-requests are valid. */
+      if (excCode == 0U)
+      {
+        uint16_t regValues[(TBX_MB_FILE_BYTE_COUNT_MAX - 
+                            TBX_MB_FILE_SUBREQ_HDR_LEN) / 2U];
+        /* Loop through all sub-requests to write their register values. */
+        offset = 0U;
+        while (offset < byteCnt)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          tTbxMbServerResult srvResult;
+          subReq = &rxData[1U + offset];
+          uint16_t fileNum   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+          uint16_t recordNum = TbxMbCommonExtractUInt16BE(&subReq[3]);
+          uint16_t recordLen = TbxMbCommonExtractUInt16BE(&subReq[5]);
+          /* Extract the register values. */
+          for (uint8_t regIdx = 0U; regIdx < recordLen; regIdx++)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            uint8_t const * regPtr = &subReq[TBX_MB_FILE_SUBREQ_HDR_LEN];
+            regValues[regIdx] = TbxMbCommonExtractUInt16BE(&regPtr[regIdx * 2U]);
           }
-          else
+          /* Write the register values. */
+          srvResult = context->writeFileRecordFcn(context, fileNum, recordNum, recordLen,
+                                                  regValues);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            /* Flag the exception and stop looping. */
+            excCode = TbxMbServerExceptionCode(srvResult);
+            break;
           }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
+          /* Continue with the next sub-request. */
+          offset += TBX_MB_FILE_SUBREQ_HDR_LEN + (uint8_t)(recordLen * 2U);
+        }
+      }
+
+      /* Exception detected? */
+      if (excCode != 0U)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        txData[0] = excCode;
+        txDataLen = 1U;
+      }
+      /* All file records written. */
+      else
+      {
+        /* The response is an echo of the request. */
+        for (uint8_t idx = 0U; idx < rxDataLen; idx++)
+        {
+          txData[idx] = rxData[idx];
         }
+        txDataLen = rxDataLen;
       }
     }
+    /* Written data invalidates the cached responses. */
+    TbxMbServerCacheInvalidate(context);
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
   }
-} /*** end of TbxMbServerFC01ReadCoils ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC21WriteFileRecord ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 2 - Read Discrete Inputs.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Checks the addressing of a file record sub-request. This includes its
+**            reference type, file number and range of record numbers.
+** \param     subReq Pointer to the first byte (reference type) of the sub-request.
+** \return    TBX_OK if the sub-request addresses a valid block of registers, TBX_ERROR
+**            otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
-                                      tTbxMbTpPacket  const * rxPacket,
-                                      tTbxMbTpPacket        * txPacket)
+static uint8_t TbxMbServerFileSubReqCheck(uint8_t const * subReq)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(subReq != NULL);
+
+  /* Only continue with valid parameters. */
+  if (subReq != NULL)
+  {
+    /* Read out the sub-request parameters. */
+    uint16_t fileNum   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+    uint16_t recordNum = TbxMbCommonExtractUInt16BE(&subReq[3]);
+    uint16_t recordLen = TbxMbCommonExtractUInt16BE(&subReq[5]);
+    /* Check the reference type and file number. Also make sure that all registers of
+     * the block are within the valid record number range.
+     */
+    if ((subReq[0] == TBX_MB_FILE_REF_TYPE) && (fileNum >= TBX_MB_FILE_NUM_MIN) &&
+        (recordLen > 0U) && (recordNum <= TBX_MB_FILE_RECORD_NUM_MAX) &&
+        (((uint32_t)recordNum + recordLen) <= (TBX_MB_FILE_RECORD_NUM_MAX + 1UL)))
+    {
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFileSubReqCheck ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 24 - Read FIFO Queue.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+**            The values included in the response are removed from the FIFO queue, once
+**            the response is completely built. At most 31 values are included. Any
+**            remaining values stay queued for the next request.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC24ReadFifoQueue(tTbxMbServer          channel,
+                                     uint8_t       const * rxPdu,
+                                     uint8_t             * txPdu,
+                                     uint8_t             * len)
 {
+  uint8_t result = TBX_FALSE;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
   {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t         rxDataLen = *len - 1U;
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t              fifoAddr = TbxMbCommonExtractUInt16BE(&rxData[0]);
+    tTbxMbServerFifoCtx * fifoCtx  = context->fifoList;
 
-    /* Check if a callback function was registered. */
-    if (context->readInputFcn == NULL)
+    /* Search for the FIFO queue with the requested FIFO pointer address. */
+    while ((fifoCtx != NULL) && (fifoCtx->addr != fifoAddr))
+    {
+      fifoCtx = fifoCtx->next;
+    }
+    /* Check if the request does not hold exactly the FIFO pointer address. */
+    if (rxDataLen != 2U)
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
     }
-    /* Check if the quantity of inputs is invalid. */
-    else if ((numInputs < 1U) || (numInputs > 2000U))
+    /* Check if the FIFO queue does not exist. */
+    else if (fifoCtx == NULL)
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+      txDataLen = 1U;
     }
     /* All is good for further processing. */
     else
     {
-      /* Determine the number of bytes needed to hold all the input bits. The cast to
-       * U8 is okay, because we know that numInputs is <= 2000.
+      /* Determine how many values to include in the response. */
+      uint16_t fifoCnt = TbxMbServerFifoCount(fifoCtx);
+      if (fifoCnt > TBX_MB_FIFO_COUNT_MAX)
+      {
+        fifoCnt = TBX_MB_FIFO_COUNT_MAX;
+      }
+      /* Copy the values from the FIFO queue to the response. Only the server writes
+       * the tail index, so it's safe to work with a local copy.
        */
-      uint8_t numBytes = (uint8_t)(numInputs / 8U);
-      if ((numInputs % 8U) != 0U)
+      uint16_t tail = fifoCtx->tail;
+      for (uint8_t idx = 0U; idx < fifoCnt; idx++)
       {
-        numBytes++;
+        TbxMbCommonStoreUInt16BE(fifoCtx->buffer[tail], 
+                                 &txData[4U + (idx * 2U)]);
+        tail++;
+        if (tail >= fifoCtx->slots)
+        {
+          tail = 0U;
+        }
       }
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the input bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the input bits in the response and
-       * already initialize the first byte to all zero (input OFF) bits.
+      /* Store the byte count and the FIFO count in the response. */
+      TbxMbCommonStoreUInt16BE((fifoCnt * 2U) + 2U, &txData[0]);
+      TbxMbCommonStoreUInt16BE(fifoCnt, &txData[2]);
+      txDataLen = (fifoCnt * 2U) + 4U;
+      /* Only now that the response is built, pop the copied values from the FIFO
+       * queue. This frees up their slots for the producer. The buffer and the tail
+       * index are volatile, so the compiler cannot move this write before the reads
+       * of the buffer.
        */
-      uint8_t * inputData = &txPacket->pdu.data[1];
-      inputData[0] = 0U;
-      /* Loop through all the inputs. */
-      for (uint16_t idx = 0U; idx < numInputs; idx++)
+      fifoCtx->tail = tail;
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC24ReadFifoQueue ***/
+
+
+/************************************************************************************//**
+** \brief     Built-in handler for function code 43 - Encapsulated Interface
+**            Transport. Only MEI type 14 - Read Device Identification is supported.
+** \details   Note that this function is called at a time that txPdu[0] is already
+**            prepared.
+**            With stream access, as many objects as fit are stored in the response. If 
+**            not all objects fit, the "more follows" field is set to 0xFF and the "next
+**            object id" field tells the client with which object to continue in its next
+**            request.
+** \param     channel Handle to the Modbus server channel object.
+** \param     rxPdu Pointer to a byte array with the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code. Holds the
+**            length of the received PDU upon calling and the length of the response
+**            PDU upon return.
+** \return    TBX_TRUE if the response PDU was prepared, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFC43ReadDeviceId(tTbxMbServer          channel,
+                                    uint8_t       const * rxPdu,
+                                    uint8_t             * txPdu,
+                                    uint8_t             * len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (rxPdu != NULL) && (txPdu != NULL) && (len != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * context = (tTbxMbServerCtx *)channel;
+    /* Access the PDU data bytes, which follow the function code. */
+    uint8_t const * rxData    = &rxPdu[1];
+    uint8_t         rxDataLen = *len - 1U;
+    uint8_t       * txData    = &txPdu[1];
+    uint8_t         txDataLen = 0U;
+    /* Read out request packet parameters. */
+    uint8_t meiType   = rxData[0];
+    uint8_t readCode  = rxData[1];
+    uint8_t objectId  = rxData[2];
+
+    /* Check if the MEI type is supported and if a callback function was registered. */
+    if ((meiType != TBX_MB_MEI_READ_DEVICE_ID) || (context->readDeviceIdFcn == NULL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txDataLen = 1U;
+    }
+    /* Check if the request length or the read device ID code is invalid. */
+    else if ((rxDataLen != 3U) || (readCode < TBX_MB_DEVID_READ_BASIC) || 
+             (readCode > TBX_MB_DEVID_READ_INDIVIDUAL))
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txData[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txDataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbServerResult srvResult  = TBX_MB_SERVER_OK;
+      uint8_t    const * objValue   = NULL;
+      uint8_t            objLen     = 0U;
+      uint8_t            numObjects = 0U;
+      /* Prepare the response header. Objects are stored after the 6 header bytes. */
+      txData[0] = TBX_MB_MEI_READ_DEVICE_ID;
+      txData[1] = readCode;
+      txData[2] = TbxMbServerDeviceIdConformity(context);
+      txData[3] = 0x00U;                         /* More follows: no.      */
+      txData[4] = 0x00U;                         /* Next object id.        */
+      txDataLen = 6U;
+
+      /* Requested individual access to one specific object? */
+      if (readCode == TBX_MB_DEVID_READ_INDIVIDUAL)
       {
-        uint8_t            inputValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Obtain input value. */
-        srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
-        /* No exception reported? */
+        /* Obtain the object's value. */
+        srvResult = context->readDeviceIdFcn(context, objectId, &objValue, &objLen);
+        /* Only continue with a valid object value. */
+        if ((srvResult == TBX_MB_SERVER_OK) && (objValue == NULL))
+        {
+          srvResult = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+        }
         if (srvResult == TBX_MB_SERVER_OK)
         {
-          /* Store the input value in the response. Note that the input bits in a byte
-           * are initialized to all zeroes, so only update if an input is in the ON
-           * state.
-           */
-          if (inputValue != TBX_OFF)
+          /* Truncate the object's value, in the unlikely case that it does not fit. */
+          if (objLen > (TBX_MB_TP_PDU_DATA_LEN_MAX - 8U))
           {
-            inputData[byteIdx] |= (1U << bitIdx);
+            objLen = TBX_MB_TP_PDU_DATA_LEN_MAX - 8U;
           }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
+          /* Store the object. */
+          txData[6] = objectId;
+          txData[7] = objLen;
+          for (uint8_t idx = 0U; idx < objLen; idx++)
           {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (input OFF) bits.
+            txData[8U + idx] = objValue[idx];
+          }
+          txDataLen += 2U + objLen;
+          numObjects = 1U;
+        }
+      }
+      /* Requested stream access to a category of objects. */
+      else
+      {
+        /* Determine the last object of the category. Note that the regular and extended
+         * categories include the objects of the categories below them.
+         */
+        uint16_t lastId = TBX_MB_DEVID_OBJ_REGULAR_FIRST - 1U;
+        if (readCode == TBX_MB_DEVID_READ_REGULAR)
+        {
+          lastId = TBX_MB_DEVID_OBJ_EXTENDED_FIRST - 1U;
+        }
+        else if (readCode == TBX_MB_DEVID_READ_EXTENDED)
+        {
+          lastId = 0xFFU;
+        }
+        else
+        {
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
+        }
+        /* There is no need to look beyond the last object that the server supports. */
+        if (lastId > context->devIdLastObj)
+        {
+          lastId = context->devIdLastObj;
+        }
+        /* The protocol specifies that the server responds as if object 0 was requested,
+         * in case the requested object is not part of the category or not supported.
+         */
+        if ((objectId > lastId) || 
+            (context->readDeviceIdFcn(context, objectId, &objValue, &objLen) != 
+             TBX_MB_SERVER_OK))
+        {
+          objectId = TBX_MB_DEVID_OBJ_VENDOR_NAME;
+        }
+        /* Loop through the objects of the category, starting at the requested one. */
+        for (uint16_t id = objectId; id <= lastId; id++)
+        {
+          /* Obtain the object's value. */
+          srvResult = context->readDeviceIdFcn(context, (uint8_t)id, &objValue, &objLen);
+          /* Skip objects that are not supported by this server. */
+          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          {
+            srvResult = TBX_MB_SERVER_OK;
+            continue;
+          }
+          /* Only continue with a valid object value. */
+          if ((srvResult != TBX_MB_SERVER_OK) || (objValue == NULL))
+          {
+            srvResult = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+            break;
+          }
+          /* Determine the number of bytes that are still available in the response. */
+          uint8_t spaceLeft = TBX_MB_TP_PDU_DATA_LEN_MAX - txDataLen;
+          /* Does the object not fit anymore? */
+          if ((2U + (uint16_t)objLen) > spaceLeft)
+          {
+            /* A single object that does not fit on its own gets truncated. Otherwise it
+             * would never be possible to read out the objects that follow it.
              */
-            bitIdx = 0U;
-            byteIdx++;
-            inputData[byteIdx] = 0U;
+            if (numObjects == 0U)
+            {
+              objLen = spaceLeft - 2U;
+            }
+            /* Continue with this object in the next response. */
+            else
+            {
+              txData[3] = 0xFFU;                 /* More follows: yes.     */
+              txData[4] = (uint8_t)id;           /* Next object id.        */
+              break;
+            }
+          }
+          /* Store the object. */
+          uint8_t * objPtr = &txData[txDataLen];
+          objPtr[0] = (uint8_t)id;
+          objPtr[1] = objLen;
+          for (uint8_t idx = 0U; idx < objLen; idx++)
+          {
+            objPtr[2U + idx] = objValue[idx];
           }
+          txDataLen += 2U + objLen;
+          numObjects++;
+        }
+      }
+      /* Exception detected? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txData[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
         }
-        /* Exception detected. */
         else
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
+          txData[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txDataLen = 1U;
+      }
+      /* Response is complete. */
+      else
+      {
+        /* Store the number of objects in the response. */
+        txData[5] = numObjects;
+      }
+    }
+    /* Set the response PDU length. */
+    *len = txDataLen + 1U;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFC43ReadDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Determines the conformity level of the device identification, as reported
+**            in the response of function code 43 / MEI type 14. It depends on the
+**            highest category for which the application supports at least one object.
+**            Individual access is always supported. The conformity level is only
+**            determined once and then cached in the context, together with the last
+**            object that the application supports. Stream access stops at that object.
+** \param     context Pointer to the Modbus server channel context.
+** \return    Conformity level (0x81 basic, 0x82 regular or 0x83 extended).
+**
+****************************************************************************************/
+static uint8_t TbxMbServerDeviceIdConformity(tTbxMbServerCtx * context)
+{
+  uint8_t result = 0x81U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (context->readDeviceIdFcn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (context->readDeviceIdFcn != NULL))
+  {
+    /* Conformity level not yet determined? */
+    if (context->devIdConformity == 0U)
+    {
+      uint8_t const * objValue;
+      uint8_t         objLen;
+      uint8_t         lastObj = TBX_MB_DEVID_OBJ_REGULAR_FIRST - 1U;
+      /* Search for an object in the extended category, followed by one in the regular
+       * category. Start at the highest one. The search stops at the first object
+       * found, which is the last object that the application supports. Otherwise the
+       * basic category's objects, which are mandatory, are the last ones.
+       */
+      for (uint16_t id = 0xFFU; id >= TBX_MB_DEVID_OBJ_REGULAR_FIRST; id--)
+      {
+        if (context->readDeviceIdFcn(context, (uint8_t)id, &objValue, &objLen) == 
+            TBX_MB_SERVER_OK)
+        {
+          /* Update the result to either extended or regular. */
+          result = (id >= TBX_MB_DEVID_OBJ_EXTENDED_FIRST) ? 0x83U : 0x82U;
+          lastObj = (uint8_t)id;
           break;
         }
       }
+      /* Cache the result and the last object. */
+      context->devIdLastObj = lastObj;
+      context->devIdConformity = result;
     }
+    /* Update the result with the cached value. */
+    result = context->devIdConformity;
   }
-} /*** end of TbxMbServerFC02ReadInputs ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDeviceIdConformity ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 3 - Read Holding Registers.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Converts the result of a callback function to the exception code to report
+**            in the exception response.
+** \param     srvResult Result of the callback function. Should not be TBX_MB_SERVER_OK.
+** \return    Modbus exception code.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerExceptionCode(tTbxMbServerResult srvResult)
+{
+  uint8_t result = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(srvResult != TBX_MB_SERVER_OK);
+
+  /* Convert the result to its exception code. */
+  if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+  {
+    result = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+  }
+  else if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_VALUE)
+  {
+    result = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+  }
+  else if (srvResult == TBX_MB_SERVER_PENDING)
+  {
+    result = TBX_MB_SERVER_EC_PENDING;
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerExceptionCode ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if the server should serve read requests for the specified data
+**            table from its register image.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     table The data table.
+** \return    TBX_TRUE if a register image is assigned and it holds the data table,
+**            TBX_FALSE otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
-                                           tTbxMbTpPacket  const * rxPacket,
-                                           tTbxMbTpPacket        * txPacket)
+static uint8_t TbxMbServerImageServes(tTbxMbServerCtx   * context,
+                                      tTbxMbServerTable   table)
 {
+  uint8_t result = TBX_FALSE;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((context != NULL) && ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((context != NULL) && ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->readHoldingRegFcn == NULL)
+    /* Register image assigned with the data table configured? */
+    if ((context->imageCtx != NULL) && (context->imageCtx->tables[table].num > 0U))
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      result = TBX_TRUE;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageServes ***/
+
+
+/************************************************************************************//**
+** \brief     Prepares the response for a read request of function code 01 - 04, with
+**            the values of the published snapshot in the register image.
+** \details   The quantity of elements should already be validated.
+** \param     context Pointer to the Modbus server channel context.
+** \param     table The data table to read from.
+** \param     addr Element address of the first element to read.
+** \param     num Number of elements to read.
+** \param     txPdu Pointer to a byte array for writing the response PDU. Note that
+**            txPdu[0] should already hold the function code.
+** \return    Number of data bytes in the response PDU.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerImageRespond(tTbxMbServerCtx   * context,
+                                       tTbxMbServerTable   table,
+                                       uint16_t            addr,
+                                       uint16_t            num,
+                                       uint8_t           * txPdu)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (context->imageCtx != NULL) && (txPdu != NULL) &&
+             ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (context->imageCtx != NULL) && (txPdu != NULL) &&
+      ((uint8_t)table < TBX_MB_SERVER_TABLE_NUM))
+  {
+    tTbxMbServerImageCtx       * imageCtx  = context->imageCtx;
+    tTbxMbServerImageTbl const * tbl       = &imageCtx->tables[table];
+    tTbxMbServerResult           srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    uint8_t                    * respData  = &txPdu[2];
+    tTbxMbTpCursor               cursor;
+    uint8_t                      numBytes;
+    /* Determine the number of data bytes in the response. */
+    if ((table == TBX_MB_SERVER_TABLE_COILS) || (table == TBX_MB_SERVER_TABLE_INPUTS))
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      numBytes = (uint8_t)((num + 7U) / 8U);
     }
-    /* All is good for further processing. */
     else
     {
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      numBytes = (uint8_t)(num * 2U);
+    }
+
+    /* Only continue if the elements are all part of the data table. */
+    if ((addr >= tbl->addr) &&
+        (((uint32_t)addr + num) <= ((uint32_t)tbl->addr + tbl->num)))
+    {
+      uint16_t offset = addr - tbl->addr;
+      /* Assume that no consistent snapshot can be read, until proven otherwise. */
+      srvResult = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+      /* Attempt to read a consistent snapshot. */
+      for (uint8_t attempt = 0U; attempt < TBX_MB_SERVER_IMAGE_READ_RETRIES; attempt++)
       {
-        uint16_t           regValue = 0U;
-        tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readHoldingRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        /* Sample the sequence counter before reading from the active copy. */
+        uint32_t seq = imageCtx->seq;
+        void const * copy = tbl->copies[imageCtx->active];
+        /* Reading bits? */
+        if ((table == TBX_MB_SERVER_TABLE_COILS) || 
+            (table == TBX_MB_SERVER_TABLE_INPUTS))
         {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          TbxMbServerBitsPack(copy, offset, num, respData);
         }
-        /* Exception detected. */
+        /* Reading registers. */
         else
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
+          uint16_t const volatile * regs = copy;
+          /* Write the response with an output cursor, such that the transport layer's
+           * checksum is updated along the way. Start with the byte count.
+           */
+          TbxMbTpCursorBegin(context->requestTpCtx, &cursor, txPdu);
+          TbxMbTpCursorPutUInt8(&cursor, numBytes);
+          /* Loop through all the registers. */
+          for (uint16_t idx = 0U; idx < num; idx++)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            TbxMbTpCursorPutUInt16BE(&cursor, regs[offset + idx]);
           }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
+        }
+        /* Snapshot consistent if no update was published in the meantime. */
+        if (seq == imageCtx->seq)
+        {
+          srvResult = TBX_MB_SERVER_OK;
           break;
         }
       }
     }
+
+    /* Exception detected? */
+    if (srvResult != TBX_MB_SERVER_OK)
+    {
+      /* Prepare exception response. */
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txPdu[1] = TbxMbServerExceptionCode(srvResult);
+      result = 1U;
+    }
+    /* Response is complete. */
+    else
+    {
+      /* Registers are written with the output cursor, which already stored the byte
+       * count. Hand the cursor over to the transport layer.
+       */
+      if ((table == TBX_MB_SERVER_TABLE_HOLDING_REGS) || 
+          (table == TBX_MB_SERVER_TABLE_INPUT_REGS))
+      {
+        TbxMbTpCursorEnd(context->requestTpCtx, &cursor);
+      }
+      /* Store byte count in the response. */
+      else
+      {
+        txPdu[1] = numBytes;
+      }
+      /* Prepare the data length. */
+      result = numBytes + 1U;
+    }
   }
-} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageRespond ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 4 - Read Input Registers.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Determines the number of bytes needed for one copy of a data table in a
+**            register image. 
+** \param     table The data table.
+** \param     num Number of elements in the data table.
+** \return    Number of bytes.
+**
+****************************************************************************************/
+static size_t TbxMbServerImageCopySize(tTbxMbServerTable table,
+                                       uint16_t          num)
+{
+  size_t result;
+
+  /* Bits are packed in 32-bit words. */
+  if ((table == TBX_MB_SERVER_TABLE_COILS) || (table == TBX_MB_SERVER_TABLE_INPUTS))
+  {
+    result = (((size_t)num + 31U) / 32U) * sizeof(uint32_t);
+  }
+  /* Registers are stored as 16-bit words. */
+  else
+  {
+    result = (size_t)num * sizeof(uint16_t);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerImageCopySize ***/
+
+
+/************************************************************************************//**
+** \brief     Prepares the response for a read request of function code 01 or 02, with
+**            the bits in a bitmap.
+** \details   The quantity of elements should already be validated.
+** \param     bitmap Pointer to the bitmap to read from.
+** \param     addr Element address of the first bit to read.
+** \param     num Number of bits to read.
+** \param     txPdu Pointer to a byte array for writing the response PDU. Note that
+**            txPdu[0] should already hold the function code.
+** \return    Number of data bytes in the response PDU.
 **
 ****************************************************************************************/
-static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
-                                        tTbxMbTpPacket  const * rxPacket,
-                                        tTbxMbTpPacket        * txPacket)
+static uint8_t TbxMbServerBitmapRespond(tTbxMbServerBitmap const * bitmap,
+                                        uint16_t                   addr,
+                                        uint16_t                   num,
+                                        uint8_t                  * txPdu)
 {
+  uint8_t result = 0U;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((bitmap != NULL) && (bitmap->words != NULL) && (txPdu != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((bitmap != NULL) && (bitmap->words != NULL) && (txPdu != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->readInputRegFcn == NULL)
+    /* Check if the bits are all part of the bitmap. */
+    if ((addr < bitmap->addr) ||
+        (((uint32_t)addr + num) > ((uint32_t)bitmap->addr + bitmap->num)))
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txPdu[1] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+      result = 1U;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
+    /* All is good for further processing. */
+    else
+    {
+      /* Determine the number of data bytes in the response. */
+      uint8_t numBytes = (uint8_t)((num + 7U) / 8U);
+      /* Copy the bits to the response. */
+      TbxMbServerBitsPack(bitmap->words, addr - bitmap->addr, num, &txPdu[2]);
+      /* Store byte count in the response and prepare the data length. */
+      txPdu[1] = numBytes;
+      result = numBytes + 1U;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerBitmapRespond ***/
+
+
+/************************************************************************************//**
+** \brief     Writes bits from a request PDU to a bitmap.
+** \param     bitmap Pointer to the bitmap to write to.
+** \param     addr Element address of the first bit to write.
+** \param     num Number of bits to write.
+** \param     bits Packed bits as in the request PDU. The first bit is in bit 0 of
+**            bits[0].
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if
+**            (part of) the bits are not in the bitmap.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbServerBitmapWrite(tTbxMbServerBitmap       * bitmap,
+                                                 uint16_t                   addr,
+                                                 uint16_t                   num,
+                                                 uint8_t            const * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((bitmap != NULL) && (bitmap->words != NULL) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((bitmap != NULL) && (bitmap->words != NULL) && (bits != NULL))
+  {
+    /* Only continue if the bits are all part of the bitmap. */
+    if ((addr >= bitmap->addr) &&
+        (((uint32_t)addr + num) <= ((uint32_t)bitmap->addr + bitmap->num)))
+    {
+      /* Copy the bits to the bitmap. */
+      TbxMbServerBitsMerge(bits, num, bitmap->words, addr - bitmap->addr);
+      /* Update the result. */
+      result = TBX_MB_SERVER_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerBitmapWrite ***/
+
+
+/************************************************************************************//**
+** \brief     Prepares the response for a read request of function code 03, with the
+**            registers in a register array.
+** \details   The quantity of elements should already be validated.
+** \param     array Pointer to the register array to read from.
+** \param     addr Element address of the first register to read.
+** \param     num Number of registers to read.
+** \param     txPdu Pointer to a byte array for writing the response PDU. Note that
+**            txPdu[0] should already hold the function code.
+** \param     tpCtx Transport layer context that transmits the response. Its checksum is
+**            updated while writing the response. Can be NULL.
+** \return    Number of data bytes in the response PDU.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerRegArrayRespond(tTbxMbServerRegArray const * array,
+                                          uint16_t                     addr,
+                                          uint16_t                     num,
+                                          uint8_t                    * txPdu,
+                                          tTbxMbTpCtx                * tpCtx)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((array != NULL) && (array->regs != NULL) && (txPdu != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((array != NULL) && (array->regs != NULL) && (txPdu != NULL))
+  {
+    /* Check if the registers are all part of the array. */
+    if ((addr < array->addr) ||
+        (((uint32_t)addr + num) > ((uint32_t)array->addr + array->num)))
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      txPdu[0] |= TBX_MB_FC_EXCEPTION_MASK;
+      txPdu[1] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+      result = 1U;
     }
     /* All is good for further processing. */
     else
     {
+      uint16_t const * regs = &array->regs[addr - array->addr];
+      tTbxMbTpCursor   cursor;
+      /* Write the response with an output cursor, such that the transport layer's
+       * checksum is updated along the way.
+       */
+      TbxMbTpCursorBegin(tpCtx, &cursor, txPdu);
       /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      TbxMbTpCursorPutUInt8(&cursor, (uint8_t)(num * 2U));
+      result = txPdu[1] + 1U;
+      /* Copy the registers to the response, in big endian byte order. */
+      for (uint16_t idx = 0U; idx < num; idx++)
       {
-        uint16_t           regValue = 0U;
-        tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
-        {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
-        }
-        /* Exception detected. */
-        else
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
+        TbxMbTpCursorPutUInt16BE(&cursor, regs[idx]);
       }
+      /* Response complete. Hand the cursor over to the transport layer. */
+      TbxMbTpCursorEnd(tpCtx, &cursor);
     }
   }
-} /*** end of TbxMbServerFC04ReadInputRegs ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerRegArrayRespond ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 5 - Write Single Coil.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Writes registers from a request PDU to a register array.
+** \param     array Pointer to the register array to write to.
+** \param     addr Element address of the first register to write.
+** \param     num Number of registers to write.
+** \param     data Register values as in the request PDU, in big endian byte order.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if
+**            (part of) the registers are not in the array.
 **
 ****************************************************************************************/
-static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
-                                           tTbxMbTpPacket  const * rxPacket,
-                                           tTbxMbTpPacket        * txPacket)
+static tTbxMbServerResult TbxMbServerRegArrayWrite(tTbxMbServerRegArray     * array,
+                                                   uint16_t                   addr,
+                                                   uint16_t                   num,
+                                                   uint8_t            const * data)
 {
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((array != NULL) && (array->regs != NULL) && (data != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((array != NULL) && (array->regs != NULL) && (data != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Only continue if the registers are all part of the array. */
+    if ((addr >= array->addr) &&
+        (((uint32_t)addr + num) <= ((uint32_t)array->addr + array->num)))
+    {
+      uint16_t * regs = &array->regs[addr - array->addr];
+      /* Copy the registers to the array. */
+      for (uint16_t idx = 0U; idx < num; idx++)
+      {
+        regs[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+      }
+      /* Update the result. */
+      result = TBX_MB_SERVER_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerRegArrayWrite ***/
 
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
+
+/************************************************************************************//**
+** \brief     Adds a change record to the change queue, if enabled. A write request
+**            results in a single change record, covering all its written elements.
+** \param     context Pointer to the Modbus server channel context.
+** \param     table Data table that changed.
+** \param     addr Element address of the first changed element.
+** \param     num Number of changed elements.
+**
+****************************************************************************************/
+static void TbxMbServerChangesPush(tTbxMbServerCtx   * context,
+                                   tTbxMbServerTable   table,
+                                   uint16_t            addr,
+                                   uint16_t            num)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters and an enabled change queue. */
+  if ((context != NULL) && (context->changes.buffer != NULL))
+  {
+    /* Determine where the head index moves to after the push. */
+    uint16_t head = context->changes.head;
+    uint16_t nextHead = head + 1U;
+    if (nextHead >= context->changes.slots)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      nextHead = 0U;
     }
-    /* Check if the output value is invalid. */
-    else if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    /* Only continue if the queue is not full. */
+    if (nextHead != context->changes.tail)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      /* Store the record before moving the head index. This way the consumer never
+       * reads a slot that is not yet written. Both the buffer and the head index are
+       * volatile, so the compiler cannot reorder these writes.
+       */
+      context->changes.buffer[head].table = table;
+      context->changes.buffer[head].addr = addr;
+      context->changes.buffer[head].num = num;
+      context->changes.head = nextHead;
     }
-    /* All is good for further processing. */
+    /* Queue full, so the record is lost. */
     else
     {
-      /* Prepare the response and its data length. It's the same as the request. */
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Write the coil value. */
-      tTbxMbServerResult srvResult;
-      uint8_t            coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
-      srvResult = context->writeCoilFcn(context, startAddr, coilValue);
-      /* Exception reported? */
-      if (srvResult != TBX_MB_SERVER_OK)
-      {
-        /* Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-        {
-          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-        }
-        else
-        {
-          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-        }
-        txPacket->dataLen = 1U;
-      }
+      context->changes.lost++;
     }
   }
-} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+} /*** end of TbxMbServerChangesPush ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 6 - Write Single Register.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Obtains the dirty bitmap of a writable data table.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_COILS or
+**            TBX_MB_SERVER_TABLE_HOLDING_REGS.
+** \return    Pointer to the dirty bitmap.
 **
 ****************************************************************************************/
-static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
-                                          tTbxMbTpPacket  const * rxPacket,
-                                          tTbxMbTpPacket        * txPacket)
+static tTbxMbServerBitmap * TbxMbServerDirtyBitmap(tTbxMbServerCtx   * context,
+                                                   tTbxMbServerTable   table)
 {
+  tTbxMbServerBitmap * result = NULL;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT(context != NULL);
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if (context != NULL)
   {
-    /* Read out request packet parameters. */
-    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Select the bitmap of the data table. */
+    result = (table == TBX_MB_SERVER_TABLE_COILS) ? &context->coilDirty : 
+                                                    &context->holdingRegDirty;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDirtyBitmap ***/
 
-    /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
+
+/************************************************************************************//**
+** \brief     Sets the bits of written elements in the dirty bitmap of a data table, if
+**            enabled. Elements outside of the range of the dirty bitmap are ignored.
+** \param     context Pointer to the Modbus server channel context.
+** \param     table The data table. Either TBX_MB_SERVER_TABLE_COILS or
+**            TBX_MB_SERVER_TABLE_HOLDING_REGS.
+** \param     addr Element address of the first written element.
+** \param     num Number of written elements.
+**
+****************************************************************************************/
+static void TbxMbServerDirtyMark(tTbxMbServerCtx   * context,
+                                 tTbxMbServerTable   table,
+                                 uint16_t            addr,
+                                 uint16_t            num)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    tTbxMbServerBitmap * dirty = TbxMbServerDirtyBitmap(context, table);
+    /* Clip the written elements to the range of the dirty bitmap. */
+    uint32_t first = addr;
+    uint32_t last = (uint32_t)addr + num;
+    if (first < dirty->addr)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      first = dirty->addr;
     }
-    /* All is good for further processing. */
-    else
-    {
-      /* Prepare the response and its data length. It's the same as the request. */
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Write the register value. */
-      tTbxMbServerResult srvResult;
-      srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
-      /* Exception reported? */
-      if (srvResult != TBX_MB_SERVER_OK)
+    if (last > ((uint32_t)dirty->addr + dirty->num))
+    {
+      last = (uint32_t)dirty->addr + dirty->num;
+    }
+    /* Only continue if the dirty bitmap is enabled and elements are in its range. */
+    if ((dirty->words != NULL) && (first < last))
+    {
+      uint32_t offset = first - dirty->addr;
+      uint32_t remaining = last - first;
+      /* Set the bits one word at a time. */
+      while (remaining > 0U)
       {
-        /* Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        uint32_t shift = offset % 32U;
+        uint32_t count = 32U - shift;
+        if (count > remaining)
         {
-          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          count = remaining;
         }
-        else
+        /* Build the mask with "count" bits, starting at "shift". */
+        uint32_t mask = 0xFFFFFFFFUL;
+        if (count < 32U)
         {
-          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+          mask = ((1UL << count) - 1UL) << shift;
         }
-        txPacket->dataLen = 1U;
+        /* The application could clear the word at the same time. */
+        TbxCriticalSectionEnter();
+        dirty->words[offset / 32U] |= mask;
+        TbxCriticalSectionExit();
+        /* Move on to the next word. */
+        offset += count;
+        remaining -= count;
       }
     }
   }
-} /*** end of TbxMbServerFC06WriteSingleReg ***/
+} /*** end of TbxMbServerDirtyMark ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 8 - Diagnostics.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Counts the number of set bits in a 32-bit word, by adding them up in
+**            parallel: first per 2 bits, then per 4 bits and finally per byte.
+** \param     word The word.
+** \return    Number of set bits.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerBitCount(uint32_t word)
+{
+  uint32_t count = word - ((word >> 1U) & 0x55555555UL);
+  count = (count & 0x33333333UL) + ((count >> 2U) & 0x33333333UL);
+  count = (count + (count >> 4U)) & 0x0F0F0F0FUL;
+  /* Give the result back to the caller. Adds up the byte counts in the top byte. */
+  return (uint8_t)((count * 0x01010101UL) >> 24U);
+} /*** end of TbxMbServerBitCount ***/
+
+
+/************************************************************************************//**
+** \brief     Copies bits from an array with 32-bit words to a byte array, packed as in
+**            a Modbus PDU. Bit "n" of the words is in bit (n % 32) of words[n / 32].
+**            The first copied bit ends up in bit 0 of bits[0]. Instead of going bit by
+**            bit, it processes 32 bits at a time: Each iteration combines the upper
+**            part of one word with the lower part of the next one, to compensate for the
+**            start bit offset.
+** \param     words Pointer to the array with the 32-bit words to read from.
+** \param     offset Bit number in the words of the first bit to copy.
+** \param     num Number of bits to copy. Must be > 0.
+** \param     bits Pointer to the byte array to write the (num + 7) / 8 bytes to. The
+**            unused bits of the last byte are cleared.
 **
 ****************************************************************************************/
-static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
-                                       tTbxMbTpPacket  const * rxPacket,
-                                       tTbxMbTpPacket        * txPacket)
+static void TbxMbServerBitsPack(uint32_t const volatile * words,
+                                uint16_t                  offset,
+                                uint16_t                  num,
+                                uint8_t                 * bits)
 {
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((words != NULL) && (num > 0U) && (bits != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((words != NULL) && (num > 0U) && (bits != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    /* Prepare the most common response. It's typically the sub-function code echoed,
-     * together with a 16-bit unsigned value.
+    uint16_t numBytes = (num + 7U) / 8U;
+    uint16_t wordIdx  = offset / 32U;
+    uint8_t  shift    = (uint8_t)(offset % 32U);
+    /* Index of the word that holds the last bit to copy. Words after it are not read,
+     * as they might not be part of the array.
      */
-    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-    txPacket->dataLen = 4U;
-
-    /* Filter on the received sub-function code. */
-    switch (subCode)
+    uint16_t lastWordIdx = (uint16_t)(((uint32_t)offset + num - 1U) / 32U);
+    /* Loop through the bytes, four at a time. */
+    for (uint16_t byteIdx = 0U; byteIdx < numBytes; byteIdx += 4U)
     {
-      case TBX_MB_DIAG_SC_QUERY_DATA:
-      {
-        /* Echo the received data back. */
-        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
-        {
-         txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
-        }
-        txPacket->dataLen = rxPacket->dataLen;
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
+      /* Collect the next 32 bits. */
+      uint32_t chunk = words[wordIdx] >> shift;
+      if ((shift != 0U) && (wordIdx < lastWordIdx))
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Clear the diagnostic counters. */
-          context->tpCtx->diagInfo.busMsgCnt     = 0U;
-          context->tpCtx->diagInfo.busCommErrCnt = 0U;
-          context->tpCtx->diagInfo.busExcpErrCnt = 0U;
-          context->tpCtx->diagInfo.srvMsgCnt     = 0U;
-          context->tpCtx->diagInfo.srvNoRespCnt  = 0U;
-          /* Echo the request data field. */
-          TbxMbCommonStoreUInt16BE(dataField, &txPacket->pdu.data[2U]);
-        }
+        chunk |= words[wordIdx + 1U] << (32U - shift);
       }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
+      wordIdx++;
+      /* Store them in the byte array, with the least significant byte first. */
+      for (uint8_t idx = 0U; (idx < 4U) && ((byteIdx + idx) < numBytes); idx++)
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        bits[byteIdx + idx] = (uint8_t)(chunk >> (idx * 8U));
       }
-      break;
+    }
+    /* Clear the unused bits in the last byte. */
+    if ((num % 8U) != 0U)
+    {
+      bits[numBytes - 1U] &= (uint8_t)((1U << (num % 8U)) - 1U);
+    }
+  }
+} /*** end of TbxMbServerBitsPack ***/
 
-      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busCommErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
 
-      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busExcpErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
+/************************************************************************************//**
+** \brief     Copies bits from a byte array, packed as in a Modbus PDU, to an array with
+**            32-bit words. The counterpart of TbxMbServerBitsPack(). It processes up to
+**            32 bits at a time, such that each destination word is updated just once
+**            with a masked read-modify-write operation. Bits in the words outside of the
+**            copied range are not changed.
+** \param     bits Pointer to the byte array with the packed bits to copy.
+** \param     num Number of bits to copy.
+** \param     words Pointer to the array with the 32-bit words to write to.
+** \param     offset Bit number in the words of the first bit to write.
+**
+****************************************************************************************/
+static void TbxMbServerBitsMerge(uint8_t  const * bits,
+                                 uint16_t         num,
+                                 uint32_t       * words,
+                                 uint16_t         offset)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((bits != NULL) && (words != NULL));
 
-      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+  /* Only continue with valid parameters. */
+  if ((bits != NULL) && (words != NULL))
+  {
+    uint16_t numBytes = (num + 7U) / 8U;
+    uint16_t bitIdx   = 0U;
+    /* Loop until all bits are copied. */
+    while (bitIdx < num)
+    {
+      uint32_t bitNum  = (uint32_t)offset + bitIdx;
+      uint16_t wordIdx = (uint16_t)(bitNum / 32U);
+      uint8_t  shift   = (uint8_t)(bitNum % 32U);
+      /* Determine how many bits fit in the current word. */
+      uint16_t cnt = 32U - shift;
+      if (cnt > (num - bitIdx))
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        cnt = num - bitIdx;
       }
-      break;
-
-      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+      /* Collect the next 32 source bits, starting at the byte that holds the first
+       * one. A fifth byte is needed if the first bit is not at the start of the byte.
+       */
+      uint16_t byteIdx = bitIdx / 8U;
+      uint8_t  bitOffset = (uint8_t)(bitIdx % 8U);
+      uint32_t value = 0U;
+      for (uint8_t idx = 0U; (idx < 4U) && ((byteIdx + idx) < numBytes); idx++)
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvNoRespCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        value |= (uint32_t)bits[byteIdx + idx] << (idx * 8U);
       }
-      break;
-
-      default:
+      value >>= bitOffset;
+      if ((bitOffset != 0U) && ((byteIdx + 4U) < numBytes))
       {
-        /* Unsupported sub-function code. Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-        txPacket->dataLen = 1U;
+        value |= (uint32_t)bits[byteIdx + 4U] << (32U - bitOffset);
       }
-      break;
+      /* Merge the bits into the word. */
+      uint32_t mask = (cnt == 32U) ? 0xFFFFFFFFUL : ((1UL << cnt) - 1U);
+      words[wordIdx] = (words[wordIdx] & ~(mask << shift)) | ((value & mask) << shift);
+      /* Continue with the next word. */
+      bitIdx += cnt;
     }
   }
-} /*** end of TbxMbServerFC08Diagnostics ***/
+} /*** end of TbxMbServerBitsMerge ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the sequence counter of the register image that is assigned to the
+**            server. Cached responses are only valid as long as it doesn't change.
+** \param     context Pointer to the Modbus server channel context.
+** \return    Image sequence counter or 0 if no register image is assigned.
+**
+****************************************************************************************/
+static uint32_t TbxMbServerCacheImageSeq(tTbxMbServerCtx const * context)
+{
+  uint32_t result = 0U;
+
+  /* Read the sequence counter, if a register image is assigned. */
+  if (context->imageCtx != NULL)
+  {
+    result = context->imageCtx->seq;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCacheImageSeq ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 15 - Write Multiple Coils.
+** \brief     Attempts to serve a read request from the response cache. On a cache hit,
+**            the cached response data is copied to the response packet.
 ** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+**            prepared.
 ** \param     context Pointer to the Modbus server channel context.
 ** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     txPacket Transmit PDU packet with MUX access.
+** \return    TBX_TRUE if the response packet was prepared from the cache, TBX_FALSE
+**            otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket)
+static uint8_t TbxMbServerCacheLookup(tTbxMbServerCtx       * context,
+                                      tTbxMbTpPacket  const * rxPacket,
+                                      tTbxMbTpPacket        * txPacket)
 {
-  /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  uint8_t result = TBX_FALSE;
 
-  /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  /* Only read requests for function codes 01 - 04 are cached. These always have a
+   * start address and quantity.
+   */
+  if ((context->cacheEntries != NULL) && (rxPacket->dataLen == 4U) &&
+      (rxPacket->pdu.code >= TBX_MB_FC01_READ_COILS) &&
+      (rxPacket->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
-    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
-     * because the range validity of numCoils is not yet checked.
-     */
-    uint16_t numBytes = (uint16_t)(numCoils / 8U);
-    if ((numCoils % 8U) != 0U)
-    {
-      numBytes++;
-    }
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
-    /* Check if the quantity of coils is invalid. */
-    else if (((numCoils < 1U) || (numCoils > 1968U)))
+    /* Extract the key and the cache state to match. */
+    uint16_t addr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t num  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint32_t generation = context->cacheGeneration;
+    uint32_t imageSeq = TbxMbServerCacheImageSeq(context);
+    /* Loop through the cache entries. */
+    for (uint8_t idx = 0U; idx < context->cacheSize; idx++)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      tTbxMbServerCacheEntry const * entry = &context->cacheEntries[idx];
+      /* Does this entry hold a still valid response for the request? */
+      if ((entry->valid == TBX_TRUE) && (entry->code == rxPacket->pdu.code) &&
+          (entry->addr == addr) && (entry->num == num) &&
+          (entry->generation == generation) && (entry->imageSeq == imageSeq))
+      {
+        /* Copy the cached response data. */
+        for (uint8_t dataIdx = 0U; dataIdx < entry->dataLen; dataIdx++)
+        {
+          txPacket->pdu.data[dataIdx] = entry->data[dataIdx];
+        }
+        txPacket->dataLen = entry->dataLen;
+        /* Update the result. */
+        result = TBX_TRUE;
+        break;
+      }
     }
-    /* Check if the quantity of bytes is invalid. */
-    else if (numBytes != byteCnt)
+    /* Update the statistics. */
+    if (result == TBX_TRUE)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      context->cacheHits++;
     }
-    /* All is good for further processing. */
     else
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Prepare loop indices that aid with writing the coil bits. */
-      uint8_t         bitIdx  = 0U;
-      uint8_t         byteIdx = 0U;
-      /* Initialize byte array pointer for reading the coil bits from the request. */
-      uint8_t const * coilData = &rxPacket->pdu.data[5];
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
-      {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested coil value. */
-        if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
-        {
-          coilValue = TBX_ON;
-        }
-        /* Write the coil value. */
-        srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
-        /* Update the bit index. */
-        bitIdx++;
-        /* Time to move to the next byte? */
-        if (bitIdx == 8U)
-        {
-          /* Reset the bit index and increment the byte index. */
-          bitIdx = 0U;
-          byteIdx++;
-        }
-      }
+      context->cacheMisses++;
     }
   }
-} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCacheLookup ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 16 - Write Multiple
-**            Registers.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Stores the response to a read request in the response cache, such that it
+**            can be reused for the next identical request. Exception responses are not
+**            stored. Neither are responses during which the data possibly changed.
 ** \param     context Pointer to the Modbus server channel context.
 ** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     txPacket Transmit PDU packet with the response.
+** \param     generation Cache generation sampled before building the response.
+** \param     imageSeq Image sequence counter sampled before building the response.
 **
 ****************************************************************************************/
-static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
-                                             tTbxMbTpPacket  const * rxPacket,
-                                             tTbxMbTpPacket        * txPacket)
+static void TbxMbServerCacheStore(tTbxMbServerCtx       * context,
+                                  tTbxMbTpPacket  const * rxPacket,
+                                  tTbxMbTpPacket  const * txPacket,
+                                  uint32_t                generation,
+                                  uint32_t                imageSeq)
 {
-  /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
-
-  /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  /* Only store positive responses to read requests for function codes 01 - 04. Also
+   * make sure the data didn't change, while building the response.
+   */
+  if ((context->cacheEntries != NULL) && (rxPacket->dataLen == 4U) &&
+      (rxPacket->pdu.code >= TBX_MB_FC01_READ_COILS) &&
+      (rxPacket->pdu.code <= TBX_MB_FC04_READ_INPUT_REGISTERS) &&
+      (txPacket->pdu.code == rxPacket->pdu.code) &&
+      (generation == context->cacheGeneration) &&
+      (imageSeq == TbxMbServerCacheImageSeq(context)))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
-
-    /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
-    /* Check if the quantity of registers is invalid. */
-    else if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)))
+    uint16_t addr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t num  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Default to replacing the entries in a round-robin fashion. */
+    uint8_t entryIdx = context->cacheNext;
+    uint8_t found = TBX_FALSE;
+    /* Prefer an entry that holds no valid response, or the previous response to the
+     * same request.
+     */
+    for (uint8_t idx = 0U; idx < context->cacheSize; idx++)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      tTbxMbServerCacheEntry const * entry = &context->cacheEntries[idx];
+      if ((entry->valid == TBX_FALSE) || (entry->generation != generation) ||
+          ((entry->code == rxPacket->pdu.code) && (entry->addr == addr) &&
+           (entry->num == num)))
+      {
+        entryIdx = idx;
+        found = TBX_TRUE;
+        break;
+      }
     }
-    /* All is good for further processing. */
-    else
+    /* Move the round-robin index, if it's used. */
+    if (found == TBX_FALSE)
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      context->cacheNext++;
+      if (context->cacheNext >= context->cacheSize)
       {
-        uint16_t           regValue;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested register value. */
-        regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[5U + (idx * 2U)]);
-        /* Write the register value. */
-        srvResult = context->writeHoldingRegFcn(context, startAddr + idx, regValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
+        context->cacheNext = 0U;
       }
     }
+    /* Store the response in the cache entry. */
+    tTbxMbServerCacheEntry * entry = &context->cacheEntries[entryIdx];
+    entry->code = rxPacket->pdu.code;
+    entry->addr = addr;
+    entry->num = num;
+    entry->generation = generation;
+    entry->imageSeq = imageSeq;
+    entry->dataLen = txPacket->dataLen;
+    for (uint8_t dataIdx = 0U; dataIdx < txPacket->dataLen; dataIdx++)
+    {
+      entry->data[dataIdx] = txPacket->pdu.data[dataIdx];
+    }
+    entry->valid = TBX_TRUE;
   }
-} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+} /*** end of TbxMbServerCacheStore ***/
 
 
 /*********************************** end of tbxmb_server.c *****************************/
@@ -43,6 +43,43 @@ extern "C" {
 typedef void * tTbxMbServer;
 
 
+/** \brief Handle to a Modbus server FIFO queue object, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbServerFifo;
+
+
+/** \brief Handle to a Modbus server register image object, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbServerImage;
+
+
+/** \brief Enumerated type with the Modbus data tables. */
+typedef enum
+{
+  /* Coils (read-write bits). */
+  TBX_MB_SERVER_TABLE_COILS = 0U,
+  /* Discrete inputs (read-only bits). */
+  TBX_MB_SERVER_TABLE_INPUTS,
+  /* Input registers (read-only registers). */
+  TBX_MB_SERVER_TABLE_INPUT_REGS,
+  /* Holding registers (read-write registers). */
+  TBX_MB_SERVER_TABLE_HOLDING_REGS
+} tTbxMbServerTable;
+
+
+/** \brief Change record that the server adds to its change queue, after a client wrote
+ *         data elements to the register storage. Refer to TbxMbServerChangesEnable().
+ */
+typedef struct
+{
+  tTbxMbServerTable table;                       /**< Data table that changed.         */
+  uint16_t          addr;                        /**< Address of the first element.    */
+  uint16_t          num;                         /**< Number of changed elements.      */
+} tTbxMbServerChange;
+
+
 /** \brief Enumerated type with all supported return values for the callbacks. */
 typedef enum
 {
@@ -53,7 +90,17 @@ typedef enum
    */
   TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR,
   /* Callback function could not perform the operation on the specified data element. */
-  TBX_MB_SERVER_ERR_DEVICE_FAILURE
+  TBX_MB_SERVER_ERR_DEVICE_FAILURE,
+  /* Callback function could not perform the request because a value in the request is
+   * not allowed. Only supported by the block write callbacks.
+   */
+  TBX_MB_SERVER_ERR_ILLEGAL_DATA_VALUE,
+  /* Callback function cannot perform the request right now, because the data element
+   * is backed by a slow source. The server parks the request without responding. Once
+   * the data is available, the application calls TbxMbServerCompleteRequest(). The
+   * server then processes the request again, calling the same callback functions.
+   */
+  TBX_MB_SERVER_PENDING
 } tTbxMbServerResult;
 
 
@@ -162,6 +209,150 @@ typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingReg) (tTbxMbServer    chan
                                                             uint16_t        value);
 
 
+/** \brief   Modbus server callback function for writing a block of coils in one go.
+ *           Used for both validating and committing the write operation of function code
+ *           15 - Write Multiple Coils.
+ *  \details The coil values are packed as in the request PDU: the coil at "addr" is
+ *           stored in bit 0 of coils[0], the next one in bit 1, etc. A set bit means
+ *           that the coil should be activated.
+ *           When used as the validation callback, only check that the write operation 
+ *           is allowed, without actually writing the coils. When used as the commit
+ *           callback, write all coils. The stack only calls the commit callback after
+ *           the entire block was validated, meaning that the coils are either all 
+ *           written or not at all.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Element address of the first coil (0..65535).
+ *  \param   num Number of coils in the block.
+ *  \param   coils Pointer to the byte array with the packed coil values.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if (part
+ *           of) the block is not supported by this server, 
+ *           TBX_MB_SERVER_ERR_ILLEGAL_DATA_VALUE if a coil value is not allowed,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteCoils)      (tTbxMbServer     channel,
+                                                            uint16_t         addr,
+                                                            uint16_t         num,
+                                                            uint8_t  const * coils);
+
+
+/** \brief   Modbus server callback function for writing a block of holding registers in
+ *           one go. Used for both validating and committing the write operation of
+ *           function code 16 - Write Multiple Registers.
+ *  \details The values of the holding registers are already in your CPUs native 
+ *           endianess.
+ *           When used as the validation callback, only check that the write operation 
+ *           is allowed, without actually writing the holding registers. When used as
+ *           the commit callback, write all holding registers. The stack only calls the
+ *           commit callback after the entire block was validated, meaning that the
+ *           holding registers are either all written or not at all.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Element address of the first holding register (0..65535).
+ *  \param   num Number of holding registers in the block.
+ *  \param   values Pointer to the array with the holding register values.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if (part
+ *           of) the block is not supported by this server, 
+ *           TBX_MB_SERVER_ERR_ILLEGAL_DATA_VALUE if a register value is not allowed,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingRegs)(tTbxMbServer     channel,
+                                                            uint16_t         addr,
+                                                            uint16_t         num,
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for reading a device identification
+ *           object. Called while processing function code 43 / MEI type 14 - Read Device
+ *           Identification.
+ *  \details Objects 0x00..0x02 form the mandatory basic category, objects 0x03..0x7F
+ *           the optional regular category and objects 0x80..0xFF the optional extended
+ *           category. Use the TBX_MB_DEVID_OBJ_xxx macros for the standard objects.
+ *           Instead of copying the object's value, write a pointer to it. The
+ *           MicroTBX-Modbus stack copies it into the response right after the callback
+ *           returns. Typically the value is an ASCII string stored in flash. Note that
+ *           it should not be zero terminated.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   objectId Object identifier (0x00..0xFF).
+ *  \param   value Pointer to write the pointer to the object's value to.
+ *  \param   len Pointer to write the length of the object's value in bytes to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           specific object is not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadDeviceId)    (tTbxMbServer     channel,
+                                                            uint8_t          objectId,
+                                                            uint8_t const ** value,
+                                                            uint8_t        * len);
+
+
+/** \brief   Modbus server callback function for reporting the server ID. Called while
+ *           processing function code 17 - Report Server ID.
+ *  \details The contents of the response is device specific. Write the server ID,
+ *           followed by the run indicator status (0x00 = OFF, 0xFF = ON) and optionally
+ *           additional device specific data, to the "data" byte array. Upon calling the
+ *           callback, the "len" parameter contains the maximum number of bytes that fit
+ *           in the "data" byte array. Write the actual number of bytes that you stored
+ *           to "len" as well.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   data Pointer to a byte array for writing the server ID data.
+ *  \param   len Pointer to the length of the server ID data.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReportServerId)  (tTbxMbServer    channel,
+                                                            uint8_t       * data,
+                                                            uint8_t       * len);
+
+
+/** \brief   Modbus server callback function for reading a block of registers from a file
+ *           record. Called while processing function code 20 - Read File Record.
+ *  \details Write the values of the registers in your CPUs native endianess. The
+ *           MicroTBX-Modbus stack will automatically convert them to the big endianess
+ *           that the Modbus protocol requires.
+ *           The file record sub-request is already validated, meaning that the "record"
+ *           and "num" parameters specify a block of registers within the record number
+ *           range 0..9999.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   file File number (1..65535).
+ *  \param   record Record number of the first register to read (0..9999).
+ *  \param   num Number of registers to read.
+ *  \param   data Pointer to the array for writing the register values to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           specific file or record block is not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadFileRecord)  (tTbxMbServer     channel,
+                                                            uint16_t         file,
+                                                            uint16_t         record,
+                                                            uint16_t         num,
+                                                            uint16_t       * data);
+
+
+/** \brief   Modbus server callback function for writing a block of registers to a file
+ *           record. Called while processing function code 21 - Write File Record.
+ *  \details The values of the registers are already in your CPUs native endianess.
+ *           The stack first validates all sub-requests of the received PDU, before
+ *           calling this callback function for each of them.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   file File number (1..65535).
+ *  \param   record Record number of the first register to write (0..9999).
+ *  \param   num Number of registers to write.
+ *  \param   data Pointer to the array with the register values.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           specific file or record block is not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteFileRecord) (tTbxMbServer     channel,
+                                                            uint16_t         file,
+                                                            uint16_t         record,
+                                                            uint16_t         num,
+                                                            uint16_t const * data);
+
+
 /** \brief   Modbus server callback function for implementing custom function code
  *           handling. Thanks to this functionality, the user can support Modbus function
  *           codes that are either currently not supported or user defined extensions.
@@ -184,6 +375,27 @@ typedef uint8_t            (* tTbxMbServerCustomFunction)  (tTbxMbServer    chan
                                                             uint8_t       * len);
 
 
+/** \brief   Modbus server function code handler. The server keeps a table with one
+ *           handler per function code and calls the one that is registered for the
+ *           function code of a received request. The built-in handlers, such as
+ *           TbxMbServerFC03ReadHoldingRegs(), can be registered individually with
+ *           TbxMbServerSetHandler(). The same goes for application specific handlers,
+ *           for example to replace a built-in one with an optimized version.
+ *  \details By default each newly created server registers all built-in handlers,
+ *           so all of them end up in flash. Together they make up a large part of the
+ *           server's code size. To save flash, set TBX_MB_SERVER_BUILTIN_HANDLERS_ENABLE
+ *           to 0 in "tbx_conf.h". A new server then starts out with an empty handler
+ *           table and responds to all function codes with an illegal function
+ *           exception, until the application registers the handlers it needs. Only
+ *           those end up in flash.
+ *           The parameters and return value are the same as for the custom function
+ *           code callback. Note that txPdu[0] already holds the function code upon
+ *           calling the handler. Whenever the handler changes data that the server
+ *           reports, it should call TbxMbServerCacheInvalidate().
+ */
+typedef tTbxMbServerCustomFunction tTbxMbServerHandler;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -209,9 +421,207 @@ void         TbxMbServerSetCallbackReadHoldingReg (tTbxMbServer                c
 void         TbxMbServerSetCallbackWriteHoldingReg(tTbxMbServer                channel,
                                                    tTbxMbServerWriteHoldingReg callback);
 
+void         TbxMbServerSetCallbackWriteCoils     (tTbxMbServer                channel,
+                                                   tTbxMbServerWriteCoils      validate,
+                                                   tTbxMbServerWriteCoils      commit);
+
+void         TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer               channel,
+                                                   tTbxMbServerWriteHoldingRegs validate,
+                                                   tTbxMbServerWriteHoldingRegs commit);
+
+void         TbxMbServerSetCallbackReadDeviceId   (tTbxMbServer                channel,
+                                                   tTbxMbServerReadDeviceId    callback);
+
+void         TbxMbServerSetCallbackReportServerId (tTbxMbServer                channel,
+                                                   tTbxMbServerReportServerId  callback);
+
+void         TbxMbServerSetCallbackReadFileRecord (tTbxMbServer                channel,
+                                                   tTbxMbServerReadFileRecord  callback);
+
+void         TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                channel,
+                                                   tTbxMbServerWriteFileRecord callback);
+
 void         TbxMbServerSetCallbackCustomFunction (tTbxMbServer                channel,
                                                    tTbxMbServerCustomFunction  callback);
 
+void         TbxMbServerSetHandler                (tTbxMbServer                channel,
+                                                   uint8_t                     code,
+                                                   tTbxMbServerHandler         handler);
+
+tTbxMbServerFifo TbxMbServerFifoCreate            (tTbxMbServer                channel,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    size);
+
+uint8_t      TbxMbServerFifoPush                  (tTbxMbServerFifo            fifo,
+                                                   uint16_t                    value);
+
+uint16_t     TbxMbServerFifoCount                 (tTbxMbServerFifo            fifo);
+
+void         TbxMbServerSetImage                  (tTbxMbServer                channel,
+                                                   tTbxMbServerImage           image);
+
+void         TbxMbServerSetCoilBitmap             (tTbxMbServer                channel,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num,
+                                                   uint32_t                  * words);
+
+void         TbxMbServerSetHoldingRegArray        (tTbxMbServer                channel,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num,
+                                                   uint16_t                  * regs);
+
+void         TbxMbServerSetInputBitmap            (tTbxMbServer                channel,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num,
+                                                   uint32_t                  * words);
+
+tTbxMbServerImage TbxMbServerImageCreate          (void);
+
+void         TbxMbServerImageFree                 (tTbxMbServerImage           image);
+
+uint8_t      TbxMbServerImageSetTable             (tTbxMbServerImage           image,
+                                                   tTbxMbServerTable           table,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num);
+
+uint8_t      TbxMbServerImageBeginUpdate          (tTbxMbServerImage           image);
+
+uint8_t      TbxMbServerImageWriteBits            (tTbxMbServerImage           image,
+                                                   tTbxMbServerTable           table,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num,
+                                                   uint8_t             const * values);
+
+uint8_t      TbxMbServerImageWriteRegs            (tTbxMbServerImage           image,
+                                                   tTbxMbServerTable           table,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num,
+                                                   uint16_t            const * values);
+
+void         TbxMbServerImageEndUpdate            (tTbxMbServerImage           image);
+
+uint8_t      TbxMbServerCacheEnable               (tTbxMbServer                channel,
+                                                   uint8_t                     entries);
+
+void         TbxMbServerCacheInvalidate           (tTbxMbServer                channel);
+
+void         TbxMbServerCacheStats                (tTbxMbServer                channel,
+                                                   uint32_t                  * hits,
+                                                   uint32_t                  * misses);
+
+uint8_t      TbxMbServerCompleteRequest           (tTbxMbServer                channel);
+
+uint8_t      TbxMbServerChangesEnable             (tTbxMbServer                channel,
+                                                   uint16_t                    size);
+
+uint8_t      TbxMbServerChangesGet                (tTbxMbServer                channel,
+                                                   tTbxMbServerChange        * change);
+
+uint32_t     TbxMbServerChangesLost               (tTbxMbServer                channel);
+
+uint8_t      TbxMbServerDirtyEnable               (tTbxMbServer                channel,
+                                                   tTbxMbServerTable           table,
+                                                   uint16_t                    addr,
+                                                   uint16_t                    num);
+
+uint16_t     TbxMbServerDirtyFetch                (tTbxMbServer                channel,
+                                                   tTbxMbServerTable           table,
+                                                   uint32_t                  * words);
+
+uint8_t      TbxMbServerDirtyNext                 (uint32_t            const * words,
+                                                   uint16_t                    num,
+                                                   uint16_t                  * offset);
+
+uint8_t      TbxMbServerBindModel                 (tTbxMbServer                channel,
+                                                   tTbxMbServer                model);
+
+uint8_t      TbxMbServerModelLock                 (tTbxMbServer                model);
+
+void         TbxMbServerModelUnlock               (tTbxMbServer                model);
+
+void         TbxMbServerFastPathEnable            (tTbxMbServer                channel,
+                                                   uint8_t                     enable);
+
+uint8_t      TbxMbServerFC01ReadCoils             (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC02ReadInputs            (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC03ReadHoldingRegs       (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC04ReadInputRegs         (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC05WriteSingleCoil       (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC06WriteSingleReg        (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC08Diagnostics           (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC11GetCommEventCounter   (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC12GetCommEventLog       (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC15WriteMultipleCoils    (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC16WriteMultipleRegs     (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC17ReportServerId        (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC20ReadFileRecord        (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC21WriteFileRecord       (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC24ReadFifoQueue         (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
+uint8_t      TbxMbServerFC43ReadDeviceId          (tTbxMbServer                channel,
+                                                   uint8_t             const * rxPdu,
+                                                   uint8_t                   * txPdu,
+                                                   uint8_t                   * len);
+
 
 #ifdef __cplusplus
 }
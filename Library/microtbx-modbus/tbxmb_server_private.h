@@ -47,10 +47,125 @@ typedef void (* tTbxMbServerPoll)   (void        * context);
 typedef void (* tTbxMbServerProcess)(tTbxMbEvent * event);
 
 
-/** \brief Modbus server channel layer context that groups all channel specific data. 
- *         It's what the tTbxMbServer opaque pointer points to.
+/** \brief Modbus server FIFO queue context. It's what the tTbxMbServerFifo opaque
+ *         pointer points to. The FIFO queue is a lock-free ring buffer with a single
+ *         producer (the application) and a single consumer (the server). Only the
+ *         producer writes the head index and only the consumer writes the tail index.
+ *         The buffer has one slot more than the FIFO queue size, such that a full FIFO
+ *         queue can be distinguished from an empty one.
+ */
+typedef struct t_tbx_mb_server_fifo_ctx
+{
+  uint8_t                           type;       /**< Context type.                     */
+  uint16_t                          addr;       /**< FIFO pointer address.             */
+  uint16_t                          slots;      /**< Number of slots in the buffer.    */
+  uint16_t               volatile * buffer;     /**< Ring buffer with the values.      */
+  uint16_t                 volatile head;       /**< Index for the next push.          */
+  uint16_t                 volatile tail;       /**< Index for the next pop.           */
+  struct t_tbx_mb_server_fifo_ctx * next;       /**< Next FIFO queue of the server.    */
+} tTbxMbServerFifoCtx;
+
+
+/** \brief Number of Modbus data tables. Refer to tTbxMbServerTable for details. */
+#define TBX_MB_SERVER_TABLE_NUM        (4U)
+
+
+/** \brief Number of entries in the function code handler table. Function codes of
+ *         requests are in the range 1..127, because the most significant bit flags an
+ *         exception response.
+ */
+#define TBX_MB_SERVER_HANDLERS_NUM     (128U)
+
+
+/** \brief Data table of a register image. The table is double buffered. One copy holds
+ *         the published snapshot, while the application prepares the next snapshot in
+ *         the other copy. Bits are packed in 32-bit words: Element "n" is stored in bit
+ *         (n % 32) of word (n / 32). Registers are stored as 16-bit words.
+ */
+typedef struct
+{
+  uint16_t                          addr;       /**< Address of the first element.     */
+  uint16_t                          num;        /**< Number of elements (0 = unused).  */
+  void                            * copies[2];  /**< The two copies of the table.      */
+} tTbxMbServerImageTbl;
+
+
+/** \brief Modbus server register image context. It's what the tTbxMbServerImage opaque
+ *         pointer points to. Tear-free reading of a snapshot works like a sequence lock:
+ *         The application (single writer) publishes an update by first switching the
+ *         active copy and only then incrementing the sequence counter. A reader samples
+ *         the sequence counter, reads from the active copy and then checks that the
+ *         sequence counter did not change. If it did, the writer may have started
+ *         modifying the copy that was just read, so the reader tries again.
+ */
+typedef struct
+{
+  uint8_t                           type;       /**< Context type.                     */
+  tTbxMbServerImageTbl              tables[TBX_MB_SERVER_TABLE_NUM]; /**< Tables.      */
+  uint32_t                 volatile seq;        /**< Publish sequence counter.         */
+  uint8_t                  volatile active;     /**< Index of the published copy.      */
+  uint8_t                           updating;   /**< TBX_TRUE while updating.          */
+} tTbxMbServerImageCtx;
+
+
+/** \brief Bitmap with the bits of a data table, owned by the application. Element "n",
+ *         counting from the first element, is stored in bit (n % 32) of word (n / 32).
  */
 typedef struct
+{
+  uint16_t                          addr;       /**< Address of the first element.     */
+  uint16_t                          num;        /**< Number of elements.               */
+  uint32_t                        * words;      /**< Packed bits (NULL = unused).      */
+} tTbxMbServerBitmap;
+
+
+/** \brief Array with the registers of a data table, owned by the application. */
+typedef struct
+{
+  uint16_t                          addr;       /**< Address of the first element.     */
+  uint16_t                          num;        /**< Number of elements.               */
+  uint16_t                        * regs;       /**< Register values (NULL = unused).  */
+} tTbxMbServerRegArray;
+
+
+/** \brief Queue with change records. Just like the FIFO queue, it is a lock-free ring
+ *         buffer, but with the server as the single producer and the application as the
+ *         single consumer. The buffer has one slot more than the queue size.
+ */
+typedef struct
+{
+  uint16_t                          slots;      /**< Number of slots in the buffer.    */
+  tTbxMbServerChange     volatile * buffer;     /**< Ring buffer with the records.     */
+  uint16_t                 volatile head;       /**< Index for the next push.          */
+  uint16_t                 volatile tail;       /**< Index for the next pop.           */
+  uint32_t                 volatile lost;       /**< Records lost due to a full queue. */
+} tTbxMbServerChangeQueue;
+
+
+/** \brief Entry of the server response cache. An entry holds the response PDU data of a
+ *         read request, together with the cache generation and register image sequence
+ *         counter that were current at the time the response was built. The entry only
+ *         matches if both are still the same.
+ */
+typedef struct
+{
+  uint8_t                           valid;      /**< TBX_TRUE if the entry is in use.  */
+  uint8_t                           code;       /**< Function code of the request.     */
+  uint16_t                          addr;       /**< Start address of the request.     */
+  uint16_t                          num;        /**< Quantity of the request.          */
+  uint32_t                          generation; /**< Cache generation of the response. */
+  uint32_t                          imageSeq;   /**< Image sequence of the response.   */
+  uint8_t                           dataLen;    /**< Response PDU data length.         */
+  uint8_t                           data[TBX_MB_TP_PDU_DATA_LEN_MAX]; /**< Data bytes. */
+} tTbxMbServerCacheEntry;
+
+
+/** \brief Modbus server channel layer context that groups all channel specific data. 
+ *         It's what the tTbxMbServer opaque pointer points to. The callbacks and data
+ *         storage form the data model of the channel. Channels bound to the data model
+ *         of another channel, use the data model of that channel instead of their own.
+ */
+typedef struct t_tbx_mb_server_ctx
 {
   /* Event interface methods. The following three entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
@@ -62,12 +177,49 @@ typedef struct
   /* Private members. */
   uint8_t                       type;               /**< Context type.                 */
   tTbxMbTpCtx                 * tpCtx;              /**< Assigned transport layer ctx. */
+  struct t_tbx_mb_server_ctx  * modelCtx;           /**< Served data model (can be us).*/
+  struct t_tbx_mb_server_ctx  * boundList;          /**< Channels bound to our model.  */
+  struct t_tbx_mb_server_ctx  * boundNext;          /**< Next channel in boundList.    */
+  tTbxMbTpCtx                 * requestTpCtx;       /**< TP ctx of the current request.*/
+  uint8_t              volatile modelLocked;        /**< Model locked by application.  */
+  uint8_t              volatile modelBusy;          /**< Model in use by the server.   */
   tTbxMbServerReadInput         readInputFcn;       /**< Read discrete input callback. */
   tTbxMbServerReadCoil          readCoilFcn;        /**< Read coil callback.           */
   tTbxMbServerWriteCoil         writeCoilFcn;       /**< Write coil callback.          */
   tTbxMbServerReadInputReg      readInputRegFcn;    /**< Read input register callback. */
   tTbxMbServerReadHoldingReg    readHoldingRegFcn;  /**< Read holding register cb.     */
   tTbxMbServerWriteHoldingReg   writeHoldingRegFcn; /**< Write holding register cb.    */
+  tTbxMbServerWriteCoils        validateCoilsFcn;   /**< Validate coils block cb.      */
+  tTbxMbServerWriteCoils        commitCoilsFcn;     /**< Commit coils block callback.  */
+  tTbxMbServerWriteHoldingRegs  validateHoldingRegsFcn; /**< Validate registers cb.    */
+  tTbxMbServerWriteHoldingRegs  commitHoldingRegsFcn;   /**< Commit registers cb.      */
+  tTbxMbServerReadDeviceId      readDeviceIdFcn;    /**< Read device ID object cb.     */
+  tTbxMbServerReportServerId    reportServerIdFcn;  /**< Report server ID callback.    */
+  uint8_t                       devIdConformity;    /**< Cached device ID conformity.  */
+  uint8_t                       devIdLastObj;       /**< Last supported device ID.     */
+  tTbxMbServerReadFileRecord    readFileRecordFcn;  /**< Read file record callback.    */
+  tTbxMbServerWriteFileRecord   writeFileRecordFcn; /**< Write file record callback.   */
+  tTbxMbServerFifoCtx         * fifoList;           /**< Linked list with FIFO queues. */
+  tTbxMbServerImageCtx        * imageCtx;           /**< Register image (optional).    */
+  tTbxMbServerBitmap            coilBitmap;         /**< Coil bitmap (optional).       */
+  tTbxMbServerBitmap            inputBitmap;        /**< Input bitmap (optional).      */
+  tTbxMbServerRegArray          holdingRegArray;    /**< Holding registers (optional). */
+  tTbxMbServerChangeQueue       changes;            /**< Change queue (optional).      */
+  tTbxMbServerBitmap            coilDirty;          /**< Written coils (optional).     */
+  tTbxMbServerBitmap            holdingRegDirty;    /**< Written registers (optional). */
+  tTbxMbServerCacheEntry      * cacheEntries;       /**< Response cache (optional).    */
+  uint8_t                       cacheSize;          /**< Number of cache entries.      */
+  uint8_t                       cacheNext;          /**< Next cache entry to replace.  */
+  uint32_t             volatile cacheGeneration;    /**< Cache invalidation counter.   */
+  uint32_t                      cacheHits;          /**< Number of cache hits.         */
+  uint32_t                      cacheMisses;        /**< Number of cache misses.       */
+  tTbxMbServerHandler           handlers[TBX_MB_SERVER_HANDLERS_NUM]; /**< Handlers.   */
+  uint8_t              volatile pendingState;       /**< State of the parked request.  */
+  tTbxMbTpPdu                   pendingPdu;         /**< PDU of the parked request.    */
+  uint8_t                       pendingDataLen;     /**< PDU data length of the same.  */
+  uint8_t                       pendingNode;        /**< Node of the parked request.   */
+  uint16_t                      pendingTickTime;    /**< Last millisecond tick time.   */
+  uint16_t                      pendingElapsedMs;   /**< Time since parking in ms.     */
   tTbxMbServerCustomFunction    customFunctionFcn;  /**< Custom function code callback.*/  
 } tTbxMbServerCtx;
 
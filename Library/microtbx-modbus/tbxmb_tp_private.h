@@ -74,6 +74,7 @@ typedef struct
   uint8_t     tail[TBX_MB_TP_ADU_TAIL_LEN_MAX];        /**< ADU error check.           */
   uint8_t     dataLen;                                 /**< Number of PDU data bytes.  */
   uint8_t     node;                                    /**< Node identifier.           */
+  uint16_t    transId;                                 /**< Transaction identifier.    */
 } tTbxMbTpPacket;
 
 
@@ -90,6 +91,16 @@ typedef struct
   uint16_t srvMsgCnt;
   /** \brief Total number responses that could not be transmitted. */
   uint16_t srvNoRespCnt;
+  /** \brief Communication event counter. Number of successfully completed requests,
+   *         not counting exception responses and get comm event counter requests.
+   */
+  uint16_t commEventCnt;
+  /** \brief Ring buffer with the communication event log. */
+  uint8_t  commEvents[TBX_MB_COMM_EVENT_LOG_LEN];
+  /** \brief Index into commEvents[] where the next communication event is stored. */
+  uint8_t  commEventsNext;
+  /** \brief Number of communication events in commEvents[]. */
+  uint8_t  commEventsNum;
 } tTbxMbTpDiagInfo;
 
 
@@ -132,6 +143,46 @@ typedef tTbxMbTpPacket * (* tTbxMbTpGetRxPacket)(tTbxMbTp      transport);
 typedef tTbxMbTpPacket * (* tTbxMbTpGetTxPacket)(tTbxMbTp      transport);
 
 
+/** \brief Channel interface function that the transport layer calls right after it
+ *         validated a newly received packet, instead of first posting the 
+ *         TBX_MB_EVENT_ID_PDU_RECEIVED event. Returns TBX_TRUE if the channel completely
+ *         processed the packet, including the calls of receptionDoneFcn() and 
+ *         transmitFcn(). Otherwise the transport layer posts the event as usual.
+ */
+typedef uint8_t (* tTbxMbTpFastPath)            (void        * channelCtx);
+
+
+/** \brief Transport layer interface function to update a running checksum with the
+ *         specified data bytes. Returns the updated checksum.
+ */
+typedef uint16_t (* tTbxMbTpChecksum)           (uint16_t        checksum,
+                                                 uint8_t const * data,
+                                                 uint16_t        len);
+
+
+/** \brief Output cursor for writing the PDU data of the transmit packet. Besides storing
+ *         the bytes, it updates the checksum of the ADU while writing. If the channel
+ *         ends the cursor right after writing the last byte of the response, the
+ *         transport layer only needs to append the checksum, instead of calculating it
+ *         in a separate pass over the entire ADU.
+ */
+typedef struct
+{
+  uint8_t               * ptr;                   /**< Next byte to write.              */
+  uint16_t                checksum;              /**< Running checksum of the ADU.     */
+  tTbxMbTpChecksum        checksumFcn;           /**< Checksum update (NULL = none).   */
+} tTbxMbTpCursor;
+
+
+/** \brief Transport layer interface function to start writing the PDU data of the
+ *         transmit packet with an output cursor. The function code in pdu[0] and the
+ *         node of the transmit packet must already be set. The checksum covers those.
+ */
+typedef void (* tTbxMbTpCursorBegin)            (tTbxMbTp         transport,
+                                                 tTbxMbTpCursor * cursor,
+                                                 uint8_t        * pdu);
+
+
 /** \brief   Modbus transport layer context that groups all transport layer specific
  *           data. It's what the tTbxMbTransport opaque pointer points to.
  *  \details For both simplicity and run-time efficiency, this type packs information for
@@ -161,6 +212,8 @@ typedef struct
   tTbxMbUartPort          port;                  /**< UART port (RTU/ASCII only)     . */
   tTbxMbTpPacket          txPacket;              /**< Transmit packet buffer.          */
   uint16_t                txDoneTime;            /**< Tx packet done timestamp.        */
+  uint8_t                 txDone;                /**< Tx packet done flag.             */
+  tTbxMbTpCursor          txCursor;              /**< Ended Tx cursor (if any).        */
   tTbxMbTpPacket          rxPacket;              /**< Reception packet buffer.         */
   uint16_t                rxTime;                /**< Last Rx byte timestamp.          */
   uint16_t                rxAduWrIdx;            /**< ADU Rx packet write index.       */
@@ -177,9 +230,180 @@ typedef struct
   tTbxMbTpReceptionDone   receptionDoneFcn;      /**< Rx packet processing done fcn.   */
   tTbxMbTpGetRxPacket     getRxPacketFcn;        /**< Obtain Rx packet access function.*/
   tTbxMbTpGetTxPacket     getTxPacketFcn;        /**< Obtain Rx packet access function.*/
+  tTbxMbTpFastPath        fastPathFcn;           /**< Channel fast path (optional).    */
+  tTbxMbTpCursorBegin     cursorBeginFcn;        /**< Begin Tx cursor fcn (optional).  */
+  uint8_t                 outstandingMax;        /**< Max requests awaiting a response.*/
+  uint8_t                 anyNode;               /**< Server for any node (gateway).   */
 } tTbxMbTpCtx;
 
 
+/****************************************************************************************
+* Inline functions
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Adds an event to the communication event log. Once the log is full, the
+**            oldest event is overwritten.
+** \param     diagInfo Pointer to the diagnostics information with the event log.
+** \param     event The communication event (TBX_MB_COMM_EVENT_xxx).
+**
+****************************************************************************************/
+static inline void TbxMbTpCommEventAdd(tTbxMbTpDiagInfo * diagInfo,
+                                       uint8_t            event)
+{
+  /* Store the event and advance the index with wrap around. */
+  diagInfo->commEvents[diagInfo->commEventsNext] = event;
+  diagInfo->commEventsNext++;
+  if (diagInfo->commEventsNext >= TBX_MB_COMM_EVENT_LOG_LEN)
+  {
+    diagInfo->commEventsNext = 0U;
+  }
+  /* Update the number of events in the log, until it's full. */
+  if (diagInfo->commEventsNum < TBX_MB_COMM_EVENT_LOG_LEN)
+  {
+    diagInfo->commEventsNum++;
+  }
+} /*** end of TbxMbTpCommEventAdd ***/
+
+
+/************************************************************************************//**
+** \brief     Updates the communication event counter and log of a server, after it
+**            completed the processing of a request by sending its response packet.
+** \param     diagInfo Pointer to the diagnostics information with the event log.
+** \param     txPacket Pointer to the response packet.
+**
+****************************************************************************************/
+static inline void TbxMbTpCommEventResponse(tTbxMbTpDiagInfo       * diagInfo,
+                                            tTbxMbTpPacket   const * txPacket)
+{
+  uint8_t event = TBX_MB_COMM_EVENT_SEND;
+
+  /* Exception response? */
+  if ((txPacket->pdu.code & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
+  {
+    /* Flag the exception category in the event, based on the exception code. */
+    if (txPacket->pdu.data[0] <= TBX_MB_EC03_ILLEGAL_DATA_VALUE)
+    {
+      event |= TBX_MB_COMM_EVENT_SEND_READ_EXCEPTION;
+    }
+    else if (txPacket->pdu.data[0] == TBX_MB_EC04_SERVER_DEVICE_FAILURE)
+    {
+      event |= TBX_MB_COMM_EVENT_SEND_ABORT_EXCEPTION;
+    }
+    else if (txPacket->pdu.data[0] <= TBX_MB_EC06_SERVER_DEVICE_BUSY)
+    {
+      event |= TBX_MB_COMM_EVENT_SEND_BUSY_EXCEPTION;
+    }
+    else
+    {
+      event |= TBX_MB_COMM_EVENT_SEND_NAK_EXCEPTION;
+    }
+  }
+  /* Successfully completed request. Count it, unless it's a request to fetch the
+   * communication event counter, as per the protocol.
+   */
+  else if (txPacket->pdu.code != TBX_MB_FC11_GET_COMM_EVENT_COUNTER)
+  {
+    diagInfo->commEventCnt++;
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+  /* Add the event to the log. */
+  TbxMbTpCommEventAdd(diagInfo, event);
+} /*** end of TbxMbTpCommEventResponse ***/
+
+
+/************************************************************************************//**
+** \brief     Starts writing the PDU data of a response with an output cursor. The
+**            cursor writes the data bytes that follow the function code. In case the
+**            transport layer does not support output cursors, the cursor just stores
+**            the bytes.
+** \param     tpCtx Pointer to the transport layer context. Can be NULL.
+** \param     cursor Pointer to the output cursor.
+** \param     pdu Pointer to the PDU to write, starting with its function code.
+**
+****************************************************************************************/
+static inline void TbxMbTpCursorBegin(tTbxMbTpCtx    * tpCtx,
+                                      tTbxMbTpCursor * cursor,
+                                      uint8_t        * pdu)
+{
+  /* Does the transport layer support output cursors? */
+  if ((tpCtx != NULL) && (tpCtx->cursorBeginFcn != NULL))
+  {
+    tpCtx->cursorBeginFcn(tpCtx, cursor, pdu);
+  }
+  /* No checksum to update, only store the bytes. */
+  else
+  {
+    cursor->ptr = &pdu[1];
+    cursor->checksum = 0U;
+    cursor->checksumFcn = NULL;
+  }
+} /*** end of TbxMbTpCursorBegin ***/
+
+
+/************************************************************************************//**
+** \brief     Writes an unsigned 8-bit value with an output cursor.
+** \param     cursor Pointer to the output cursor.
+** \param     value The unsigned 8-bit value to write.
+**
+****************************************************************************************/
+static inline void TbxMbTpCursorPutUInt8(tTbxMbTpCursor * cursor,
+                                         uint8_t          value)
+{
+  cursor->ptr[0] = value;
+  /* Update the running checksum, if any. */
+  if (cursor->checksumFcn != NULL)
+  {
+    cursor->checksum = cursor->checksumFcn(cursor->checksum, cursor->ptr, 1U);
+  }
+  cursor->ptr++;
+} /*** end of TbxMbTpCursorPutUInt8 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes an unsigned 16-bit value with an output cursor, in the big endian
+**            format.
+** \param     cursor Pointer to the output cursor.
+** \param     value The unsigned 16-bit value to write.
+**
+****************************************************************************************/
+static inline void TbxMbTpCursorPutUInt16BE(tTbxMbTpCursor * cursor,
+                                            uint16_t         value)
+{
+  TbxMbCommonStoreUInt16BE(value, cursor->ptr);
+  /* Update the running checksum, if any. */
+  if (cursor->checksumFcn != NULL)
+  {
+    cursor->checksum = cursor->checksumFcn(cursor->checksum, cursor->ptr, 2U);
+  }
+  cursor->ptr += 2U;
+} /*** end of TbxMbTpCursorPutUInt16BE ***/
+
+
+/************************************************************************************//**
+** \brief     Ends writing the PDU data of a response with an output cursor. Call this
+**            right after writing the last byte of the response. The transport layer
+**            then uses the running checksum of the cursor, if the cursor ended exactly
+**            at the end of the transmit packet. Do not call this function if the
+**            response was changed afterwards in any other way, for example to turn it
+**            into an exception response.
+** \param     tpCtx Pointer to the transport layer context. Can be NULL.
+** \param     cursor Pointer to the output cursor.
+**
+****************************************************************************************/
+static inline void TbxMbTpCursorEnd(tTbxMbTpCtx          * tpCtx,
+                                    tTbxMbTpCursor const * cursor)
+{
+  /* Hand the cursor over to the transport layer, if it supports output cursors. */
+  if ((tpCtx != NULL) && (cursor->checksumFcn != NULL))
+  {
+    tpCtx->txCursor = *cursor;
+  }
+} /*** end of TbxMbTpCursorEnd ***/
+
+
 #ifdef __cplusplus
 }
 #endif